@@ -0,0 +1,156 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie
+
+import io.seventeenninetyone.carlie.utilities.NativeLibraryLoader
+import java.nio.ByteBuffer
+import java.util.concurrent.ExecutorService
+import java.util.concurrent.Executors
+import kotlin.concurrent.thread
+
+/**
+ * This class is for sharing a fixed set of event loop threads, as well as the
+ * threads event handlers run on, between any number of TCP servers.
+ *
+ * Each server attached to a group still runs loops of its own (one per loop of
+ * the group), but they don’t get threads of their own; instead, each of them
+ * gets embedded in one of the group’s loops, and runs on that loop’s thread
+ * whenever it has anything to do. The number of threads is thus sized to the
+ * machine, rather than to the number of servers.
+ *
+ * __Note:__ A group *must* outlive the servers attached to it; closing a group
+ * waits for all of them to close. Attaching a server relies on polling the
+ * backend of each of its loops, so it fails (with `UV_ENOTSUP`) on platforms
+ * that don’t have a backend that can be polled (*e.g.*, Windows).
+ *
+ * @author Jay B.
+ * @see [io.seventeenninetyone.carlie.TcpServer]
+ * @see [java.lang.AutoCloseable]
+ */
+class EventLoopGroup : AutoCloseable {
+  companion object {
+    // private val nativeObjectSize: Int
+    //   @JvmName("_getNativeObjectSize")
+    //   get() {
+    //     return this.getNativeObjectSize()
+    //   }
+    private val nativeObjectSize: Int
+
+    init {
+      try {
+        NativeLibraryLoader.extractAndLoad()
+      } catch (error: Throwable) {
+        NativeLibraryLoader.abort()
+      }
+      this.nativeObjectSize = this.getNativeObjectSize()
+    }
+
+    private val operatingSystemProcessorsCount by lazy {
+      val currentRuntime = Runtime.getRuntime()
+      currentRuntime.availableProcessors()
+    }
+
+    @JvmStatic
+    private external fun getNativeObjectSize(): Int
+  }
+
+  internal val handlerThreadPool: ExecutorService
+
+  /**
+   * Check if the group has been closed.
+   */
+  @Volatile
+  var isClosed: Boolean
+    private set
+
+  private val loopThreads: List<Thread>
+
+  /**
+   * Get the number of event loops the group runs.
+   */
+  val loopsCount: Int
+
+  internal val nativeObject: ByteBuffer
+
+  /**
+   * Create a new group that runs as many event loops as there are processors
+   * available.
+   */
+  constructor() : this(EventLoopGroup.operatingSystemProcessorsCount)
+
+  /**
+   * Create a new group that runs the given number of event loops, each on a
+   * thread of its own.
+   *
+   * @param loopsCount The number of event loops; *must* be at least `1`.
+   */
+  constructor(loopsCount: Int) {
+    if (loopsCount < 1) {
+      throw IllegalArgumentException("The number of loops must be at least 1.")
+    }
+    this.isClosed = false
+    this.loopsCount = loopsCount
+    this.nativeObject = ByteBuffer.allocateDirect(EventLoopGroup.nativeObjectSize)
+    val nativeIsInitialized = this.initializeNative(this.nativeObject, this.loopsCount)
+    if (! nativeIsInitialized) {
+      throw RuntimeException()
+    }
+    this.handlerThreadPool = Executors.newFixedThreadPool(EventLoopGroup.operatingSystemProcessorsCount)
+    this.loopThreads = List(loopsCount) { loopIndex ->
+      thread(priority = Thread.MAX_PRIORITY) {
+        this.uvRun(this.nativeObject, loopIndex)
+      }
+    }
+  }
+
+  private external fun initializeNative(nativeObject: ByteBuffer,
+                                        loopsCount: Int): Boolean
+
+  /**
+   * Close the group; *i.e.*, stop its event loops once the servers attached to
+   * them have closed, and shut down its event handler threads.
+   *
+   * __Note:__ The group can’t be closed from one of its own event loop threads,
+   * as it waits for all of them to exit before letting go of the loops.
+   */
+  override fun close() {
+    // NOTE: The loops get freed once their threads have exited; one that is
+    // still running (on the calling thread’s stack) can’t be waited for.
+    if (this.loopThreads.contains(Thread.currentThread())) {
+      throw IllegalStateException("The event loop group can’t be closed from one of its own loop threads.")
+    }
+    synchronized(this) {
+      if (this.isClosed) return
+      this.isClosed = true
+      this.stopUvLoops(this.nativeObject)
+    }
+    for (loopThread in this.loopThreads) {
+      loopThread.join()
+    }
+    this.closeNative(this.nativeObject)
+    this.handlerThreadPool.shutdown()
+  }
+
+  private external fun closeNative(nativeObject: ByteBuffer)
+
+  private external fun stopUvLoops(nativeObject: ByteBuffer)
+
+  private external fun uvRun(nativeObject: ByteBuffer,
+                             loopIndex: Int)
+}
@@ -21,16 +21,31 @@ package io.seventeenninetyone.carlie
 import com.google.common.collect.Sets
 import io.seventeenninetyone.carlie.events.EventEmitter
 import io.seventeenninetyone.carlie.events.event_emitter.EventHandlerFunction
+import io.seventeenninetyone.carlie.tcp_server.ClientConnectedBatchSinkFunction
 import io.seventeenninetyone.carlie.tcp_server.ClientConnectedEventHandlerFunction
 import io.seventeenninetyone.carlie.tcp_server.ClosedEventHandlerFunction
+import io.seventeenninetyone.carlie.tcp_server.ConnectionDistribution
+import io.seventeenninetyone.carlie.tcp_server.DataReceivedEventHandlerFunction
 import io.seventeenninetyone.carlie.tcp_server.ErrorOccurredEventHandlerFunction
 import io.seventeenninetyone.carlie.tcp_server.InvalidPortException
+import io.seventeenninetyone.carlie.tcp_server.IoCompletionBatchSinkFunction
+import io.seventeenninetyone.carlie.tcp_server.IoCompletedCallbackFunction
+import io.seventeenninetyone.carlie.tcp_server.IoCompletionRing
+import io.seventeenninetyone.carlie.tcp_server.IoCompletionSinkFunction
+import io.seventeenninetyone.carlie.tcp_server.IoRingWakeUpFunction
+import io.seventeenninetyone.carlie.tcp_server.IoSubmissionRing
 import io.seventeenninetyone.carlie.tcp_server.ListeningEventHandlerFunction
 import io.seventeenninetyone.carlie.tcp_server.ServerAlreadyListeningException
 import io.seventeenninetyone.carlie.tcp_server.ServerClosedException
+import io.seventeenninetyone.carlie.tcp_server.SocketOption
+import io.seventeenninetyone.carlie.tcp_server.StreamingReadCallbackFunction
+import io.seventeenninetyone.carlie.tcp_server.Transport
 import io.seventeenninetyone.carlie.tcp_server.UvException
+import io.seventeenninetyone.carlie.tcp_server.WritabilityChangedEventHandlerFunction
 import io.seventeenninetyone.carlie.utilities.NativeLibraryLoader
 import io.seventeenninetyone.carlie.utilities.SimpleAtomicLock
+import io.seventeenninetyone.carlie.utilities.UnsafeMemory
+import java.io.IOException
 import java.io.InputStream
 import java.io.OutputStream
 import java.net.Inet4Address
@@ -42,15 +57,24 @@ import java.nio.channels.AsynchronousByteChannel
 import java.nio.channels.Channels
 import java.nio.channels.ClosedChannelException
 import java.nio.channels.CompletionHandler
+import java.nio.channels.FileChannel
 import java.nio.channels.ReadPendingException
 import java.nio.channels.WritePendingException
+import java.nio.file.Path
+import java.nio.file.StandardOpenOption
 import java.util.UUID
 import java.util.concurrent.CompletableFuture
+import java.util.concurrent.ConcurrentHashMap
 import java.util.concurrent.Executors
 import java.util.concurrent.Future
+import java.util.concurrent.atomic.AtomicReference
+import java.util.concurrent.atomic.AtomicReferenceArray
+import java.util.concurrent.locks.LockSupport
+import java.util.concurrent.locks.ReentrantLock
 import java.util.concurrent.locks.ReentrantReadWriteLock
 import kotlin.concurrent.read
 import kotlin.concurrent.thread
+import kotlin.concurrent.withLock
 import kotlin.concurrent.write
 import kotlin.properties.ReadOnlyProperty
 import kotlin.reflect.KProperty
@@ -67,6 +91,10 @@ class TcpServer : AutoCloseable {
     private const val CLIENT_NOT_CLOSEABLE_ERROR_EVENT_NAME = "CLIENT_NOT_CLOSEABLE_ERROR"
     private const val CLOSED_EVENT_NAME = "CLOSED"
 
+    // NOTE: These have to match the native layer’s defaults.
+    private const val DEFAULT_WRITE_HIGH_WATERMARK = 64L * 1024L
+    private const val DEFAULT_WRITE_LOW_WATERMARK = 32L * 1024L
+
     // private val connectionNativeObjectSize: Int
     //   @JvmName("_getConnectionNativeObjectSize")
     //   get() {
@@ -76,6 +104,7 @@ class TcpServer : AutoCloseable {
 
     private const val ERROR_OCCURRED_EVENT_NAME = "ERROR_OCCURRED"
     private const val LISTENING_EVENT_NAME = "LISTENING"
+    private const val MAXIMUM_ACCEPT_BATCH_SIZE = 1024
 
     // private val nativeObjectSize: Int
     //   @JvmName("_getNativeObjectSize")
@@ -84,6 +113,23 @@ class TcpServer : AutoCloseable {
     //   }
     private val nativeObjectSize: Int
 
+    // NOTE: The IDs of a connection’s operations, which are what reads and
+    // writes get reported back with; a connection has at most one pending read
+    // (streaming or not) and one pending transfer at any time. Writes queue up,
+    // and are numbered from `FIRST_WRITE_OPERATION_ID` on (wrapping around back
+    // to it), in the order they’re issued, which is the order the native layer
+    // writes them in.
+    private const val FIRST_WRITE_OPERATION_ID = 2
+    private const val OPERATIONS_COUNT = 2
+    private const val READ_OPERATION_ID = 0
+    private const val TRANSFER_OPERATION_ID = 1
+
+    private const val WRITABILITY_CHANGED_EVENT_NAME = "WRITABILITY_CHANGED"
+
+    // NOTE: Not an operation as such, but what the native layer reports a
+    // connection’s writability changes with, along with its completions.
+    private const val WRITABILITY_CHANGED_OPERATION_ID = -2
+
     init {
       try {
         NativeLibraryLoader.extractAndLoad()
@@ -131,6 +177,59 @@ class TcpServer : AutoCloseable {
     private external fun getNativeObjectSize(): Int
   }
 
+  /**
+   * Check or set how many connections, at most, each of the server’s event
+   * loops hands over to the JVM at once; the connections a loop accepts during
+   * one of its iterations are handed over together (in as few calls as this
+   * allows), and their client connected events are emitted from a single task.
+   * `1` (the default) hands each connection over on its own.
+   *
+   * __Note:__ This can only be set before the server starts.
+   */
+  var acceptBatchSize: Int = 1
+    set(value) {
+      if ((value < 1) ||
+          (value > TcpServer.MAXIMUM_ACCEPT_BATCH_SIZE)) {
+        throw IllegalArgumentException("The accept batch size must be between 1 and ${TcpServer.MAXIMUM_ACCEPT_BATCH_SIZE}.")
+      }
+      synchronized(this) {
+        if (this.isStarted) {
+          throw IllegalStateException("The server has already started.")
+        }
+        field = value
+      }
+    }
+
+  /**
+   * Check or set whether the server hands the reads and writes its event loops
+   * complete over to the JVM in batches, once per loop iteration, rather than
+   * one at a time; this saves most of the cost of calling into the JVM when
+   * there are many small reads and writes.
+   *
+   * __Note:__ This can only be set before the server starts.
+   */
+  var batchesIoCompletions: Boolean = false
+    set(value) {
+      synchronized(this) {
+        if (this.isStarted) {
+          throw IllegalStateException("The server has already started.")
+        }
+        field = value
+      }
+    }
+
+  /**
+   * Get how the server spreads incoming connections across its event loops.
+   */
+  val connectionDistribution: ConnectionDistribution
+
+  /**
+   * Get the event loop group the server runs its event loops on, if any.
+   *
+   * @see [io.seventeenninetyone.carlie.EventLoopGroup]
+   */
+  val eventLoopGroup: EventLoopGroup?
+
   private val connections: MutableSet<TcpServer.ConnectionInternal>
 
   /**
@@ -143,6 +242,24 @@ class TcpServer : AutoCloseable {
       }
     }
 
+  // NOTE: Indexed by loop index; only set (once) when the server starts with
+  // I/O rings.
+  @Volatile
+  private var ioCompletionRings: List<IoCompletionRing>
+
+  // NOTE: Keyed by the addresses of the connections’ native objects, which is
+  // all that a completion ring’s entries have to go by.
+  private val ioRingConnections: ConcurrentHashMap<Long, TcpServer.ConnectionInternal>
+
+  @Volatile
+  private var ioRingDispatcherThreads: List<Thread>
+
+  @Volatile
+  private var ioRingsAreStopping: Boolean
+
+  @Volatile
+  private var ioSubmissionRings: List<IoSubmissionRing>
+
   @Volatile
   private var isClosed: Boolean
 
@@ -162,8 +279,151 @@ class TcpServer : AutoCloseable {
   var isListening: Boolean
     private set
 
+  /**
+   * Check if reading is paused on all of the server’s connections (including
+   * the ones it accepts from now on).
+   *
+   * @see [io.seventeenninetyone.carlie.TcpServer.pauseReading]
+   * @see [io.seventeenninetyone.carlie.TcpServer.resumeReading]
+   */
+  @Volatile
+  var isReadingPaused: Boolean = false
+    private set
+
+  private var isStarted: Boolean
+
+  /**
+   * Get the number of event loops the server runs.
+   */
+  val loopsCount: Int
+
+  /**
+   * Check or set the backlog of the server’s listeners, i.e., how many
+   * connections the kernel may queue for them before they’re accepted. `0`
+   * (the default) stands for the largest backlog the system allows (e.g.,
+   * `net.core.somaxconn` on Linux), which larger backlogs are capped at.
+   *
+   * __Note:__ This can only be set before the server listens.
+   */
+  var listenBacklog: Int = 0
+    set(value) {
+      if (value < 0) {
+        throw IllegalArgumentException("The listen backlog must not be negative.")
+      }
+      synchronized(this) {
+        if (this.isListening) {
+          throw IllegalStateException("The server is already listening.")
+        }
+        field = value
+      }
+    }
+
   private val nativeObject: ByteBuffer
 
+  /**
+   * Get the number of bytes waiting to be written on all of the server’s
+   * connections.
+   *
+   * __Note:__ Returns `0` once the server has closed.
+   *
+   * @see [io.seventeenninetyone.carlie.TcpServer.unwritableConnectionsCount]
+   */
+  val pendingWriteBytesCount: Long
+    get() {
+      return this.getWriteCount(0)
+    }
+
+  /**
+   * Get the statistics of the pools the server draws its per-operation records
+   * (reads, writes, closes, etc.) from.
+   *
+   * __Note:__ Returns `null` once the server has closed.
+   *
+   * @see [io.seventeenninetyone.carlie.TcpServer.RecordPoolStatistics].
+   */
+  val recordPoolStatistics: TcpServer.RecordPoolStatistics?
+    get() {
+      this.closeFlagReadWriteLock.read {
+        if (this.isClosed) {
+          return null
+        }
+        val counts = LongArray(2)
+        this.getRecordPoolCounts(this.nativeObject, counts)
+        return TcpServer.RecordPoolStatisticsInternal(counts[0], counts[1])
+      }
+    }
+
+  /**
+   * Get what the server’s event loops do their sockets’ I/O through; a server
+   * that was asked to use io_uring reports libuv wherever io_uring isn’t
+   * supported.
+   *
+   * @see [io.seventeenninetyone.carlie.tcp_server.Transport]
+   */
+  val transport: Transport
+
+  /**
+   * Get the number of the server’s connections that aren’t writable.
+   *
+   * __Note:__ Returns `0` once the server has closed.
+   *
+   * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
+   */
+  val unwritableConnectionsCount: Long
+    get() {
+      return this.getWriteCount(1)
+    }
+
+  /**
+   * Check or set whether the server’s connections hand their reads and writes
+   * of direct buffers (and their closes) to the event loops through rings of
+   * memory shared with the native layer, rather than calling into it for each
+   * of them; completions come back through rings too, and get handled on a
+   * thread of their own per loop. Either side only calls into the other when
+   * the other one is idle.
+   *
+   * __Note:__ This can only be set before the server starts. It takes
+   * precedence over [io.seventeenninetyone.carlie.TcpServer.batchesIoCompletions].
+   * The rings are accessed through `sun.misc.Unsafe`, so this can’t be turned
+   * on where that isn’t available.
+   */
+  var usesIoRings: Boolean = false
+    set(value) {
+      synchronized(this) {
+        if (this.isStarted) {
+          throw IllegalStateException("The server has already started.")
+        }
+        if (value && (! UnsafeMemory.isAvailable)) {
+          throw UnsupportedOperationException("sun.misc.Unsafe isn’t available.")
+        }
+        field = value
+      }
+    }
+
+  /**
+   * Get the high watermark of the server’s connections’ writes: a connection
+   * stops being writable once more than this many bytes are waiting to be
+   * written on it.
+   *
+   * @see [io.seventeenninetyone.carlie.TcpServer.setWriteWatermarks]
+   * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
+   */
+  @Volatile
+  var writeHighWatermark: Long = TcpServer.DEFAULT_WRITE_HIGH_WATERMARK
+    private set
+
+  /**
+   * Get the low watermark of the server’s connections’ writes: a connection
+   * that isn’t writable becomes writable again once no more than this many
+   * bytes are waiting to be written on it.
+   *
+   * @see [io.seventeenninetyone.carlie.TcpServer.setWriteWatermarks]
+   * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
+   */
+  @Volatile
+  var writeLowWatermark: Long = TcpServer.DEFAULT_WRITE_LOW_WATERMARK
+    private set
+
   /**
    * Get the address of the server.
    *
@@ -198,6 +458,29 @@ class TcpServer : AutoCloseable {
     }
   }
 
+  private val acceptBatchSinkFunction by lazy {
+    object : ClientConnectedBatchSinkFunction {
+      override fun handleClientsConnectedBatch(connections: Array<Any?>, count: Int) {
+        val batchConnections = List(count) { connectionIndex ->
+          val connection = connections[connectionIndex] as TcpServer.ConnectionInternal
+          // NOTE: So that the batch doesn’t keep the connection around.
+          connections[connectionIndex] = null
+          connection
+        }
+        this@TcpServer.threadPool.execute(Runnable {
+          batchConnections.forEach {
+            connection ->
+              this@TcpServer.emitClientConnectedEvent(connection)
+          }
+        })
+      }
+    }
+  }
+
+  private val acceptBatchSinkFunctionClass by lazy {
+    this.acceptBatchSinkFunction::class.java
+  }
+
   private val closeFlagReadWriteLock by lazy {
     ReentrantReadWriteLock(true)
   }
@@ -248,36 +531,181 @@ class TcpServer : AutoCloseable {
     this.handleErrorOccurredEventFunction::class.java
   }
 
+  private val ioCompletionBatchSinkFunction by lazy {
+    object : IoCompletionBatchSinkFunction {
+      override fun handleIoCompletedBatch(sinks: Array<Any?>, values: IntArray, count: Int) {
+        for (completionIndex in 0 until count) {
+          val sink = sinks[completionIndex] as IoCompletionSinkFunction
+          // NOTE: So that the batch doesn’t keep the connection around.
+          sinks[completionIndex] = null
+          val valuesIndex = completionIndex * 3
+          sink.handleIoCompleted(values[valuesIndex], values[valuesIndex + 1], values[valuesIndex + 2])
+        }
+      }
+    }
+  }
+
+  private val ioCompletionBatchSinkFunctionClass by lazy {
+    this.ioCompletionBatchSinkFunction::class.java
+  }
+
+  private val ioRingCompletionHandler by lazy {
+    this::handleIoRingCompletion
+  }
+
+  private val ioRingWakeUpFunction by lazy {
+    object : IoRingWakeUpFunction {
+      override fun handleCompletionsAvailable(loopIndex: Int) {
+        LockSupport.unpark(this@TcpServer.ioRingDispatcherThreads[loopIndex])
+      }
+    }
+  }
+
+  private val ioRingWakeUpFunctionClass by lazy {
+    this.ioRingWakeUpFunction::class.java
+  }
+
   private val operatingSystemProcessorsCount by lazy {
     val currentRuntime = Runtime.getRuntime()
     currentRuntime.availableProcessors()
   }
 
   private val threadPool by lazy {
-    val pool = Executors.newFixedThreadPool(this.operatingSystemProcessorsCount)
+    val pool = this.eventLoopGroup?.handlerThreadPool ?: Executors.newFixedThreadPool(this.operatingSystemProcessorsCount)
     pool!!
   }
 
   /**
    * Create a new server.
    */
-  constructor() {
+  constructor() : this(1)
+
+  /**
+   * Create a new server that runs the given number of event loops, each on a
+   * thread of its own.
+   *
+   * With more than one loop, each loop gets its own listener, all of them
+   * bound to the same address with `SO_REUSEPORT`, so that the kernel spreads
+   * incoming connections across the loops; a connection is then served, for
+   * its whole life, by the loop that accepted it.
+   *
+   * __Note:__ More than one loop is only supported on platforms that have
+   * `SO_REUSEPORT`; elsewhere, listening fails with a
+   * [io.seventeenninetyone.carlie.tcp_server.UvException].
+   *
+   * @param loopsCount The number of event loops; *must* be at least `1`.
+   */
+  constructor(loopsCount: Int) : this(loopsCount, ConnectionDistribution.REUSE_PORT)
+
+  /**
+   * Create a new server that runs the given number of event loops, each on a
+   * thread of its own, and spreads incoming connections across them as given.
+   *
+   * @param loopsCount The number of event loops; *must* be at least `1`.
+   * @param connectionDistribution How incoming connections get spread across
+   * the loops.
+   * @see [io.seventeenninetyone.carlie.tcp_server.ConnectionDistribution]
+   */
+  constructor(loopsCount: Int,
+              connectionDistribution: ConnectionDistribution) : this(loopsCount, connectionDistribution, Transport.LIBUV, null)
+
+  /**
+   * Create a new server that runs the given number of event loops, each on a
+   * thread of its own, spreads incoming connections across them as given, and
+   * does its sockets’ I/O through the given transport.
+   *
+   * @param loopsCount The number of event loops; *must* be at least `1`.
+   * @param connectionDistribution How incoming connections get spread across
+   * the loops.
+   * @param transport What the loops do their sockets’ I/O through.
+   * @see [io.seventeenninetyone.carlie.tcp_server.ConnectionDistribution]
+   * @see [io.seventeenninetyone.carlie.tcp_server.Transport]
+   */
+  constructor(loopsCount: Int,
+              connectionDistribution: ConnectionDistribution,
+              transport: Transport) : this(loopsCount, connectionDistribution, transport, null)
+
+  /**
+   * Create a new server that runs its event loops on the given group, rather
+   * than on threads of its own, and hands its events to the group’s event
+   * handler threads.
+   *
+   * The server runs one event loop per loop of the group.
+   *
+   * @param eventLoopGroup The group to run on.
+   * @see [io.seventeenninetyone.carlie.EventLoopGroup]
+   */
+  constructor(eventLoopGroup: EventLoopGroup) : this(eventLoopGroup, ConnectionDistribution.REUSE_PORT)
+
+  /**
+   * Create a new server that runs its event loops on the given group, and
+   * spreads incoming connections across them as given.
+   *
+   * @param eventLoopGroup The group to run on.
+   * @param connectionDistribution How incoming connections get spread across
+   * the loops.
+   * @see [io.seventeenninetyone.carlie.EventLoopGroup]
+   * @see [io.seventeenninetyone.carlie.tcp_server.ConnectionDistribution]
+   */
+  constructor(eventLoopGroup: EventLoopGroup,
+              connectionDistribution: ConnectionDistribution) : this(eventLoopGroup.loopsCount, connectionDistribution, Transport.LIBUV, eventLoopGroup)
+
+  /**
+   * Create a new server that runs its event loops on the given group, spreads
+   * incoming connections across them as given, and does its sockets’ I/O
+   * through the given transport.
+   *
+   * @param eventLoopGroup The group to run on.
+   * @param connectionDistribution How incoming connections get spread across
+   * the loops.
+   * @param transport What the loops do their sockets’ I/O through.
+   * @see [io.seventeenninetyone.carlie.EventLoopGroup]
+   * @see [io.seventeenninetyone.carlie.tcp_server.ConnectionDistribution]
+   * @see [io.seventeenninetyone.carlie.tcp_server.Transport]
+   */
+  constructor(eventLoopGroup: EventLoopGroup,
+              connectionDistribution: ConnectionDistribution,
+              transport: Transport) : this(eventLoopGroup.loopsCount, connectionDistribution, transport, eventLoopGroup)
+
+  private constructor(loopsCount: Int,
+                      connectionDistribution: ConnectionDistribution,
+                      transport: Transport,
+                      eventLoopGroup: EventLoopGroup?) {
+    if (loopsCount < 1) {
+      throw IllegalArgumentException("The number of loops must be at least 1.")
+    }
+    this.connectionDistribution = connectionDistribution
     this.connections = Sets.newConcurrentHashSet()
+    this.eventLoopGroup = eventLoopGroup
+    this.ioCompletionRings = emptyList()
+    this.ioRingConnections = ConcurrentHashMap()
+    this.ioRingDispatcherThreads = emptyList()
+    this.ioRingsAreStopping = false
+    this.ioSubmissionRings = emptyList()
     this.isClosed = false
     this.isClosing = false
     this.isListening = false
+    this.isStarted = false
+    this.loopsCount = loopsCount
     this.nativeObject = ByteBuffer.allocateDirect(TcpServer.nativeObjectSize)
     val createConnectionNativeObjectStaticMethodFunction = (TcpServer)::createConnectionNativeObject
     val createConnectionNativeObjectStaticMethodFunctionClass = createConnectionNativeObjectStaticMethodFunction::class.java
     val createConnectionMethodFunction = this::createConnection
     val createConnectionMethodFunctionClass = createConnectionMethodFunction::class.java
-    val nativeIsInitialized = this.initializeNative(this.nativeObject, createConnectionNativeObjectStaticMethodFunction, createConnectionNativeObjectStaticMethodFunctionClass, createConnectionMethodFunction, createConnectionMethodFunctionClass, this.handleClientConnectedEventFunction, this.handleClientConnectedEventFunctionClass, this.handleClosedEventFunction, this.handleClosedEventFunctionClass, this.handleErrorOccurredEventFunction, this.handleErrorOccurredEventFunctionClass, TcpServer.integerClass, TcpServer.nullPointerExceptionClass, TcpServer.runtimeExceptionClass, TcpServer.uvExceptionClass)
+    val nativeIsInitialized = this.initializeNative(this.nativeObject, this.loopsCount, (this.connectionDistribution == ConnectionDistribution.ACCEPTOR_HANDOFF), createConnectionNativeObjectStaticMethodFunction, createConnectionNativeObjectStaticMethodFunctionClass, createConnectionMethodFunction, createConnectionMethodFunctionClass, this.handleClientConnectedEventFunction, this.handleClientConnectedEventFunctionClass, this.handleClosedEventFunction, this.handleClosedEventFunctionClass, this.handleErrorOccurredEventFunction, this.handleErrorOccurredEventFunctionClass, TcpServer.integerClass, TcpServer.nullPointerExceptionClass, TcpServer.runtimeExceptionClass, TcpServer.uvExceptionClass)
     if (! nativeIsInitialized) {
       throw RuntimeException()
     }
+    this.transport = when {
+      ((transport == Transport.IO_URING) && this.initializeIoUring(this.nativeObject)) -> Transport.IO_URING
+      else -> Transport.LIBUV
+    }
+    this.setDefaultSocketOption(this.nativeObject, SocketOption.NO_DELAY.id, 1)
   }
 
   private external fun initializeNative(nativeObject: ByteBuffer,
+                                        loopsCount: Int,
+                                        usesAcceptorHandoff: Boolean,
                                         createConnectionNativeObjectStaticMethodFunction: Function0<ByteBuffer>,
                                         createConnectionNativeObjectStaticMethodFunctionClass: Class<out Function0<ByteBuffer>>,
                                         createConnectionMethodFunction: Function1<ByteBuffer, TcpServer.ConnectionInternal>,
@@ -321,6 +749,10 @@ class TcpServer : AutoCloseable {
     }
   }
 
+  @Throws(UvException::class)
+  private external fun attachToEventLoopGroup(nativeObject: ByteBuffer,
+                                              groupNativeObject: ByteBuffer)
+
   @Throws(UvException::class)
   private external fun bindUvTcpHandle(nativeObject: ByteBuffer,
                                        ipAddress: String,
@@ -378,6 +810,14 @@ class TcpServer : AutoCloseable {
   private fun finishClosing() {
     if (this.isClosed) return
     if (! this.isClosing) return
+    // NOTE: The closed event comes from the last loop to close, and the native
+    // object can only be released once none of the loops are running anymore.
+    // This happens outside the lock, since a loop may still need it on its
+    // way out.
+    this.waitForUvLoops(this.nativeObject)
+    // NOTE: The rings’ memory goes along with the native object, so whatever
+    // completions are left in them have to be handled first.
+    this.stopIoRingDispatchers()
     this.closeFlagReadWriteLock.write {
       this.closeNative(this.nativeObject)
       // // NOTE: See the note in `this.start()`.
@@ -389,11 +829,82 @@ class TcpServer : AutoCloseable {
     }
   }
 
+  private external fun getIoRing(nativeObject: ByteBuffer,
+                                 loopIndex: Int,
+                                 isCompletionRing: Boolean): ByteBuffer
+
+  private external fun getRecordPoolCounts(nativeObject: ByteBuffer,
+                                           counts: LongArray)
+
+  private fun getWriteCount(index: Int): Long {
+    this.closeFlagReadWriteLock.read {
+      if (this.isClosed) {
+        return 0L
+      }
+      val counts = LongArray(2)
+      this.getWriteCounts(this.nativeObject, counts)
+      return counts[index]
+    }
+  }
+
+  private external fun getWriteCounts(nativeObject: ByteBuffer,
+                                      counts: LongArray)
+
+  private fun dispatchIoRingCompletions(loopIndex: Int) {
+    val ring = this.ioCompletionRings[loopIndex]
+    while (true) {
+      // NOTE: Read beforehand, so that nothing the loop completed before it
+      // stopped can be left behind.
+      val isStopping = this.ioRingsAreStopping
+      val completionsCount = ring.drain(this.ioRingCompletionHandler)
+      if (ring.hasOverflowed && (! this.isClosedOrClosing)) {
+        this.wakeUpUvLoop(this.nativeObject, loopIndex)
+      }
+      if (completionsCount > 0) continue
+      if (isStopping) return
+      if (ring.prepareToPark()) {
+        LockSupport.park(this)
+        ring.finishParking()
+      }
+    }
+  }
+
+  private fun handleIoRingCompletion(connectionAddress: Long,
+                                     operationId: Int,
+                                     result: Int,
+                                     errorNumber: Int) {
+    val connection = when (operationId) {
+      IoCompletionRing.CLOSED_OPERATION_ID -> this.ioRingConnections.remove(connectionAddress)
+      else -> this.ioRingConnections.get(connectionAddress)
+    }
+    // TODO: Once logging is set-up, log about this.
+    if (connection == null) return
+    connection.handleIoRingCompletion(operationId, result, errorNumber)
+  }
+
   @Throws(UvException::class)
   private external fun getUvTcpBoundAddress(nativeObject: ByteBuffer,
                                             createAddressMethodFunction: Function3<String, Int, Int, TcpServer.AddressInternal>,
                                             createAddressMethodFunctionClass: Class<out Function3<String, Int, Int, TcpServer.AddressInternal>>): TcpServer.AddressInternal
 
+  @Throws(UvException::class)
+  private external fun initializeAcceptBatches(nativeObject: ByteBuffer,
+                                               acceptBatchCapacity: Int,
+                                               acceptBatchSinkFunction: ClientConnectedBatchSinkFunction,
+                                               acceptBatchSinkFunctionClass: Class<out ClientConnectedBatchSinkFunction>)
+
+  @Throws(UvException::class)
+  private external fun initializeIoCompletionBatches(nativeObject: ByteBuffer,
+                                                     ioCompletionBatchSinkFunction: IoCompletionBatchSinkFunction,
+                                                     ioCompletionBatchSinkFunctionClass: Class<out IoCompletionBatchSinkFunction>)
+
+  @Throws(UvException::class)
+  private external fun initializeIoRings(nativeObject: ByteBuffer,
+                                         ioRingWakeUpFunction: IoRingWakeUpFunction,
+                                         ioRingWakeUpFunctionClass: Class<out IoRingWakeUpFunction>)
+
+  private external fun initializeIoUring(nativeObject: ByteBuffer): Boolean
+
   @Throws(UvException::class)
   private external fun initializeUvTcpHandle(nativeObject: ByteBuffer)
 
@@ -1154,7 +1665,7 @@ class TcpServer : AutoCloseable {
       }
       throw exception
     }
-    this.uvTcpListen(nativeObject)
+    this.uvTcpListen(this.nativeObject, this.listenBacklog)
     this.isListening = true
     if (listeningEventHandler == null) return
     this.onceListening(listeningEventHandler)
@@ -1284,12 +1795,117 @@ class TcpServer : AutoCloseable {
     })
   }
 
+  /**
+   * Pause reading on all of the server’s connections, and on the ones it
+   * accepts from now on, so that TCP flow control pushes back on their
+   * clients.
+   *
+   * @see [io.seventeenninetyone.carlie.TcpServer.Connection.pauseReading]
+   * @see [io.seventeenninetyone.carlie.TcpServer.resumeReading]
+   */
+  fun pauseReading() {
+    this.closeFlagReadWriteLock.read {
+      if (this.isClosedOrClosing) return
+      // NOTE: Set beforehand, so that a connection that gets created meanwhile
+      // either sees it, or is already among the ones paused below.
+      this.isReadingPaused = true
+      this.connections.forEach {
+        connection ->
+          connection.pauseReading()
+      }
+    }
+  }
+
   private fun removeConnection(connection: TcpServer.ConnectionInternal) {
     this.closeFlagReadWriteLock.read {
       this.connections.remove(connection)
     }
   }
 
+  /**
+   * Resume reading on all of the server’s connections (including the ones that
+   * had reading paused individually).
+   *
+   * @see [io.seventeenninetyone.carlie.TcpServer.Connection.resumeReading]
+   * @see [io.seventeenninetyone.carlie.TcpServer.pauseReading]
+   */
+  fun resumeReading() {
+    this.closeFlagReadWriteLock.read {
+      if (this.isClosedOrClosing) return
+      this.isReadingPaused = false
+      this.connections.forEach {
+        connection ->
+          connection.resumeReading()
+      }
+    }
+  }
+
+  /**
+   * Set a socket option for all the connections the server accepts from now
+   * on; it’s applied natively, as each connection gets accepted.
+   *
+   * __Note:__ Connections start out with Nagle’s algorithm disabled
+   * ([io.seventeenninetyone.carlie.tcp_server.SocketOption.NO_DELAY]) and
+   * keep-alive enabled, unless told otherwise.
+   *
+   * @param option The option.
+   * @param value The option’s value.
+   * @see [io.seventeenninetyone.carlie.tcp_server.SocketOption]
+   * @see [io.seventeenninetyone.carlie.TcpServer.Connection.setSocketOption]
+   */
+  @Throws(ServerClosedException::class,
+          UvException::class)
+  fun setDefaultSocketOption(option: SocketOption,
+                             value: Int) {
+    if (! option.isValidValue(value)) {
+      throw IllegalArgumentException()
+    }
+    this.closeFlagReadWriteLock.read {
+      if (this.isClosed) {
+        throw ServerClosedException()
+      }
+      this.setDefaultSocketOption(this.nativeObject, option.id, value)
+    }
+  }
+
+  @Throws(UvException::class)
+  private external fun setDefaultSocketOption(nativeObject: ByteBuffer,
+                                              optionId: Int,
+                                              value: Int)
+
+  /**
+   * Set the watermarks of the server’s connections’ writes, which take effect
+   * on all of them, from their next write on.
+   *
+   * @param lowWatermark The low watermark (in bytes).
+   * @param highWatermark The high watermark (in bytes).
+   * @see [io.seventeenninetyone.carlie.TcpServer.writeHighWatermark]
+   * @see [io.seventeenninetyone.carlie.TcpServer.writeLowWatermark]
+   * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
+   */
+  @Throws(ServerClosedException::class)
+  fun setWriteWatermarks(lowWatermark: Long,
+                         highWatermark: Long) {
+    if ((lowWatermark < 0L) ||
+        (lowWatermark > highWatermark)) {
+      throw IllegalArgumentException("The low watermark must not be negative, nor greater than the high watermark.")
+    }
+    this.closeFlagReadWriteLock.read {
+      if (this.isClosed) {
+        throw ServerClosedException()
+      }
+      synchronized(this) {
+        this.setWriteWatermarks(this.nativeObject, lowWatermark, highWatermark)
+        this.writeLowWatermark = lowWatermark
+        this.writeHighWatermark = highWatermark
+      }
+    }
+  }
+
+  private external fun setWriteWatermarks(nativeObject: ByteBuffer,
+                                          lowWatermark: Long,
+                                          highWatermark: Long)
+
   /**
    * Start the server.
    *
@@ -1301,19 +1917,63 @@ class TcpServer : AutoCloseable {
   fun start() {
     synchronized(this) {
       if (! this.isListening) return
-    }
-    thread(priority = Thread.MAX_PRIORITY) {
-      this.use {
-        this.uvRun()
-        // NOTE: This being done here rather than in `this.finishClosing()`
-        // because this is when it’s guaranteed that the native object is no
-        // longer being manipulated in the native layer.
-        this.nativeObject.clear()
+      if (this.isStarted) return
+      if (this.acceptBatchSize > 1) {
+        this.initializeAcceptBatches(this.nativeObject, this.acceptBatchSize, this.acceptBatchSinkFunction, this.acceptBatchSinkFunctionClass)
+      }
+      if (this.batchesIoCompletions) {
+        this.initializeIoCompletionBatches(this.nativeObject, this.ioCompletionBatchSinkFunction, this.ioCompletionBatchSinkFunctionClass)
       }
+      if (this.usesIoRings) {
+        this.startIoRingDispatchers()
+      }
+      val eventLoopGroup = this.eventLoopGroup
+      if (eventLoopGroup != null) {
+        // NOTE: The group’s lock keeps it from closing while the server’s loops
+        // are being attached to it.
+        synchronized(eventLoopGroup) {
+          if (eventLoopGroup.isClosed) {
+            throw IllegalStateException("The event loop group is closed.")
+          }
+          this.attachToEventLoopGroup(this.nativeObject, eventLoopGroup.nativeObject)
+        }
+      } else {
+        for (loopIndex in 0 until this.loopsCount) {
+          thread(priority = Thread.MAX_PRIORITY) {
+            this.use {
+              this.uvRun(loopIndex)
+              // NOTE: This being done here rather than in
+              // `this.finishClosing()` because this is when it’s guaranteed
+              // that the native object is no longer being manipulated in the
+              // native layer.
+              this.nativeObject.clear()
+            }
+          }
+        }
+      }
+      this.isStarted = true
     }
     this.emitListeningEvent()
   }
 
+  // NOTE: Has to happen before the loops start running, since they may wake up
+  // the dispatcher threads as soon as they do.
+  @Throws(UvException::class)
+  private fun startIoRingDispatchers() {
+    this.initializeIoRings(this.nativeObject, this.ioRingWakeUpFunction, this.ioRingWakeUpFunctionClass)
+    this.ioSubmissionRings = List(this.loopsCount) { loopIndex ->
+      IoSubmissionRing(this.getIoRing(this.nativeObject, loopIndex, false))
+    }
+    this.ioCompletionRings = List(this.loopsCount) { loopIndex ->
+      IoCompletionRing(this.getIoRing(this.nativeObject, loopIndex, true))
+    }
+    this.ioRingDispatcherThreads = List(this.loopsCount) { loopIndex ->
+      thread(priority = Thread.MAX_PRIORITY) {
+        this.dispatchIoRingCompletions(loopIndex)
+      }
+    }
+  }
+
   /**
    * Stop the server; *i.e.*, close all active connections and stop listening
    * for connections.
@@ -1329,6 +1989,16 @@ class TcpServer : AutoCloseable {
     this.close()
   }
 
+  private fun stopIoRingDispatchers() {
+    this.ioRingsAreStopping = true
+    for (dispatcherThread in this.ioRingDispatcherThreads) {
+      LockSupport.unpark(dispatcherThread)
+    }
+    for (dispatcherThread in this.ioRingDispatcherThreads) {
+      dispatcherThread.join()
+    }
+  }
+
   /**
    * Produce a string representation of the server and its state.
    */
@@ -1361,16 +2031,22 @@ class TcpServer : AutoCloseable {
   }
 
   @Throws(UvException::class)
-  @Synchronized
-  private fun uvRun() {
-    return this.uvRun(this.nativeObject)
+  private fun uvRun(loopIndex: Int) {
+    return this.uvRun(this.nativeObject, loopIndex)
   }
 
   @Throws(UvException::class)
-  private external fun uvRun(nativeObject: ByteBuffer)
+  private external fun uvRun(nativeObject: ByteBuffer,
+                             loopIndex: Int)
 
   @Throws(UvException::class)
-  private external fun uvTcpListen(nativeObject: ByteBuffer)
+  private external fun uvTcpListen(nativeObject: ByteBuffer,
+                                   listenBacklog: Int)
+
+  private external fun waitForUvLoops(nativeObject: ByteBuffer)
+
+  private external fun wakeUpUvLoop(nativeObject: ByteBuffer,
+                                    loopIndex: Int)
 
   @Throws(InvalidPortException::class)
   private fun validatePort(port: Int) {
@@ -1430,27 +2106,85 @@ class TcpServer : AutoCloseable {
                                      override val port: Int) : TcpServer.Address
 
   /**
-   * An interface for a server’s connections.
+   * An interface for the statistics of the pools a server draws its
+   * per-operation records from.
    *
    * @author Jay B.
-   * @see [io.seventeenninetyone.carlie.TcpServer.onClientConnected]
-   * @see [io.seventeenninetyone.carlie.tcp_server.ClientConnectedEventHandlerFunction]
-   * @see [java.nio.channels.AsynchronousByteChannel]
-   * @see [java.lang.AutoCloseable]
+   * @see [io.seventeenninetyone.carlie.TcpServer.recordPoolStatistics]
    */
-  interface Connection : AsynchronousByteChannel,
-                         AutoCloseable {
+  interface RecordPoolStatistics {
     /**
-     * Get the unique identifier of the connection.
+     * Get the number of records that were reused from a pool.
      */
-    val id: UUID
+    val hitsCount: Long
     /**
-     * Check if the TCP keep-alive functionality is enabled for the connection.
-     *
+     * Get the number of records that had to be allocated.
+     */
+    val missesCount: Long
+    /**
+     * Get the ratio of reused records to all the records drawn (or `0.0` when
+     * none have been drawn yet).
+     */
+    val hitRate: Double
+
+    /**
+     * @suppress
+     */
+    override fun toString(): String
+  }
+
+  private data class RecordPoolStatisticsInternal(override val hitsCount: Long,
+                                                  override val missesCount: Long) : TcpServer.RecordPoolStatistics {
+    override val hitRate: Double
+      get() {
+        val drawsCount = this.hitsCount + this.missesCount
+        if (drawsCount == 0L) {
+          return 0.0
+        }
+        return this.hitsCount.toDouble() / drawsCount.toDouble()
+      }
+  }
+
+  /**
+   * An interface for a server’s connections.
+   *
+   * @author Jay B.
+   * @see [io.seventeenninetyone.carlie.TcpServer.onClientConnected]
+   * @see [io.seventeenninetyone.carlie.tcp_server.ClientConnectedEventHandlerFunction]
+   * @see [java.nio.channels.AsynchronousByteChannel]
+   * @see [java.lang.AutoCloseable]
+   */
+  interface Connection : AsynchronousByteChannel,
+                         AutoCloseable {
+    /**
+     * Get the unique identifier of the connection.
+     */
+    val id: UUID
+    /**
+     * Check if the TCP keep-alive functionality is enabled for the connection.
+     *
      * @see [io.seventeenninetyone.carlie.TcpServer.Connection.enableKeepAlive]
      * @see [io.seventeenninetyone.carlie.TcpServer.Connection.disableKeepAlive]
      */
     val isKeepAliveEnabled: Boolean
+    /**
+     * Check if reading is paused on the connection.
+     *
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.pauseReading]
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.resumeReading]
+     */
+    val isReadingPaused: Boolean
+    /**
+     * Check if the connection is writable, i.e., if no more than the server’s
+     * high watermark’s worth of bytes are waiting to be written on it (or, once
+     * that has been exceeded, if it has since gone down to the low watermark).
+     * Writes queue up regardless, so producers are expected to throttle
+     * themselves on it.
+     *
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.onWritabilityChanged]
+     * @see [io.seventeenninetyone.carlie.TcpServer.setWriteWatermarks]
+     */
+    val isWritable: Boolean
     /**
    * Get the local address of the connection.
    *
@@ -1526,6 +2260,16 @@ class TcpServer : AutoCloseable {
     @JvmSynthetic
     fun enableKeepAlive(initialDelay: UInt)
 
+    /**
+     * Get the value of a socket option of the connection.
+     *
+     * @param option The option.
+     * @see [io.seventeenninetyone.carlie.tcp_server.SocketOption]
+     */
+    @Throws(ClosedChannelException::class,
+            UvException::class)
+    fun getSocketOption(option: SocketOption): Int
+
     /**
    * Attach an event handler for when the connection has closed.
    *
@@ -1554,6 +2298,40 @@ class TcpServer : AutoCloseable {
     @JvmSynthetic
     fun onErrorOccurred(handler: (@ParameterName("error") Throwable) -> Unit)
 
+    /**
+     * Attach an event handler for when the connection stops or starts being
+     * writable.
+     *
+     * __Note:__ The handler is called on the thread that completes the
+     * connection’s writes (same as their completion handlers), in the order
+     * the changes happened in, so it shouldn’t block.
+     *
+     * @param handler The event handler.
+     * @see [io.seventeenninetyone.carlie.tcp_server.WritabilityChangedEventHandlerFunction]
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
+     */
+    fun onWritabilityChanged(handler: WritabilityChangedEventHandlerFunction)
+
+    /**
+     * @suppress
+     */
+    @JvmSynthetic
+    fun onWritabilityChanged(handler: (@ParameterName("isWritable") Boolean) -> Unit)
+
+    /**
+     * Pause reading from the connection’s underlying stream: the connection
+     * stops draining its socket, so that TCP flow control pushes back on the
+     * client. Reads (streaming or not) stay pending, and get going again once
+     * reading resumes.
+     *
+     * __Note:__ A read that goes through io_uring without streaming is left to
+     * complete.
+     *
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.resumeReading]
+     * @see [io.seventeenninetyone.carlie.TcpServer.pauseReading]
+     */
+    fun pauseReading()
+
     /**
      * Read (asynchronously) from the connection’s underlying stream.
      *
@@ -1574,15 +2352,219 @@ class TcpServer : AutoCloseable {
                           attachment: A,
                           handler: CompletionHandler<Int, in A>)
 
+    /**
+     * Read (asynchronously) from the connection’s underlying stream into a
+     * sequence of buffers, as a single scattering read.
+     *
+     * @see [java.nio.channels.AsynchronousSocketChannel.read]
+     * @see [java.nio.channels.ScatteringByteChannel.read]
+     */
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class)
+    fun read(destinationBuffers: Array<ByteBuffer>,
+             offset: Int,
+             length: Int): Future<Long>
+
+    /**
+     * Read (asynchronously) from the connection’s underlying stream into a
+     * sequence of buffers, as a single scattering read.
+     *
+     * @see [java.nio.channels.AsynchronousSocketChannel.read]
+     * @see [java.nio.channels.ScatteringByteChannel.read]
+     */
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class)
+    fun <A> read(destinationBuffers: Array<ByteBuffer>,
+                 offset: Int,
+                 length: Int,
+                 attachment: A,
+                 handler: CompletionHandler<Long, in A>)
+
+    /**
+     * Relay (asynchronously) everything received from the connection’s
+     * underlying stream to the given connection’s underlying stream, within
+     * the native event loop (using `splice(2)`, where available), until the
+     * end-of-stream is reached, or either connection is closed.
+     *
+     * __Note:__ Relays only one way; two relays (one per connection) make a
+     * proxy. The end-of-stream is passed on by shutting down the sending side
+     * of the given connection. No other reads may be issued on this
+     * connection, and no other writes on the given one, until then (nor can
+     * it be started while writes are pending on the given one).
+     *
+     * @param destination The connection to relay to.
+     */
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class,
+            WritePendingException::class)
+    fun relayTo(destination: TcpServer.Connection): Future<Unit>
+
+    /**
+     * Relay (asynchronously) everything received from the connection’s
+     * underlying stream to the given connection’s underlying stream, within
+     * the native event loop (using `splice(2)`, where available), until the
+     * end-of-stream is reached, or either connection is closed.
+     *
+     * __Note:__ Relays only one way; two relays (one per connection) make a
+     * proxy. The end-of-stream is passed on by shutting down the sending side
+     * of the given connection. No other reads may be issued on this
+     * connection, and no other writes on the given one, until then (nor can
+     * it be started while writes are pending on the given one).
+     *
+     * @param destination The connection to relay to.
+     */
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class,
+            WritePendingException::class)
+    fun <A> relayTo(destination: TcpServer.Connection,
+                    attachment: A,
+                    handler: CompletionHandler<Unit, in A>)
+
+    /**
+     * Resume reading from the connection’s underlying stream, after it got
+     * paused.
+     *
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.pauseReading]
+     * @see [io.seventeenninetyone.carlie.TcpServer.resumeReading]
+     */
+    fun resumeReading()
+
+    /**
+     * Set a socket option of the connection.
+     *
+     * @param option The option.
+     * @param value The option’s value.
+     * @see [io.seventeenninetyone.carlie.tcp_server.SocketOption]
+     * @see [io.seventeenninetyone.carlie.TcpServer.setDefaultSocketOption]
+     */
+    @Throws(ClosedChannelException::class,
+            UvException::class)
+    fun setSocketOption(option: SocketOption,
+                        value: Int)
+
+    /**
+     * Start streaming reads from the connection’s underlying stream, handing
+     * each chunk of data to the given handler as soon as it has been received,
+     * until reading is stopped, the end-of-stream is reached, or the connection
+     * is closed.
+     *
+     * __Note:__ No other reads may be issued while streaming reads.
+     *
+     * @param handler The event handler.
+     * @see [io.seventeenninetyone.carlie.tcp_server.DataReceivedEventHandlerFunction]
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.stopReading]
+     */
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class)
+    fun startReading(handler: DataReceivedEventHandlerFunction)
+
+    /**
+     * @suppress
+     */
+    @JvmSynthetic
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class)
+    fun startReading(handler: (@ParameterName("data") ByteBuffer) -> Unit)
+
+    /**
+     * Stop streaming reads from the connection’s underlying stream.
+     *
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.startReading]
+     */
+    fun stopReading()
+
     /**
    * Produce a string representation of the connection and its state.
    */
     override fun toString(): String
 
+    /**
+     * Send (asynchronously) a region of a file to the connection’s underlying
+     * stream, without copying it through the JVM (using `sendfile(2)`, where
+     * available).
+     *
+     * __Note:__ Stops early once the end of the file is reached, and transfers
+     * at most `Int.MAX_VALUE` bytes at a time; the number of bytes actually
+     * transferred is what the operation completes with. It can’t be started
+     * while writes are pending, and no other writes may be issued until then.
+     *
+     * @param fileChannel The channel of the file to send from; it may be closed
+     * as soon as this returns.
+     * @param position The position, within the file, to start sending from.
+     * @param count The (maximum) number of bytes to send.
+     * @see [java.nio.channels.FileChannel.transferTo]
+     */
+    @Throws(ClosedChannelException::class,
+            WritePendingException::class)
+    fun transferFrom(fileChannel: FileChannel,
+                     position: Long,
+                     count: Long): Future<Long>
+
+    /**
+     * Send (asynchronously) a region of a file to the connection’s underlying
+     * stream, without copying it through the JVM (using `sendfile(2)`, where
+     * available).
+     *
+     * __Note:__ Stops early once the end of the file is reached, and transfers
+     * at most `Int.MAX_VALUE` bytes at a time; the number of bytes actually
+     * transferred is what the operation completes with. It can’t be started
+     * while writes are pending, and no other writes may be issued until then.
+     *
+     * @param fileChannel The channel of the file to send from; it may be closed
+     * as soon as this returns.
+     * @param position The position, within the file, to start sending from.
+     * @param count The (maximum) number of bytes to send.
+     * @see [java.nio.channels.FileChannel.transferTo]
+     */
+    @Throws(ClosedChannelException::class,
+            WritePendingException::class)
+    fun <A> transferFrom(fileChannel: FileChannel,
+                         position: Long,
+                         count: Long,
+                         attachment: A,
+                         handler: CompletionHandler<Long, in A>)
+
+    /**
+     * Send (asynchronously) a region of the file at the given path to the
+     * connection’s underlying stream, without copying it through the JVM.
+     *
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.transferFrom]
+     */
+    @Throws(ClosedChannelException::class,
+            IOException::class,
+            WritePendingException::class)
+    fun transferFrom(path: Path,
+                     position: Long,
+                     count: Long): Future<Long>
+
+    /**
+     * Send (asynchronously) a region of the file at the given path to the
+     * connection’s underlying stream, without copying it through the JVM.
+     *
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.transferFrom]
+     */
+    @Throws(ClosedChannelException::class,
+            IOException::class,
+            WritePendingException::class)
+    fun <A> transferFrom(path: Path,
+                         position: Long,
+                         count: Long,
+                         attachment: A,
+                         handler: CompletionHandler<Long, in A>)
+
     /**
      * Write (asynchronously) to the connection’s underlying stream.
      *
+     * __Note:__ Writes may be issued while others are still pending; they
+     * queue up, and are written in the order they’re issued. Only a transfer
+     * (or a relay into the connection) that is running causes a
+     * `WritePendingException`. A write cancelled by the connection getting
+     * closed completes with the number of bytes known to have been written,
+     * which is `0` unless it went through io_uring, even if part of it did
+     * get sent.
+     *
      * @see [java.nio.channels.AsynchronousByteChannel.write]
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
      */
     @Throws(ClosedChannelException::class,
             WritePendingException::class)
@@ -1591,13 +2573,68 @@ class TcpServer : AutoCloseable {
     /**
      * Write (asynchronously) to the connection’s underlying stream.
      *
+     * __Note:__ Writes may be issued while others are still pending; they
+     * queue up, and are written in the order they’re issued. Only a transfer
+     * (or a relay into the connection) that is running causes a
+     * `WritePendingException`. A write cancelled by the connection getting
+     * closed completes with the number of bytes known to have been written,
+     * which is `0` unless it went through io_uring, even if part of it did
+     * get sent.
+     *
      * @see [java.nio.channels.AsynchronousByteChannel.write]
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
      */
     @Throws(ClosedChannelException::class,
             WritePendingException::class)
     override fun <A> write(sourceBuffer: ByteBuffer,
                            attachment: A,
                            handler: CompletionHandler<Int, in A>)
+
+    /**
+     * Write (asynchronously) a sequence of buffers to the connection’s
+     * underlying stream, as a single gathering write.
+     *
+     * __Note:__ Writes may be issued while others are still pending; they
+     * queue up, and are written in the order they’re issued. Only a transfer
+     * (or a relay into the connection) that is running causes a
+     * `WritePendingException`. A write cancelled by the connection getting
+     * closed completes with the number of bytes known to have been written,
+     * which is `0` unless it went through io_uring, even if part of it did
+     * get sent.
+     *
+     * @see [java.nio.channels.AsynchronousSocketChannel.write]
+     * @see [java.nio.channels.GatheringByteChannel.write]
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
+     */
+    @Throws(ClosedChannelException::class,
+            WritePendingException::class)
+    fun write(sourceBuffers: Array<ByteBuffer>,
+              offset: Int,
+              length: Int): Future<Long>
+
+    /**
+     * Write (asynchronously) a sequence of buffers to the connection’s
+     * underlying stream, as a single gathering write.
+     *
+     * __Note:__ Writes may be issued while others are still pending; they
+     * queue up, and are written in the order they’re issued. Only a transfer
+     * (or a relay into the connection) that is running causes a
+     * `WritePendingException`. A write cancelled by the connection getting
+     * closed completes with the number of bytes known to have been written,
+     * which is `0` unless it went through io_uring, even if part of it did
+     * get sent.
+     *
+     * @see [java.nio.channels.AsynchronousSocketChannel.write]
+     * @see [java.nio.channels.GatheringByteChannel.write]
+     * @see [io.seventeenninetyone.carlie.TcpServer.Connection.isWritable]
+     */
+    @Throws(ClosedChannelException::class,
+            WritePendingException::class)
+    fun <A> write(sourceBuffers: Array<ByteBuffer>,
+                  offset: Int,
+                  length: Int,
+                  attachment: A,
+                  handler: CompletionHandler<Long, in A>)
   }
 
   private inner class ConnectionInternal : TcpServer.Connection {
@@ -1619,12 +2656,29 @@ class TcpServer : AutoCloseable {
     @Volatile
     private var isClosing: Boolean
 
+    // NOTE: Only meaningful when the connection has a submission ring.
+    private var ioRingLoopIndex: Int
+
+    private var ioSubmissionRing: IoSubmissionRing?
+
     @Volatile
     override var isKeepAliveEnabled: Boolean
       private set
 
+    @Volatile
+    override var isReadingPaused: Boolean
+      private set
+
+    @Volatile
+    override var isWritable: Boolean
+      private set
+
     private val nativeObject: ByteBuffer
 
+    private val nativeObjectAddress by lazy {
+      UnsafeMemory.getDirectBufferAddress(this.nativeObject)
+    }
+
     override val server: TcpServer
       get() {
         return this@TcpServer
@@ -1662,6 +2716,44 @@ class TcpServer : AutoCloseable {
       this.handleErrorOccurredEventFunction::class.java
     }
 
+    private val ioCompletionSinkFunction by lazy {
+      object : IoCompletionSinkFunction {
+        override fun handleDataRead(operationId: Int, data: ByteBuffer) {
+          val callback = this@ConnectionInternal.pendingOperationCallbacks.get(operationId)
+          (callback as StreamingReadCallbackFunction).handleData(data)
+        }
+
+        override fun handleIoCompleted(operationId: Int, result: Int, errorNumber: Int) {
+          if (operationId == TcpServer.WRITABILITY_CHANGED_OPERATION_ID) {
+            // NOTE: Emitted right here, rather than from the thread pool, so
+            // that the events arrive in the order the changes happened in, and
+            // in order with the completions of the writes that caused them.
+            val isWritable = (result != 0)
+            this@ConnectionInternal.isWritable = isWritable
+            this@ConnectionInternal.emitWritabilityChangedEvent(isWritable)
+            return
+          }
+          if (operationId >= TcpServer.FIRST_WRITE_OPERATION_ID) {
+            val callback = this@ConnectionInternal.pendingWriteCallbacks.remove(operationId)
+            callback!!
+            this@ConnectionInternal.pendingWriteBuffers.remove(operationId)
+            callback(result, errorNumber)
+            return
+          }
+          val callback = this@ConnectionInternal.pendingOperationCallbacks.get(operationId)
+          callback!!
+          // NOTE: Cleared beforehand, since the callback releases the read or
+          // write lock, after which another operation may be started.
+          this@ConnectionInternal.clearPendingOperation(operationId)
+          callback(result, errorNumber)
+        }
+      }
+    }
+
+    private val ioCompletionSinkFunctionClass by lazy {
+      this.ioCompletionSinkFunction::class.java
+    }
+
     override val id by lazy {
       val uuid = UUID.randomUUID()
       uuid!!
@@ -1698,14 +2790,34 @@ class TcpServer : AutoCloseable {
       }
     }
 
+    // NOTE: The operation ID the next write gets; only ever used while the
+    // write submission lock is held.
+    private var nextWriteOperationId: Int
+
     private val outputStream by lazy {
       Channels.newOutputStream(this)
     }
 
+    // NOTE: Indexed by operation ID. The buffers of pending operations are kept
+    // reachable from here until the operations complete, so that the native
+    // layer doesn’t have to create a global reference to them.
+    private val pendingOperationBuffers: AtomicReferenceArray<Any?>
+
+    private val pendingOperationCallbacks: AtomicReferenceArray<IoCompletedCallbackFunction?>
+
+    // NOTE: Same as the above, for the writes, keyed by their operation IDs.
+    private val pendingWriteBuffers: ConcurrentHashMap<Int, Any>
+
+    private val pendingWriteCallbacks: ConcurrentHashMap<Int, IoCompletedCallbackFunction>
+
     private val readLock by lazy {
       SimpleAtomicLock()
     }
 
+    // NOTE: Only ever used while the read lock is held, and only reused once
+    // the read that used it previously has completed.
+    private var readScratchBuffer: ByteBuffer?
+
     override val remoteAddress: TcpServer.Address? by object : ReadOnlyProperty<TcpServer.ConnectionInternal, TcpServer.Address?> {
       var address: TcpServer.Address?
 
@@ -1733,15 +2845,40 @@ class TcpServer : AutoCloseable {
       }
     }
 
+    // NOTE: Held by a transfer, or by a relay into the connection, for as long
+    // as it runs; neither goes through the native layer’s write queue, so
+    // writes can’t be issued meanwhile, and it can’t be acquired while writes
+    // are pending.
     private val writeLock by lazy {
       SimpleAtomicLock()
     }
 
+    // NOTE: Writes get their operation IDs, and get handed to the native layer,
+    // while holding this lock, so that they reach it in the order of their IDs.
+    private val writeSubmissionLock by lazy {
+      ReentrantLock()
+    }
+
+    // NOTE: Taken by a gathering write, which puts it back once it has
+    // completed; the writes issued in the meantime use buffers of their own.
+    private val writeScratchBuffer: AtomicReference<ByteBuffer?>
+
     constructor(nativeObject: ByteBuffer) {
+      this.ioRingLoopIndex = -1
+      this.ioSubmissionRing = null
       this.isClosed = false
       this.isClosing = false
       this.isKeepAliveEnabled = false
+      this.isReadingPaused = false
+      this.isWritable = true
       this.nativeObject = nativeObject
+      this.nextWriteOperationId = TcpServer.FIRST_WRITE_OPERATION_ID
+      this.pendingOperationBuffers = AtomicReferenceArray(TcpServer.OPERATIONS_COUNT)
+      this.pendingOperationCallbacks = AtomicReferenceArray(TcpServer.OPERATIONS_COUNT)
+      this.pendingWriteBuffers = ConcurrentHashMap()
+      this.pendingWriteCallbacks = ConcurrentHashMap()
+      this.readScratchBuffer = null
+      this.writeScratchBuffer = AtomicReference(null)
       this@TcpServer.closeFlagReadWriteLock.read {
         // TODO: Once logging is set-up, log about this.
         if (this@TcpServer.isClosedOrClosing) return
@@ -1749,7 +2886,7 @@ class TcpServer : AutoCloseable {
         this.handleNotCloseableErrors()
         val closeMethodFunction = this::close
         val closeMethodFunctionClass = closeMethodFunction::class.java
-        val nativeIsInitialized = this.initializeNative(this.nativeObject, this@TcpServer.nativeObject, closeMethodFunction, closeMethodFunctionClass, this.handleClosedEventFunction, this.handleClosedEventFunctionClass, this.handleErrorOccurredEventFunction, this.handleErrorOccurredEventFunctionClass)
+        val nativeIsInitialized = this.initializeNative(this.nativeObject, this@TcpServer.nativeObject, closeMethodFunction, closeMethodFunctionClass, this.handleClosedEventFunction, this.handleClosedEventFunctionClass, this.handleErrorOccurredEventFunction, this.handleErrorOccurredEventFunctionClass, this.ioCompletionSinkFunction, this.ioCompletionSinkFunctionClass)
         // TODO: Once logging is set-up, log about this.
         if (! nativeIsInitialized) return
         try {
@@ -1760,7 +2897,17 @@ class TcpServer : AutoCloseable {
           }
           return
         }
-        this.enableKeepAlive(0u)
+        if (this@TcpServer.usesIoRings) {
+          this.ioRingLoopIndex = this.getLoopIndex(this.nativeObject)
+          this.ioSubmissionRing = this@TcpServer.ioSubmissionRings[this.ioRingLoopIndex]
+          this@TcpServer.ioRingConnections.put(this.nativeObjectAddress, this)
+        }
+        // NOTE: Keep-alive gets enabled natively, along with the server’s
+        // default socket options, once the connection has been accepted.
+        this.isKeepAliveEnabled = true
+        if (this@TcpServer.isReadingPaused) {
+          this.pauseReading()
+        }
       }
     }
 
@@ -1771,7 +2918,14 @@ class TcpServer : AutoCloseable {
                                           handleClosedEventFunction: ClosedEventHandlerFunction,
                                           handleClosedEventFunctionClass: Class<out ClosedEventHandlerFunction>,
                                           handleErrorOccurredEventFunction: ErrorOccurredEventHandlerFunction,
-                                          handleErrorOccurredEventFunctionClass: Class<out ErrorOccurredEventHandlerFunction>): Boolean
+                                          handleErrorOccurredEventFunctionClass: Class<out ErrorOccurredEventHandlerFunction>,
+                                          ioCompletionSinkFunction: IoCompletionSinkFunction,
+                                          ioCompletionSinkFunctionClass: Class<out IoCompletionSinkFunction>): Boolean
+
+    private fun clearPendingOperation(operationId: Int) {
+      this.pendingOperationBuffers.set(operationId, null)
+      this.pendingOperationCallbacks.set(operationId, null)
+    }
 
     @Synchronized
     override fun close() {
@@ -1783,7 +2937,9 @@ class TcpServer : AutoCloseable {
       this@TcpServer.closeFlagReadWriteLock.read {
         if (this@TcpServer.isClosedOrClosing) return
         try {
-          this.closeUvTcpHandle(this.nativeObject)
+          if (! this.submitToIoRing(IoSubmissionRing.OPCODE_CLOSE, null, 0, 0, 0)) {
+            this.closeUvTcpHandle(this.nativeObject)
+          }
         } catch (exception: UvException) {
           this.emitNotCloseableErrorEvent()
           return
@@ -1834,6 +2990,10 @@ class TcpServer : AutoCloseable {
       this.events.emitEvent(TcpServer.CLIENT_NOT_CLOSEABLE_ERROR_EVENT_NAME)
     }
 
+    private fun emitWritabilityChangedEvent(isWritable: Boolean) {
+      this.events.emitEvent(TcpServer.WRITABILITY_CHANGED_EVENT_NAME, isWritable)
+    }
+
     override fun enableKeepAlive(initialDelay: Int) {
       return this.enableKeepAlive(when {
         (initialDelay >= 0) -> initialDelay.toUInt()
@@ -1856,6 +3016,15 @@ class TcpServer : AutoCloseable {
       this.isKeepAliveEnabled = true
     }
 
+    @Throws(ClosedChannelException::class,
+            UvException::class)
+    override fun getSocketOption(option: SocketOption): Int {
+      if (this.isClosedOrClosing) {
+        throw ClosedChannelException()
+      }
+      return this.uvTcpGetSocketOption(this.nativeObject, option.id)
+    }
+
     @Synchronized
     private fun finishClosing() {
       if (this.isClosed) return
@@ -1869,6 +3038,8 @@ class TcpServer : AutoCloseable {
       this.events.removeAllEventHandlers()
     }
 
+    private external fun getLoopIndex(nativeObject: ByteBuffer): Int
+
     @Throws(UvException::class)
     private external fun getUvTcpBoundAddress(nativeObject: ByteBuffer,
                                               createAddressMethodFunction: Function3<String, Int, Int, TcpServer.AddressInternal>,
@@ -1879,6 +3050,16 @@ class TcpServer : AutoCloseable {
                                                createAddressMethodFunction: Function3<String, Int, Int, TcpServer.AddressInternal>,
                                                createAddressMethodFunctionClass: Class<out Function3<String, Int, Int, TcpServer.AddressInternal>>): TcpServer.AddressInternal
 
+    fun handleIoRingCompletion(operationId: Int,
+                               result: Int,
+                               errorNumber: Int) {
+      if (operationId == IoCompletionRing.CLOSED_OPERATION_ID) {
+        this.handleClosedEventFunction.handle()
+        return
+      }
+      this.ioCompletionSinkFunction.handleIoCompleted(operationId, result, errorNumber)
+    }
+
     private fun handleNotCloseableErrors() {
       this.events.onEvent(TcpServer.CLIENT_NOT_CLOSEABLE_ERROR_EVENT_NAME, object : EventHandlerFunction {
         override fun handle(data: Any?) {
@@ -1946,6 +3127,72 @@ class TcpServer : AutoCloseable {
       })
     }
 
+    override fun onWritabilityChanged(handler: WritabilityChangedEventHandlerFunction) {
+      if (this.isClosedOrClosing) return
+      this.events.onEvent(TcpServer.WRITABILITY_CHANGED_EVENT_NAME, object : EventHandlerFunction {
+        override fun handle(data: Any?) {
+          handler(data as Boolean)
+        }
+      })
+    }
+
+    @JvmSynthetic
+    override fun onWritabilityChanged(handler: (@ParameterName("isWritable") Boolean) -> Unit) {
+      return this.onWritabilityChanged(object : WritabilityChangedEventHandlerFunction {
+        override fun handle(isWritable: Boolean) {
+          return handler(isWritable)
+        }
+      })
+    }
+
+    @Synchronized
+    override fun pauseReading() {
+      if (this.isClosedOrClosing) return
+      if (this.isReadingPaused) return
+      try {
+        this.uvTcpPauseReading(this.nativeObject)
+      } catch (exception: UvException) {
+        this.emitErrorOccurredEvent(exception)
+        return
+      }
+      this.isReadingPaused = true
+    }
+
+    // NOTE: Hands a write over to the native layer (using the given function,
+    // which gets the write’s operation ID, and whether the write may go through
+    // the submission ring), keeping its buffer reachable until it completes.
+    // Only a write issued while none are pending may go through the ring (see
+    // the native side’s `carlie_tcp_server_run_io_ring_submission(…)`).
+    @Throws(UvException::class,
+            WritePendingException::class)
+    private inline fun queueWrite(buffer: Any,
+                                  callback: IoCompletedCallbackFunction,
+                                  submitFunction: (Int, Boolean) -> Unit) {
+      this.writeSubmissionLock.withLock {
+        if (this.writeLock.isLocked) {
+          throw WritePendingException()
+        }
+        val operationId = this.nextWriteOperationId
+        val ioRingMayBeUsed = this.pendingWriteCallbacks.isEmpty()
+        this.pendingWriteBuffers.put(operationId, buffer)
+        this.pendingWriteCallbacks.put(operationId, callback)
+        var isSubmitted = false
+        try {
+          submitFunction(operationId, ioRingMayBeUsed)
+          isSubmitted = true
+        } finally {
+          if (! isSubmitted) {
+            this.pendingWriteBuffers.remove(operationId)
+            this.pendingWriteCallbacks.remove(operationId)
+          }
+        }
+        this.nextWriteOperationId = when (operationId) {
+          Int.MAX_VALUE -> TcpServer.FIRST_WRITE_OPERATION_ID
+          else -> operationId + 1
+        }
+      }
+    }
+
     @Throws(ClosedChannelException::class,
             ReadPendingException::class)
     override fun read(destinationBuffer: ByteBuffer): Future<Int> {
@@ -1986,25 +3233,31 @@ class TcpServer : AutoCloseable {
         }
         val bufferSize = remainingDestinationBufferBytesCount
         val destinationBufferPosition = destinationBuffer.position()
-        val buffer = ByteArray(bufferSize)
-        val callback = l@{
-          bytesReadCount: Int?,
-          error: UvException? ->
-            this.readLock.unlock()
-            if (error != null) {
-              this.emitErrorOccurredEvent(error)
+        // NOTE: Direct buffers are handed to the native layer as-is, so libuv
+        // reads straight into the destination buffer’s memory; otherwise, the
+        // data is read into an intermediate array and copied over afterwards.
+        val buffer = when {
+          destinationBuffer.isDirect() -> null
+          else -> ByteArray(bufferSize)
+        }
+        val callback = object : IoCompletedCallbackFunction {
+          override fun handle(result: Int, errorNumber: Int) {
+            this@ConnectionInternal.readLock.unlock()
+            if (errorNumber != 0) {
+              this@ConnectionInternal.emitErrorOccurredEvent(UvException(errorNumber))
               // NOTE: `handler.completed(0, …)` is called on failure rather
               // than `handler.failed(…)` since the error is being handled via
               // the event system instead.
               handler.completed(0, attachment)
-              return@l
+              return
             }
-            bytesReadCount!!
+            val bytesReadCount = result
             when {
               (bytesReadCount > 0) -> {
-                for (i in 0 until bytesReadCount) {
-                  val destinationBufferIndex = destinationBufferPosition + i
-                  destinationBuffer.put(destinationBufferIndex, buffer[i])
+                if (buffer != null) {
+                  val destinationBufferDuplicate = destinationBuffer.duplicate()
+                  destinationBufferDuplicate.position(destinationBufferPosition)
+                  destinationBufferDuplicate.put(buffer, 0, bytesReadCount)
                 }
                 destinationBuffer.position(destinationBufferPosition + bytesReadCount)
                 handler.completed(bytesReadCount, attachment)
@@ -2016,13 +3269,21 @@ class TcpServer : AutoCloseable {
               else -> {
                 // EOF (end-of-stream) has been reached.
                 handler.completed(-1, attachment)
-                this.close()
+                this@ConnectionInternal.close()
               }
             }
+          }
         }
-        val callbackClass = callback::class.java
+        this.pendingOperationBuffers.set(TcpServer.READ_OPERATION_ID, buffer ?: destinationBuffer)
+        this.pendingOperationCallbacks.set(TcpServer.READ_OPERATION_ID, callback)
         try {
-          this.uvTcpRead(this.nativeObject, buffer, bufferSize, callback, callbackClass)
+          if (buffer != null) {
+            this.uvTcpRead(this.nativeObject, buffer, bufferSize, TcpServer.READ_OPERATION_ID)
+          } else {
+            if (! this.submitToIoRing(IoSubmissionRing.OPCODE_READ, destinationBuffer, destinationBufferPosition, bufferSize, TcpServer.READ_OPERATION_ID)) {
+              this.uvTcpReadDirect(this.nativeObject, destinationBuffer, destinationBufferPosition, bufferSize, TcpServer.READ_OPERATION_ID)
+            }
+          }
         } catch (exception: UvException) {
           this.emitErrorOccurredEvent(exception)
           return
@@ -2030,33 +3291,386 @@ class TcpServer : AutoCloseable {
         keepReadLockLocked = true
       } finally {
         if (! keepReadLockLocked) {
+          this.clearPendingOperation(TcpServer.READ_OPERATION_ID)
           this.readLock.unlock()
         }
       }
     }
 
-    override fun toString(): String {
-      val prefix = "TCP client connection {"
-      val suffix = "}"
-      return when {
-        this.isClosing -> "${prefix}status=CLOSING${suffix}"
-        this.isClosed -> "${prefix}status=CLOSED${suffix}"
-        else -> {
-          val (localIpAddress, localAddressVersion, localAddressPort) = this.localAddress!!
-          val localAddress = "(IP=${localIpAddress}, version=${localAddressVersion}, port=${localAddressPort})"
-          val (remoteIpAddress, remoteAddressVersion, remoteAddressPort) = this.remoteAddress!!
-          val remoteAddress = "(IP=${remoteIpAddress}, version=${remoteAddressVersion}, port=${remoteAddressPort})"
-          val spacePrefix = {
-            val spaces = CharArray(prefix.length) {
-              ' '
-            }
-            spaces.joinToString("")
-          }()
-          var result = ""
-          result += prefix
-          result += "status=CONNECTED"
-          result += ",\n"
-          result += spacePrefix
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class)
+    override fun read(destinationBuffers: Array<ByteBuffer>,
+                      offset: Int,
+                      length: Int): Future<Long> {
+      val futureResult: CompletableFuture<Long> = CompletableFuture()
+      this@ConnectionInternal.read(destinationBuffers, offset, length, Unit, object : CompletionHandler<Long, Unit> {
+        override fun completed(result: Long,
+                               attachment: Unit) {
+          futureResult.complete(result)
+        }
+
+        override fun failed(exception: Throwable,
+                            attachment: Unit) {}
+      })
+      return futureResult
+    }
+
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class)
+    override fun <A> read(destinationBuffers: Array<ByteBuffer>,
+                          offset: Int,
+                          length: Int,
+                          attachment: A,
+                          handler: CompletionHandler<Long, in A>) {
+      if ((offset < 0) ||
+          (length < 0) ||
+          (offset > (destinationBuffers.size - length))) {
+        throw IndexOutOfBoundsException()
+      }
+      if (this.isClosedOrClosing) {
+        throw ClosedChannelException()
+      }
+      val readLockIsAcquired = this.readLock.tryLock()
+      if (! readLockIsAcquired) {
+        throw ReadPendingException()
+      }
+      var keepReadLockLocked = false
+      try {
+        // NOTE: The native side reports the number of bytes read as an `Int`,
+        // so only as many bytes as fit into one are read at most.
+        var bufferCount = 0
+        var bufferSizesSum = 0L
+        var heapBufferSizesSum = 0
+        val bufferSizes = IntArray(length)
+        for (index in 0 until length) {
+          if (bufferSizesSum == Int.MAX_VALUE.toLong()) break
+          val destinationBuffer = destinationBuffers[offset + index]
+          val bufferSize = minOf(destinationBuffer.remaining().toLong(), (Int.MAX_VALUE - bufferSizesSum)).toInt()
+          bufferSizes[index] = bufferSize
+          bufferSizesSum += bufferSize
+          if (! destinationBuffer.isDirect()) {
+            heapBufferSizesSum += bufferSize
+          }
+          bufferCount = index + 1
+        }
+        if (bufferSizesSum == 0L) {
+          handler.completed(0L, attachment)
+          return
+        }
+        // NOTE: Direct buffers are handed to the native layer as-is; any other
+        // buffers are read into (slices of) a scratch direct buffer instead,
+        // and copied over afterwards.
+        val scratchBuffer = when {
+          (heapBufferSizesSum == 0) -> null
+          else -> {
+            var scratchBuffer = this.readScratchBuffer
+            if ((scratchBuffer == null) ||
+                (scratchBuffer.capacity() < heapBufferSizesSum)) {
+              scratchBuffer = ByteBuffer.allocateDirect(heapBufferSizesSum)
+              this.readScratchBuffer = scratchBuffer
+            }
+            scratchBuffer!!
+          }
+        }
+        var scratchBufferPosition = 0
+        val buffers = Array(bufferCount) {
+          index ->
+            val destinationBuffer = destinationBuffers[offset + index]
+            when {
+              destinationBuffer.isDirect() -> destinationBuffer
+              else -> scratchBuffer!!
+            }
+        }
+        val bufferOffsets = IntArray(bufferCount) {
+          index ->
+            val destinationBuffer = destinationBuffers[offset + index]
+            when {
+              destinationBuffer.isDirect() -> destinationBuffer.position()
+              else -> {
+                val bufferOffset = scratchBufferPosition
+                scratchBufferPosition += bufferSizes[index]
+                bufferOffset
+              }
+            }
+        }
+        val destinationBufferPositions = IntArray(bufferCount) {
+          index ->
+            destinationBuffers[offset + index].position()
+        }
+        val callback = object : IoCompletedCallbackFunction {
+          override fun handle(result: Int, errorNumber: Int) {
+            this@ConnectionInternal.readLock.unlock()
+            if (errorNumber != 0) {
+              this@ConnectionInternal.emitErrorOccurredEvent(UvException(errorNumber))
+              // NOTE: `handler.completed(0, …)` is called on failure rather
+              // than `handler.failed(…)` since the error is being handled via
+              // the event system instead.
+              handler.completed(0L, attachment)
+              return
+            }
+            val bytesReadCount = result
+            when {
+              (bytesReadCount > 0) -> {
+                var remainingBytesReadCount = bytesReadCount
+                for (index in 0 until bufferCount) {
+                  if (remainingBytesReadCount == 0) break
+                  val bufferBytesReadCount = minOf(remainingBytesReadCount, bufferSizes[index])
+                  val destinationBuffer = destinationBuffers[offset + index]
+                  val destinationBufferPosition = destinationBufferPositions[index]
+                  if (! destinationBuffer.isDirect()) {
+                    scratchBuffer!!
+                    val scratchBufferDuplicate = scratchBuffer.duplicate()
+                    scratchBufferDuplicate.limit(bufferOffsets[index] + bufferBytesReadCount)
+                    scratchBufferDuplicate.position(bufferOffsets[index])
+                    val destinationBufferDuplicate = destinationBuffer.duplicate()
+                    destinationBufferDuplicate.position(destinationBufferPosition)
+                    destinationBufferDuplicate.put(scratchBufferDuplicate)
+                  }
+                  destinationBuffer.position(destinationBufferPosition + bufferBytesReadCount)
+                  remainingBytesReadCount -= bufferBytesReadCount
+                }
+                handler.completed(bytesReadCount.toLong(), attachment)
+              }
+              (bytesReadCount == 0) -> {
+                // No bytes were read, unfortunately.
+                handler.completed(0L, attachment)
+              }
+              else -> {
+                // EOF (end-of-stream) has been reached.
+                handler.completed(-1L, attachment)
+                this@ConnectionInternal.close()
+              }
+            }
+          }
+        }
+        this.pendingOperationBuffers.set(TcpServer.READ_OPERATION_ID, buffers)
+        this.pendingOperationCallbacks.set(TcpServer.READ_OPERATION_ID, callback)
+        try {
+          this.uvTcpReadScattered(this.nativeObject, buffers, bufferOffsets, bufferSizes, bufferCount, TcpServer.READ_OPERATION_ID)
+        } catch (exception: UvException) {
+          this.emitErrorOccurredEvent(exception)
+          return
+        }
+        keepReadLockLocked = true
+      } finally {
+        if (! keepReadLockLocked) {
+          this.clearPendingOperation(TcpServer.READ_OPERATION_ID)
+          this.readLock.unlock()
+        }
+      }
+    }
+
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class,
+            WritePendingException::class)
+    override fun relayTo(destination: TcpServer.Connection): Future<Unit> {
+      val futureResult: CompletableFuture<Unit> = CompletableFuture()
+      this@ConnectionInternal.relayTo(destination, Unit, object : CompletionHandler<Unit, Unit> {
+        override fun completed(result: Unit,
+                               attachment: Unit) {
+          futureResult.complete(result)
+        }
+
+        override fun failed(exception: Throwable,
+                            attachment: Unit) {}
+      })
+      return futureResult
+    }
+
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class,
+            WritePendingException::class)
+    override fun <A> relayTo(destination: TcpServer.Connection,
+                             attachment: A,
+                             handler: CompletionHandler<Unit, in A>) {
+      if ((destination === this) ||
+          (destination !is TcpServer.ConnectionInternal)) {
+        throw IllegalArgumentException()
+      }
+      if (this.isClosedOrClosing ||
+          destination.isClosedOrClosing) {
+        throw ClosedChannelException()
+      }
+      val readLockIsAcquired = this.readLock.tryLock()
+      if (! readLockIsAcquired) {
+        throw ReadPendingException()
+      }
+      val destinationWriteLockIsAcquired = destination.tryLockWrites()
+      if (! destinationWriteLockIsAcquired) {
+        this.readLock.unlock()
+        throw WritePendingException()
+      }
+      var keepLocksLocked = false
+      try {
+        val callback = object : IoCompletedCallbackFunction {
+          override fun handle(result: Int, errorNumber: Int) {
+            destination.writeLock.unlock()
+            this@ConnectionInternal.readLock.unlock()
+            // NOTE: Same as for reads, an error is being handled via the
+            // event system instead.
+            if (errorNumber != 0) {
+              this@ConnectionInternal.emitErrorOccurredEvent(UvException(errorNumber))
+            }
+            handler.completed(Unit, attachment)
+          }
+        }
+        // NOTE: Keeps the destination (and its native object) reachable for as
+        // long as the relay runs.
+        this.pendingOperationBuffers.set(TcpServer.READ_OPERATION_ID, destination)
+        this.pendingOperationCallbacks.set(TcpServer.READ_OPERATION_ID, callback)
+        try {
+          this.uvTcpRelay(this.nativeObject, destination.nativeObject, TcpServer.READ_OPERATION_ID)
+        } catch (exception: UvException) {
+          this.emitErrorOccurredEvent(exception)
+          return
+        }
+        keepLocksLocked = true
+      } finally {
+        if (! keepLocksLocked) {
+          this.clearPendingOperation(TcpServer.READ_OPERATION_ID)
+          destination.writeLock.unlock()
+          this.readLock.unlock()
+        }
+      }
+    }
+
+    @Synchronized
+    override fun resumeReading() {
+      if (this.isClosedOrClosing) return
+      if (! this.isReadingPaused) return
+      try {
+        this.uvTcpResumeReading(this.nativeObject)
+      } catch (exception: UvException) {
+        this.emitErrorOccurredEvent(exception)
+        return
+      }
+      this.isReadingPaused = false
+    }
+
+    @Throws(ClosedChannelException::class,
+            UvException::class)
+    override fun setSocketOption(option: SocketOption,
+                                 value: Int) {
+      if (! option.isValidValue(value)) {
+        throw IllegalArgumentException()
+      }
+      if (this.isClosedOrClosing) {
+        throw ClosedChannelException()
+      }
+      this.uvTcpSetSocketOption(this.nativeObject, option.id, value)
+    }
+
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class)
+    override fun startReading(handler: DataReceivedEventHandlerFunction) {
+      if (this.isClosedOrClosing) {
+        throw ClosedChannelException()
+      }
+      val readLockIsAcquired = this.readLock.tryLock()
+      if (! readLockIsAcquired) {
+        throw ReadPendingException()
+      }
+      var keepReadLockLocked = false
+      try {
+        val callback = object : StreamingReadCallbackFunction {
+          override fun handleData(data: ByteBuffer) {
+            // NOTE: The data is a view of native memory that gets reused, so
+            // the handler only gets to read it.
+            handler(data.asReadOnlyBuffer())
+          }
+
+          override fun handle(result: Int, errorNumber: Int) {
+            this@ConnectionInternal.readLock.unlock()
+            if (errorNumber != 0) {
+              this@ConnectionInternal.emitErrorOccurredEvent(UvException(errorNumber))
+              return
+            }
+            if (result < 0) {
+              // EOF (end-of-stream) has been reached.
+              this@ConnectionInternal.close()
+            }
+            // Otherwise, reading has been stopped.
+          }
+        }
+        this.pendingOperationCallbacks.set(TcpServer.READ_OPERATION_ID, callback)
+        try {
+          this.uvTcpStartReading(this.nativeObject, TcpServer.READ_OPERATION_ID)
+        } catch (exception: UvException) {
+          this.emitErrorOccurredEvent(exception)
+          return
+        }
+        keepReadLockLocked = true
+      } finally {
+        if (! keepReadLockLocked) {
+          this.clearPendingOperation(TcpServer.READ_OPERATION_ID)
+          this.readLock.unlock()
+        }
+      }
+    }
+
+    @JvmSynthetic
+    @Throws(ClosedChannelException::class,
+            ReadPendingException::class)
+    override fun startReading(handler: (@ParameterName("data") ByteBuffer) -> Unit) {
+      return this.startReading(object : DataReceivedEventHandlerFunction {
+        override fun handle(data: ByteBuffer) {
+          return handler(data)
+        }
+      })
+    }
+
+    override fun stopReading() {
+      if (this.isClosedOrClosing) return
+      try {
+        this.uvTcpStopReading(this.nativeObject)
+      } catch (exception: UvException) {
+        this.emitErrorOccurredEvent(exception)
+      }
+    }
+
+    // NOTE: Returns `false` when the operation couldn’t be queued (no ring, or a
+    // full one), in which case the caller falls back to the JNI call.
+    private fun submitToIoRing(opcode: Int,
+                               buffer: ByteBuffer?,
+                               bufferPosition: Int,
+                               bufferSize: Int,
+                               operationId: Int): Boolean {
+      val ioSubmissionRing = this.ioSubmissionRing ?: return false
+      val bufferAddress = when (buffer) {
+        null -> 0L
+        else -> UnsafeMemory.getDirectBufferAddress(buffer) + bufferPosition
+      }
+      if (! ioSubmissionRing.offer(this.nativeObjectAddress, bufferAddress, bufferSize, opcode, operationId)) {
+        return false
+      }
+      if (ioSubmissionRing.needsWakeUp) {
+        this@TcpServer.wakeUpUvLoop(this@TcpServer.nativeObject, this.ioRingLoopIndex)
+      }
+      return true
+    }
+
+    override fun toString(): String {
+      val prefix = "TCP client connection {"
+      val suffix = "}"
+      return when {
+        this.isClosing -> "${prefix}status=CLOSING${suffix}"
+        this.isClosed -> "${prefix}status=CLOSED${suffix}"
+        else -> {
+          val (localIpAddress, localAddressVersion, localAddressPort) = this.localAddress!!
+          val localAddress = "(IP=${localIpAddress}, version=${localAddressVersion}, port=${localAddressPort})"
+          val (remoteIpAddress, remoteAddressVersion, remoteAddressPort) = this.remoteAddress!!
+          val remoteAddress = "(IP=${remoteIpAddress}, version=${remoteAddressVersion}, port=${remoteAddressPort})"
+          val spacePrefix = {
+            val spaces = CharArray(prefix.length) {
+              ' '
+            }
+            spaces.joinToString("")
+          }()
+          var result = ""
+          result += prefix
+          result += "status=CONNECTED"
+          result += ",\n"
+          result += spacePrefix
           result += "localAddress=${localAddress}"
           result += ",\n"
           result += spacePrefix
@@ -2067,6 +3681,126 @@ class TcpServer : AutoCloseable {
       }
     }
 
+    @Throws(ClosedChannelException::class,
+            WritePendingException::class)
+    override fun transferFrom(fileChannel: FileChannel,
+                              position: Long,
+                              count: Long): Future<Long> {
+      val futureResult: CompletableFuture<Long> = CompletableFuture()
+      this@ConnectionInternal.transferFrom(fileChannel, position, count, Unit, object : CompletionHandler<Long, Unit> {
+        override fun completed(result: Long,
+                               attachment: Unit) {
+          futureResult.complete(result)
+        }
+
+        override fun failed(exception: Throwable,
+                            attachment: Unit) {}
+      })
+      return futureResult
+    }
+
+    @Throws(ClosedChannelException::class,
+            WritePendingException::class)
+    override fun <A> transferFrom(fileChannel: FileChannel,
+                                  position: Long,
+                                  count: Long,
+                                  attachment: A,
+                                  handler: CompletionHandler<Long, in A>) {
+      if ((position < 0L) ||
+          (count < 0L)) {
+        throw IllegalArgumentException()
+      }
+      if (this.isClosedOrClosing) {
+        throw ClosedChannelException()
+      }
+      val writeLockIsAcquired = this.tryLockWrites()
+      if (! writeLockIsAcquired) {
+        throw WritePendingException()
+      }
+      var keepWriteLockLocked = false
+      try {
+        // NOTE: Same as for gathering writes, the native side reports the
+        // number of bytes transferred as an `Int`.
+        val bytesCount = minOf(count, Int.MAX_VALUE.toLong()).toInt()
+        if (bytesCount == 0) {
+          handler.completed(0L, attachment)
+          return
+        }
+        val callback = object : IoCompletedCallbackFunction {
+          override fun handle(result: Int, errorNumber: Int) {
+            this@ConnectionInternal.writeLock.unlock()
+            if (errorNumber != 0) {
+              this@ConnectionInternal.emitErrorOccurredEvent(UvException(errorNumber))
+              // NOTE: Same as for writes, the error is being handled via the
+              // event system instead.
+              handler.completed(0L, attachment)
+              return
+            }
+            val bytesTransferredCount = result
+            handler.completed(bytesTransferredCount.toLong(), attachment)
+          }
+        }
+        this.pendingOperationCallbacks.set(TcpServer.TRANSFER_OPERATION_ID, callback)
+        try {
+          this.uvTcpSendFile(this.nativeObject, fileChannel, position, bytesCount, TcpServer.TRANSFER_OPERATION_ID)
+        } catch (exception: UvException) {
+          this.emitErrorOccurredEvent(exception)
+          return
+        }
+        keepWriteLockLocked = true
+      } finally {
+        if (! keepWriteLockLocked) {
+          this.clearPendingOperation(TcpServer.TRANSFER_OPERATION_ID)
+          this.writeLock.unlock()
+        }
+      }
+    }
+
+    @Throws(ClosedChannelException::class,
+            IOException::class,
+            WritePendingException::class)
+    override fun transferFrom(path: Path,
+                              position: Long,
+                              count: Long): Future<Long> {
+      val futureResult: CompletableFuture<Long> = CompletableFuture()
+      this@ConnectionInternal.transferFrom(path, position, count, Unit, object : CompletionHandler<Long, Unit> {
+        override fun completed(result: Long,
+                               attachment: Unit) {
+          futureResult.complete(result)
+        }
+
+        override fun failed(exception: Throwable,
+                            attachment: Unit) {}
+      })
+      return futureResult
+    }
+
+    @Throws(ClosedChannelException::class,
+            IOException::class,
+            WritePendingException::class)
+    override fun <A> transferFrom(path: Path,
+                                  position: Long,
+                                  count: Long,
+                                  attachment: A,
+                                  handler: CompletionHandler<Long, in A>) {
+      // NOTE: The native side keeps a duplicate of the file’s descriptor for
+      // as long as the transfer is pending, so the channel can be closed right
+      // away.
+      FileChannel.open(path, StandardOpenOption.READ).use {
+        fileChannel ->
+          this.transferFrom(fileChannel, position, count, attachment, handler)
+      }
+    }
+
+    private fun tryLockWrites(): Boolean {
+      this.writeSubmissionLock.withLock {
+        if (! this.pendingWriteCallbacks.isEmpty()) {
+          return false
+        }
+        return this.writeLock.tryLock()
+      }
+    }
+
     @Throws(UvException::class)
     @Synchronized
     private external fun uvTcpDisableKeepAlive(nativeObject: ByteBuffer)
@@ -2076,19 +3810,83 @@ class TcpServer : AutoCloseable {
     private external fun uvTcpEnableKeepAlive(nativeObject: ByteBuffer,
                                               initialDelay: Int)
 
+    @Throws(UvException::class)
+    @Synchronized
+    private external fun uvTcpGetSocketOption(nativeObject: ByteBuffer,
+                                              optionId: Int): Int
+
+    @Throws(UvException::class)
+    private external fun uvTcpPauseReading(nativeObject: ByteBuffer)
+
     @Throws(UvException::class)
     private external fun uvTcpRead(nativeObject: ByteBuffer,
                                    buffer: ByteArray,
                                    bufferSize: Int,
-                                   callback: Function2<Int, UvException?, Unit>,
-                                   callbackClass: Class<out Function2<Int, UvException?, Unit>>)
+                                   operationId: Int)
+
+    @Throws(UvException::class)
+    private external fun uvTcpReadDirect(nativeObject: ByteBuffer,
+                                         buffer: ByteBuffer,
+                                         bufferOffset: Int,
+                                         bufferSize: Int,
+                                         operationId: Int)
+
+    @Throws(UvException::class)
+    private external fun uvTcpReadScattered(nativeObject: ByteBuffer,
+                                            buffers: Array<ByteBuffer>,
+                                            bufferOffsets: IntArray,
+                                            bufferSizes: IntArray,
+                                            bufferCount: Int,
+                                            operationId: Int)
+
+    @Throws(UvException::class)
+    private external fun uvTcpRelay(nativeObject: ByteBuffer,
+                                    destinationNativeObject: ByteBuffer,
+                                    operationId: Int)
+
+    @Throws(UvException::class)
+    private external fun uvTcpResumeReading(nativeObject: ByteBuffer)
+
+    @Throws(UvException::class)
+    private external fun uvTcpSendFile(nativeObject: ByteBuffer,
+                                       fileChannel: FileChannel,
+                                       position: Long,
+                                       count: Int,
+                                       operationId: Int)
+
+    @Throws(UvException::class)
+    @Synchronized
+    private external fun uvTcpSetSocketOption(nativeObject: ByteBuffer,
+                                              optionId: Int,
+                                              value: Int)
+
+    @Throws(UvException::class)
+    private external fun uvTcpStartReading(nativeObject: ByteBuffer,
+                                           operationId: Int)
+
+    @Throws(UvException::class)
+    private external fun uvTcpStopReading(nativeObject: ByteBuffer)
 
     @Throws(UvException::class)
     private external fun uvTcpWrite(nativeObject: ByteBuffer,
                                     buffer: ByteArray,
                                     bufferSize: Int,
-                                    callback: Function2<Int, UvException?, Unit>,
-                                    callbackClass: Class<out Function2<Int, UvException?, Unit>>)
+                                    operationId: Int)
+
+    @Throws(UvException::class)
+    private external fun uvTcpWriteDirect(nativeObject: ByteBuffer,
+                                          buffer: ByteBuffer,
+                                          bufferOffset: Int,
+                                          bufferSize: Int,
+                                          operationId: Int)
+
+    @Throws(UvException::class)
+    private external fun uvTcpWriteGathered(nativeObject: ByteBuffer,
+                                            buffers: Array<ByteBuffer>,
+                                            bufferOffsets: IntArray,
+                                            bufferSizes: IntArray,
+                                            bufferCount: Int,
+                                            operationId: Int)
 
     @Throws(ClosedChannelException::class,
             WritePendingException::class)
@@ -2114,66 +3912,201 @@ class TcpServer : AutoCloseable {
       if (this.isClosedOrClosing) {
         throw ClosedChannelException()
       }
-      val writeLockIsAcquired = this.writeLock.tryLock()
-      if (! writeLockIsAcquired) {
-        throw WritePendingException()
+      val remainingSourceBufferBytesCount = sourceBuffer.remaining()
+      if (remainingSourceBufferBytesCount == 0) {
+        handler.completed(0, attachment)
+        return
       }
-      var keepWriteLockLocked = false
-      try {
-        val remainingSourceBufferBytesCount = sourceBuffer.remaining()
-        if (remainingSourceBufferBytesCount == 0) {
-          handler.completed(0, attachment)
-          return
+      val bufferSize = remainingSourceBufferBytesCount
+      val sourceBufferPosition = sourceBuffer.position()
+      // NOTE: Direct buffers are handed to the native layer as-is, so libuv
+      // writes straight from the source buffer’s memory; otherwise, the data is
+      // copied into an intermediate array first.
+      val buffer = when {
+        sourceBuffer.isDirect() -> null
+        sourceBuffer.hasArray() -> {
+          val array = sourceBuffer.array()
+          array!!
+          val arrayOffset = sourceBuffer.arrayOffset()
+          val arrayPosition = arrayOffset + sourceBufferPosition
+          val lastArrayIndex = arrayPosition + (bufferSize - 1)
+          array.sliceArray(arrayPosition..lastArrayIndex)
         }
-        val bufferSize = remainingSourceBufferBytesCount
-        val sourceBufferPosition = sourceBuffer.position()
-        // TODO: It might be more efficient to always just create a new byte
-        // array directly, regardless if the source buffer has an accessible
-        // array (the slice operation still creates a new array anyway). Look
-        // into this.
-        val buffer = when {
-          sourceBuffer.hasArray() -> {
-            val array = sourceBuffer.array()
-            array!!
-            val arrayOffset = sourceBuffer.arrayOffset()
-            val arrayPosition = arrayOffset + sourceBufferPosition
-            val lastArrayIndex = arrayPosition + (bufferSize - 1)
-            array.sliceArray(arrayPosition..lastArrayIndex)
+        else -> {
+          val array = ByteArray(bufferSize)
+          sourceBuffer.duplicate().get(array)
+          array
+        }
+      }
+      val callback = object : IoCompletedCallbackFunction {
+        override fun handle(result: Int, errorNumber: Int) {
+          if (errorNumber != 0) {
+            this@ConnectionInternal.emitErrorOccurredEvent(UvException(errorNumber))
+            // NOTE: `handler.completed(0, …)` is called on failure rather than
+            // `handler.failed(…)` since the error is being handled via the
+            // event system instead.
+            handler.completed(0, attachment)
+            return
           }
-          else -> {
-            ByteArray(bufferSize) {
-              index ->
-                sourceBuffer.get(sourceBufferPosition + index)
+          val bytesWrittenCount = result
+          sourceBuffer.position(sourceBufferPosition + bytesWrittenCount)
+          handler.completed(bytesWrittenCount, attachment)
+        }
+      }
+      try {
+        this.queueWrite(buffer ?: sourceBuffer, callback) {
+          operationId, ioRingMayBeUsed ->
+            if (buffer != null) {
+              this.uvTcpWrite(this.nativeObject, buffer, bufferSize, operationId)
+            } else if ((! ioRingMayBeUsed) ||
+                       (! this.submitToIoRing(IoSubmissionRing.OPCODE_WRITE, sourceBuffer, sourceBufferPosition, bufferSize, operationId))) {
+              this.uvTcpWriteDirect(this.nativeObject, sourceBuffer, sourceBufferPosition, bufferSize, operationId)
             }
+        }
+      } catch (exception: UvException) {
+        this.emitErrorOccurredEvent(exception)
+      }
+    }
+
+    @Throws(ClosedChannelException::class,
+            WritePendingException::class)
+    override fun write(sourceBuffers: Array<ByteBuffer>,
+                       offset: Int,
+                       length: Int): Future<Long> {
+      val futureResult: CompletableFuture<Long> = CompletableFuture()
+      this@ConnectionInternal.write(sourceBuffers, offset, length, Unit, object : CompletionHandler<Long, Unit> {
+        override fun completed(result: Long,
+                               attachment: Unit) {
+          futureResult.complete(result)
+        }
+
+        override fun failed(exception: Throwable,
+                            attachment: Unit) {}
+      })
+      return futureResult
+    }
+
+    @Throws(ClosedChannelException::class,
+            WritePendingException::class)
+    override fun <A> write(sourceBuffers: Array<ByteBuffer>,
+                           offset: Int,
+                           length: Int,
+                           attachment: A,
+                           handler: CompletionHandler<Long, in A>) {
+      if ((offset < 0) ||
+          (length < 0) ||
+          (offset > (sourceBuffers.size - length))) {
+        throw IndexOutOfBoundsException()
+      }
+      if (this.isClosedOrClosing) {
+        throw ClosedChannelException()
+      }
+      // NOTE: The native side reports the number of bytes written as an
+      // `Int`, so only as many bytes as fit into one are submitted; the rest
+      // is left for a subsequent write, as is allowed for gathering writes.
+      var bufferCount = 0
+      var bufferSizesSum = 0L
+      var heapBufferSizesSum = 0
+      val bufferSizes = IntArray(length)
+      for (index in 0 until length) {
+        if (bufferSizesSum == Int.MAX_VALUE.toLong()) break
+        val sourceBuffer = sourceBuffers[offset + index]
+        val bufferSize = minOf(sourceBuffer.remaining().toLong(), (Int.MAX_VALUE - bufferSizesSum)).toInt()
+        bufferSizes[index] = bufferSize
+        bufferSizesSum += bufferSize
+        if (! sourceBuffer.isDirect()) {
+          heapBufferSizesSum += bufferSize
+        }
+        bufferCount = index + 1
+      }
+      if (bufferSizesSum == 0L) {
+        handler.completed(0L, attachment)
+        return
+      }
+      // NOTE: Direct buffers are handed to the native layer as-is; any other
+      // buffers are copied into (slices of) a scratch direct buffer first, so
+      // that all of them can be submitted as a single multi-buffer write.
+      val scratchBuffer = when {
+        (heapBufferSizesSum == 0) -> null
+        else -> {
+          var scratchBuffer = this.writeScratchBuffer.getAndSet(null)
+          if ((scratchBuffer == null) ||
+              (scratchBuffer.capacity() < heapBufferSizesSum)) {
+            scratchBuffer = ByteBuffer.allocateDirect(heapBufferSizesSum)
           }
+          scratchBuffer!!
+          scratchBuffer.clear()
+          scratchBuffer
         }
-        val callback = l@{
-          bytesWrittenCount: Int?,
-          error: UvException? ->
-            this.writeLock.unlock()
-            if (error != null) {
-              this.emitErrorOccurredEvent(error)
-              // NOTE: `handler.completed(0, …)` is called on failure rather
-              // than `handler.failed(…)` since the error is being handled via
-              // the event system instead.
-              handler.completed(0, attachment)
-              return@l
+      }
+      val buffers = Array(bufferCount) {
+        index ->
+          val sourceBuffer = sourceBuffers[offset + index]
+          when {
+            sourceBuffer.isDirect() -> sourceBuffer
+            else -> {
+              scratchBuffer!!
+              val sourceBufferDuplicate = sourceBuffer.duplicate()
+              sourceBufferDuplicate.limit(sourceBufferDuplicate.position() + bufferSizes[index])
+              scratchBuffer.put(sourceBufferDuplicate)
+              scratchBuffer
+            }
+          }
+      }
+      var scratchBufferPosition = 0
+      val bufferOffsets = IntArray(bufferCount) {
+        index ->
+          val sourceBuffer = sourceBuffers[offset + index]
+          when {
+            sourceBuffer.isDirect() -> sourceBuffer.position()
+            else -> {
+              val bufferOffset = scratchBufferPosition
+              scratchBufferPosition += bufferSizes[index]
+              bufferOffset
             }
-            bytesWrittenCount!!
-            sourceBuffer.position(sourceBufferPosition + bytesWrittenCount)
-            handler.completed(bytesWrittenCount, attachment)
+          }
+      }
+      val sourceBufferPositions = IntArray(bufferCount) {
+        index ->
+          sourceBuffers[offset + index].position()
+      }
+      val callback = object : IoCompletedCallbackFunction {
+        override fun handle(result: Int, errorNumber: Int) {
+          if (scratchBuffer != null) {
+            this@ConnectionInternal.writeScratchBuffer.set(scratchBuffer)
+          }
+          if (errorNumber != 0) {
+            this@ConnectionInternal.emitErrorOccurredEvent(UvException(errorNumber))
+            // NOTE: `handler.completed(0, …)` is called on failure rather
+            // than `handler.failed(…)` since the error is being handled via
+            // the event system instead.
+            handler.completed(0L, attachment)
+            return
+          }
+          val bytesWrittenCount = result
+          var remainingBytesWrittenCount = bytesWrittenCount
+          for (index in 0 until bufferCount) {
+            val bufferBytesWrittenCount = minOf(remainingBytesWrittenCount, bufferSizes[index])
+            val sourceBuffer = sourceBuffers[offset + index]
+            sourceBuffer.position(sourceBufferPositions[index] + bufferBytesWrittenCount)
+            remainingBytesWrittenCount -= bufferBytesWrittenCount
+          }
+          handler.completed(bytesWrittenCount.toLong(), attachment)
         }
-        val callbackClass = callback::class.java
-        try {
-          this.uvTcpWrite(this.nativeObject, buffer, bufferSize, callback, callbackClass)
-        } catch (exception: UvException) {
-          this.emitErrorOccurredEvent(exception)
-          return
+      }
+      var isQueued = false
+      try {
+        this.queueWrite(buffers, callback) {
+          operationId, _ ->
+            this.uvTcpWriteGathered(this.nativeObject, buffers, bufferOffsets, bufferSizes, bufferCount, operationId)
         }
-        keepWriteLockLocked = true
+        isQueued = true
+      } catch (exception: UvException) {
+        this.emitErrorOccurredEvent(exception)
       } finally {
-        if (! keepWriteLockLocked) {
-          this.writeLock.unlock()
+        if ((! isQueued) &&
+            (scratchBuffer != null)) {
+          this.writeScratchBuffer.set(scratchBuffer)
         }
       }
     }
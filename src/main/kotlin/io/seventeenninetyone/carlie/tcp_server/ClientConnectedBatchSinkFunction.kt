@@ -0,0 +1,36 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+/**
+ * The interface for the function through which the native layer hands over
+ * the connections that a loop accepted during one of its iterations, in a
+ * single call.
+ *
+ * @author Jay B.
+ */
+internal interface ClientConnectedBatchSinkFunction {
+  /**
+   * Called with the connections that were accepted, in the order they were
+   * accepted.
+   *
+   * @see [ClientConnectedEventHandlerFunction.handle]
+   */
+  fun handleClientsConnectedBatch(connections: Array<Any?>, count: Int)
+}
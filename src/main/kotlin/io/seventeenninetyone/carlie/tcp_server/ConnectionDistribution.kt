@@ -0,0 +1,43 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+/**
+ * How a server that runs more than one event loop spreads incoming connections
+ * across its loops.
+ *
+ * @author Jay B.
+ * @see [io.seventeenninetyone.carlie.TcpServer]
+ */
+enum class ConnectionDistribution {
+  /**
+   * Every loop has a listener of its own, all of them bound to the same
+   * address with `SO_REUSEPORT`, and the kernel decides which loop gets which
+   * connection.
+   */
+  REUSE_PORT,
+
+  /**
+   * Only the first loop has a listener; it accepts all the connections and
+   * hands them out to all the loops (itself included) in turn. This gives an
+   * even distribution where `SO_REUSEPORT` balancing is skewed, and keeps a
+   * single listening socket.
+   */
+  ACCEPTOR_HANDOFF,
+}
@@ -0,0 +1,44 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+import java.nio.ByteBuffer
+
+/**
+ * The functional interface for a function used as an event handler for data
+ * received on a connection that is streaming reads.
+ *
+ * __Note:__ The buffer is a read-only view of native memory that is only valid
+ * until the handler returns (it’s then reused for data received later on); its
+ * contents have to be consumed (or copied) before then. An exception thrown by
+ * the handler is reported as an error of the connection.
+ *
+ * @author Jay B.
+ * @see [io.seventeenninetyone.carlie.TcpServer.Connection.startReading]
+ */
+@FunctionalInterface
+interface DataReceivedEventHandlerFunction {
+  fun handle(data: ByteBuffer)
+
+  @JvmSynthetic
+  @JvmDefault
+  operator fun invoke(data: ByteBuffer) {
+    return this.handle(data)
+  }
+}
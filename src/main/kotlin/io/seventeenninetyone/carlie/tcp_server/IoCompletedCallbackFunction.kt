@@ -0,0 +1,46 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+/**
+ * The functional interface for a function called when a read or a write has
+ * completed.
+ *
+ * It only takes primitive arguments, so that reporting a completed operation
+ * doesn’t allocate anything on the heap.
+ *
+ * @see [IoCompletionSinkFunction]
+ *
+ * @author Jay B.
+ */
+@FunctionalInterface
+internal interface IoCompletedCallbackFunction {
+  /**
+   * @param result The number of bytes read or written; when reading, `-1` if
+   *   the end-of-stream has been reached.
+   * @param errorNumber The libuv error code if the operation failed, `0`
+   *   otherwise.
+   */
+  fun handle(result: Int, errorNumber: Int)
+
+  @JvmSynthetic
+  @JvmDefault
+  operator fun invoke(result: Int, errorNumber: Int) {
+    return this.handle(result, errorNumber)
+  }
+}
@@ -0,0 +1,37 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+/**
+ * The interface for the function through which the native layer reports all
+ * the reads and writes that a loop completed during one of its iterations, in
+ * a single call.
+ *
+ * @author Jay B.
+ */
+internal interface IoCompletionBatchSinkFunction {
+  /**
+   * Called with the sinks of the connections whose operations completed, and
+   * with each completion’s operation ID, result and error number, three by
+   * three, in the same order.
+   *
+   * @see [IoCompletionSinkFunction.handleIoCompleted]
+   */
+  fun handleIoCompletedBatch(sinks: Array<Any?>, values: IntArray, count: Int)
+}
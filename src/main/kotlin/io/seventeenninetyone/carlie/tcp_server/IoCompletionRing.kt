@@ -0,0 +1,109 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+import io.seventeenninetyone.carlie.utilities.UnsafeMemory
+import java.nio.ByteBuffer
+
+/**
+ * The JVM side of a loop’s completion ring, into which the loop puts the
+ * completions of the operations it ran (and the closed events of its
+ * connections, which follow their completions), and out of which a single
+ * thread takes them.
+ *
+ * @author Jay B.
+ */
+internal class IoCompletionRing(memory: ByteBuffer) : IoRing(memory) {
+  companion object {
+    /**
+     * The operation ID a connection’s closed event is reported with.
+     */
+    const val CLOSED_OPERATION_ID = -1
+    private const val CONNECTION_ADDRESS_OFFSET = 0L
+    private const val ERROR_NUMBER_OFFSET = 16L
+    private const val OPERATION_ID_OFFSET = 8L
+    private const val RESULT_OFFSET = 12L
+  }
+
+  /**
+   * Check whether the loop holds completions that didn’t fit into the ring,
+   * in which case it has to be woken up once there’s room for them.
+   */
+  val hasOverflowed: Boolean
+    get() {
+      return (UnsafeMemory.UNSAFE.getIntVolatile(null, this.address + IoRing.HAS_OVERFLOWED_OFFSET) != 0)
+    }
+
+  private val isEmpty: Boolean
+    get() {
+      val unsafe = UnsafeMemory.UNSAFE
+      return (unsafe.getIntVolatile(null, this.address + IoRing.TAIL_OFFSET) == unsafe.getInt(this.address + IoRing.HEAD_OFFSET))
+    }
+
+  /**
+   * Take all the completions that are in the ring, and hand each of them over
+   * to `handler`, in order; returns how many there were.
+   *
+   * __Note:__ Only ever called from the ring’s consumer thread.
+   */
+  fun drain(handler: (connectionAddress: Long, operationId: Int, result: Int, errorNumber: Int) -> Unit): Int {
+    val unsafe = UnsafeMemory.UNSAFE
+    val headAddress = this.address + IoRing.HEAD_OFFSET
+    val tail = unsafe.getIntVolatile(null, this.address + IoRing.TAIL_OFFSET)
+    var head = unsafe.getInt(headAddress)
+    var count = 0
+    while (head != tail) {
+      val entryAddress = this.getEntryAddress(head)
+      val connectionAddress = unsafe.getLong(entryAddress + IoCompletionRing.CONNECTION_ADDRESS_OFFSET)
+      val operationId = unsafe.getInt(entryAddress + IoCompletionRing.OPERATION_ID_OFFSET)
+      val result = unsafe.getInt(entryAddress + IoCompletionRing.RESULT_OFFSET)
+      val errorNumber = unsafe.getInt(entryAddress + IoCompletionRing.ERROR_NUMBER_OFFSET)
+      head += 1
+      // NOTE: The entry goes back to the loop before it gets handled, since
+      // handling it may take a while.
+      unsafe.putOrderedInt(null, headAddress, head)
+      handler(connectionAddress, operationId, result, errorNumber)
+      count += 1
+    }
+    return count
+  }
+
+  /**
+   * Let the loop know that the consumer is done waiting.
+   */
+  fun finishParking() {
+    UnsafeMemory.UNSAFE.putIntVolatile(null, this.address + IoRing.NEEDS_WAKE_UP_OFFSET, 0)
+  }
+
+  /**
+   * Let the loop know that the consumer is about to park, so that it wakes
+   * the consumer up for its next completion; returns `false` (in which case
+   * the consumer mustn’t park) when anything came in in the meantime.
+   */
+  fun prepareToPark(): Boolean {
+    val unsafe = UnsafeMemory.UNSAFE
+    unsafe.putIntVolatile(null, this.address + IoRing.NEEDS_WAKE_UP_OFFSET, 1)
+    unsafe.fullFence()
+    if (this.isEmpty && (! this.hasOverflowed)) {
+      return true
+    }
+    this.finishParking()
+    return false
+  }
+}
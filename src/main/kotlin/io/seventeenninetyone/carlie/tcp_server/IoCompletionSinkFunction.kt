@@ -0,0 +1,40 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+import java.nio.ByteBuffer
+
+/**
+ * The interface for the functions through which the native layer reports a
+ * connection’s reads and writes. A connection registers its sink once, and
+ * each operation is then identified by the operation ID it was started with.
+ *
+ * @author Jay B.
+ */
+internal interface IoCompletionSinkFunction {
+  /**
+   * Called for each chunk of data read while a streaming read is active.
+   */
+  fun handleDataRead(operationId: Int, data: ByteBuffer)
+
+  /**
+   * @see [IoCompletedCallbackFunction.handle]
+   */
+  fun handleIoCompleted(operationId: Int, result: Int, errorNumber: Int)
+}
@@ -0,0 +1,59 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+import io.seventeenninetyone.carlie.utilities.UnsafeMemory
+import java.nio.ByteBuffer
+
+/**
+ * The JVM side of one of a loop’s I/O rings: a header (the producers’ and the
+ * consumer’s indices, each on a cache line of its own, and a couple of flags),
+ * followed by a fixed number of fixed-size entries, all in memory that the
+ * native layer allocates and shares through a direct buffer.
+ *
+ * __Note:__ The layout has to match the one in `tcp-server/io-ring.h`.
+ *
+ * @author Jay B.
+ */
+internal abstract class IoRing(memory: ByteBuffer) {
+  companion object {
+    const val CAPACITY = 1024
+    const val ENTRY_SIZE = 32
+    const val HAS_OVERFLOWED_OFFSET = 72L
+    const val HEADER_SIZE = 128
+    const val HEAD_OFFSET = 64L
+    const val NEEDS_WAKE_UP_OFFSET = 68L
+    const val TAIL_OFFSET = 0L
+  }
+
+  protected val address: Long
+
+  // NOTE: The buffer doesn’t own the memory (the server does, until it
+  // closes), but it’s kept around along with the ring anyway.
+  private val memory: ByteBuffer
+
+  init {
+    this.address = UnsafeMemory.getDirectBufferAddress(memory)
+    this.memory = memory
+  }
+
+  protected fun getEntryAddress(index: Int): Long {
+    return this.address + IoRing.HEADER_SIZE + ((index and (IoRing.CAPACITY - 1)).toLong() * IoRing.ENTRY_SIZE)
+  }
+}
@@ -0,0 +1,98 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+import io.seventeenninetyone.carlie.utilities.UnsafeMemory
+import java.nio.ByteBuffer
+
+/**
+ * The JVM side of a loop’s submission ring, into which any number of threads
+ * can put reads, writes and closes at once, without calling into the native
+ * layer; the loop takes them out whenever it gets around to it.
+ *
+ * Every entry carries a sequence number: a producer claims an entry by moving
+ * the tail past it, fills it in, and only then publishes it by bumping its
+ * sequence number; the loop hands the entry back to the producers by moving
+ * its sequence number one lap ahead.
+ *
+ * @author Jay B.
+ */
+internal class IoSubmissionRing(memory: ByteBuffer) : IoRing(memory) {
+  companion object {
+    const val OPCODE_CLOSE = 3
+    const val OPCODE_READ = 1
+    const val OPCODE_WRITE = 2
+    private const val BUFFER_ADDRESS_OFFSET = 8L
+    private const val BUFFER_SIZE_OFFSET = 16L
+    private const val CONNECTION_ADDRESS_OFFSET = 0L
+    private const val OPCODE_OFFSET = 20L
+    private const val OPERATION_ID_OFFSET = 24L
+    private const val SEQUENCE_OFFSET = 28L
+  }
+
+  /**
+   * Check whether the loop may be blocked, in which case it has to be woken up
+   * for whatever was just submitted.
+   *
+   * __Note:__ Only meaningful right after a submission; the fence pairs with
+   * the one the loop goes through before it blocks, so that either the loop
+   * sees the submission, or this sees that the loop is about to block.
+   */
+  val needsWakeUp: Boolean
+    get() {
+      val unsafe = UnsafeMemory.UNSAFE
+      unsafe.fullFence()
+      return (unsafe.getIntVolatile(null, this.address + IoRing.NEEDS_WAKE_UP_OFFSET) != 0)
+    }
+
+  /**
+   * Submit an operation; returns `false` (without submitting anything) when
+   * the ring is full.
+   */
+  fun offer(connectionAddress: Long,
+            bufferAddress: Long,
+            bufferSize: Int,
+            opcode: Int,
+            operationId: Int): Boolean {
+    val unsafe = UnsafeMemory.UNSAFE
+    val tailAddress = this.address + IoRing.TAIL_OFFSET
+    while (true) {
+      val tail = unsafe.getIntVolatile(null, tailAddress)
+      val entryAddress = this.getEntryAddress(tail)
+      val sequence = unsafe.getIntVolatile(null, entryAddress + IoSubmissionRing.SEQUENCE_OFFSET)
+      val difference = sequence - tail
+      if (difference < 0) {
+        // NOTE: The entry still holds a submission from the previous lap.
+        return false
+      }
+      if (difference > 0) {
+        // NOTE: Another producer got to the entry first.
+        continue
+      }
+      if (! unsafe.compareAndSwapInt(null, tailAddress, tail, tail + 1)) continue
+      unsafe.putLong(entryAddress + IoSubmissionRing.CONNECTION_ADDRESS_OFFSET, connectionAddress)
+      unsafe.putLong(entryAddress + IoSubmissionRing.BUFFER_ADDRESS_OFFSET, bufferAddress)
+      unsafe.putInt(entryAddress + IoSubmissionRing.BUFFER_SIZE_OFFSET, bufferSize)
+      unsafe.putInt(entryAddress + IoSubmissionRing.OPCODE_OFFSET, opcode)
+      unsafe.putInt(entryAddress + IoSubmissionRing.OPERATION_ID_OFFSET, operationId)
+      unsafe.putOrderedInt(null, entryAddress + IoSubmissionRing.SEQUENCE_OFFSET, tail + 1)
+      return true
+    }
+  }
+}
@@ -0,0 +1,85 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+/**
+ * A socket option that can be set on a connection, or as a server’s default
+ * for the connections it accepts. Every option takes an `Int` value; options
+ * that are either on or off are on for any value but `0`.
+ *
+ * __Note:__ Options that a platform doesn’t have fail with a
+ * [io.seventeenninetyone.carlie.tcp_server.UvException] when set.
+ *
+ * @author Jay B.
+ * @see [io.seventeenninetyone.carlie.TcpServer.setDefaultSocketOption]
+ * @see [io.seventeenninetyone.carlie.TcpServer.Connection.setSocketOption]
+ */
+enum class SocketOption(internal val id: Int) {
+  /**
+   * `TCP_NODELAY`: whether Nagle’s algorithm is disabled; on by default.
+   */
+  NO_DELAY(0),
+
+  /**
+   * `SO_RCVBUF`: the size (in bytes) of the receive buffer; *must* be
+   * positive.
+   */
+  RECEIVE_BUFFER_SIZE(1),
+
+  /**
+   * `SO_SNDBUF`: the size (in bytes) of the send buffer; *must* be positive.
+   */
+  SEND_BUFFER_SIZE(2),
+
+  /**
+   * `TCP_QUICKACK` (Linux only): whether acknowledgements are sent right away,
+   * rather than delayed. The kernel may turn it back off on its own, so it
+   * only holds until then.
+   */
+  QUICK_ACK(3),
+
+  /**
+   * `TCP_USER_TIMEOUT` (Linux only): how long (in milliseconds) sent data may
+   * stay unacknowledged before the connection is dropped; `0` leaves it up to
+   * the system. *Must not* be negative.
+   */
+  USER_TIMEOUT(4),
+
+  /**
+   * `SO_LINGER`: how long (in seconds) closing the connection may wait for
+   * unsent data to be sent; a negative value turns lingering off.
+   */
+  LINGER(5),
+
+  /**
+   * `TCP_NOTSENT_LOWAT`: how many unsent bytes the connection may hold before
+   * it stops being writable. *Must not* be negative.
+   */
+  NOT_SENT_LOW_WATERMARK(6);
+
+  internal fun isValidValue(value: Int): Boolean {
+    return when (this) {
+      RECEIVE_BUFFER_SIZE,
+      SEND_BUFFER_SIZE -> (value > 0)
+      NOT_SENT_LOW_WATERMARK,
+      USER_TIMEOUT -> (value >= 0)
+      else -> true
+    }
+  }
+}
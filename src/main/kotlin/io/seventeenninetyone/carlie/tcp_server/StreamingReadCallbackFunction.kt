@@ -0,0 +1,34 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+import java.nio.ByteBuffer
+
+/**
+ * The interface for the functions called while a streaming read is active:
+ * once per chunk of data read, and once when the streaming read has completed.
+ *
+ * When it has completed, the result is `0` if reading has been stopped, and
+ * `-1` if the end-of-stream has been reached.
+ *
+ * @author Jay B.
+ */
+internal interface StreamingReadCallbackFunction : IoCompletedCallbackFunction {
+  fun handleData(data: ByteBuffer)
+}
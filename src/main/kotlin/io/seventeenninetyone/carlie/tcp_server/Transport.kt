@@ -0,0 +1,43 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.tcp_server
+
+/**
+ * What a server’s event loops do their sockets’ I/O (accepts, reads and
+ * writes) through.
+ *
+ * @author Jay B.
+ * @see [io.seventeenninetyone.carlie.TcpServer]
+ */
+enum class Transport {
+  /**
+   * libuv’s readiness-based I/O (e.g., `epoll` on Linux); available
+   * everywhere.
+   */
+  LIBUV,
+
+  /**
+   * Linux’s io_uring: each loop accepts connections with a multishot accept,
+   * streams reads with multishot receives into a ring of buffers shared with
+   * the kernel, and submits all the operations it queued during an iteration
+   * with a single system call. Needs Linux 6.0 (or newer); a server asked to
+   * use it falls back to [LIBUV] wherever it isn’t supported.
+   */
+  IO_URING,
+}
@@ -27,11 +27,11 @@ class OperatingSystem {
 
     @JvmStatic
     val pageSize by lazy getPageSize@ {
-      if (this.unsafeClass == null) {
+      if (this.unsafe == null) {
         return@getPageSize 0u
       }
       // http://www.docjar.com/docs/api/sun/misc/Unsafe.html#pageSize
-      var size = this.unsafeClass!!.pageSize()
+      var size = this.unsafe!!.pageSize()
       // Is this actually possible? Does the `pageSize` method provide any sign
       // guarantees?
       // NOTE: Just being safe since we are dealing with signed integers here
@@ -42,27 +42,29 @@ class OperatingSystem {
       size.toUInt()
     }
 
-    private val unsafeClass by lazy getUnsafeClass@ {
+    // NOTE: The one place `sun.misc.Unsafe` gets looked up; it’s `null` when it
+    // can’t be got hold of (see `UnsafeMemory`, which depends on it as well).
+    internal val unsafe by lazy getUnsafe@ {
       val unsafeClassTheUnsafeField: Field
       try {
         unsafeClassTheUnsafeField = this.UNSAFE_CLASS_CLASS.getDeclaredField("theUnsafe")
       } catch (exception: NoSuchFieldException) {
-        return@getUnsafeClass null
+        return@getUnsafe null
       } catch (exception: SecurityException) {
-        return@getUnsafeClass null
+        return@getUnsafe null
       }
       try {
         unsafeClassTheUnsafeField.isAccessible = true
       } catch (exception: SecurityException) {
-        return@getUnsafeClass null
+        return@getUnsafe null
       }
-      val unsafeClass: Unsafe
+      val unsafe: Unsafe
       try {
-        unsafeClass = unsafeClassTheUnsafeField.get(null) as Unsafe
+        unsafe = unsafeClassTheUnsafeField.get(null) as Unsafe
       } catch (exception: IllegalAccessException) {
-        return@getUnsafeClass null
+        return@getUnsafe null
       }
-      unsafeClass
+      unsafe
     }
 
     @JvmStatic
@@ -21,9 +21,10 @@ package io.seventeenninetyone.carlie.utilities
 import java.util.concurrent.atomic.AtomicBoolean
 
 class SimpleAtomicLock {
-  val isLocked by lazy {
-    this.value.get()
-  }
+  val isLocked: Boolean
+    get() {
+      return this.value.get()
+    }
 
   private val value by lazy {
     AtomicBoolean(false)
@@ -0,0 +1,81 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie.utilities
+
+import java.lang.reflect.Field
+import java.nio.Buffer
+import java.nio.ByteBuffer
+import sun.misc.Unsafe
+
+/**
+ * This class is for accessing memory that the native layer shares with the JVM
+ * side as-is; *e.g.*, the I/O rings of a server’s loops, which need atomic and
+ * ordered accesses that byte buffers don’t offer (as of Java 8).
+ *
+ * __Note:__ It relies on `sun.misc.Unsafe` (as looked up by
+ * [io.seventeenninetyone.carlie.utilities.OperatingSystem]), and on the
+ * address field of buffers; where either can’t be got hold of, it isn’t
+ * available, and [io.seventeenninetyone.carlie.utilities.UnsafeMemory.UNSAFE]
+ * throws.
+ *
+ * @author Jay B.
+ */
+internal class UnsafeMemory {
+  companion object {
+    private val BUFFER_ADDRESS_FIELD_OFFSET: Long
+
+    /**
+     * Check if memory can be accessed this way.
+     */
+    val isAvailable: Boolean
+
+    private val unsafe: Unsafe?
+
+    val UNSAFE: Unsafe
+      get() {
+        return this.unsafe ?: throw UnsupportedOperationException("sun.misc.Unsafe isn’t available.")
+      }
+
+    init {
+      var unsafe = OperatingSystem.unsafe
+      var bufferAddressFieldOffset = -1L
+      if (unsafe != null) {
+        try {
+          val addressField: Field = Buffer::class.java.getDeclaredField("address")
+          bufferAddressFieldOffset = unsafe.objectFieldOffset(addressField)
+        } catch (exception: NoSuchFieldException) {
+          unsafe = null
+        } catch (exception: SecurityException) {
+          unsafe = null
+        }
+      }
+      this.BUFFER_ADDRESS_FIELD_OFFSET = bufferAddressFieldOffset
+      this.isAvailable = (unsafe != null)
+      this.unsafe = unsafe
+    }
+
+    /**
+     * Get the address of a direct buffer’s memory (*i.e.*, of its first byte,
+     * regardless of its position).
+     */
+    fun getDirectBufferAddress(buffer: ByteBuffer): Long {
+      return this.UNSAFE.getLong(buffer, this.BUFFER_ADDRESS_FIELD_OFFSET)
+    }
+  }
+}
@@ -74,10 +74,16 @@ typedef jbyte jni_byte_t;
 typedef jbyteArray jni_byte_array_t;
 typedef jclass jni_class_t;
 typedef JNIEnv * jni_environment_handle_t;
+typedef jfieldID jni_field_id_t;
 typedef jint jni_int_t;
+typedef jintArray jni_int_array_t;
 typedef JavaVM jni_java_vm_t;
+typedef jlong jni_long_t;
+typedef jlongArray jni_long_array_t;
 typedef jmethodID jni_method_id_t;
 typedef jobject jni_object_t;
+typedef jobjectArray jni_object_array_t;
+typedef jsize jni_size_t;
 typedef jstring jni_string_t;
 typedef jthrowable jni_throwable_t;
 
@@ -100,6 +106,14 @@ carlie_get_array_bytes(jni_environment_handle_t const environment,
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline carlie_result_t
+carlie_get_direct_buffer_bytes(jni_environment_handle_t const environment,
+                               jni_object_t const buffer_object,
+                               size_t const buffer_offset,
+                               uint8_t **const bytes_ptr);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_result_t
 carlie_get_native_object(jni_environment_handle_t const environment,
                          jni_object_t const native_object_bytes,
@@ -163,6 +177,20 @@ carlie_get_array_bytes(jni_environment_handle_t const environment,
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline carlie_result_t
+carlie_get_direct_buffer_bytes(jni_environment_handle_t const environment,
+                               jni_object_t const buffer_object,
+                               size_t const buffer_offset,
+                               uint8_t **const bytes_ptr)
+{
+  uint8_t *const bytes = (uint8_t *) environment[0]->GetDirectBufferAddress(environment, buffer_object);
+  assert(bytes != null_ptr);
+  bytes_ptr[0] = &bytes[buffer_offset];
+  return CARLIE_RESULT_SUCCESS;
+}
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_result_t
 carlie_get_native_object(jni_environment_handle_t const environment,
                          jni_object_t const native_object_bytes,
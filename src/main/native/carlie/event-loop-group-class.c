@@ -0,0 +1,162 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+
+
+#include <carlie/event-loop-group-class.h>
+
+
+
+void
+carlie_event_loop_group_handle_async_uv_loop_stop(carlie_tcp_server_command_t * command,
+                                                  uv_loop_t * loop_handle)
+{
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_event_loop_group_loop_t *const loop = (carlie_event_loop_group_loop_t *) uv_loop_get_data(loop_handle);
+  assert(loop != null_ptr);
+  // NOTE: Only the command queue’s handle gets closed here; the loop keeps
+  // running for as long as any server loops are still attached to it, and
+  // stops once the last one of them has closed.
+  int32_t const uv_result = (int32_t) uv_is_closing((uv_handle_t *) loop->command_queue_async_handle);
+  assert(uv_result == 0);
+  uv_close((uv_handle_t *) loop->command_queue_async_handle, null_ptr);
+}
+
+
+
+void
+carlie_event_loop_group_handle_command_queue_async(uv_async_t * handle)
+{
+  assert(handle != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_event_loop_group_loop_t *const loop = (carlie_event_loop_group_loop_t *) uv_handle_get_data((uv_handle_t *) handle);
+  assert(loop != null_ptr);
+  carlie_tcp_server_command_t * command = carlie_tcp_server_command_queue_take_all(&loop->command_queue);
+  while (command != null_ptr) {
+    // NOTE: The handler may free the command, so the next one has to be looked
+    // up beforehand.
+    carlie_tcp_server_command_t *const next_command = command->next_command;
+    command->handler(command, loop_handle);
+    command = next_command;
+  }
+}
+
+
+
+JNI_DEFINE_METHOD(jni_int_t, getNativeObjectSize)(jni_environment_handle_t environment,
+                                                  jni_class_t group_class)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(environment);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(group_class);
+  size_t const size = sizeof(carlie_event_loop_group_native_object_t);
+  assert(((uintmax_t) size) <= ((uintmax_t) INT32_MAX));
+  return (jni_int_t) (int32_t) size;
+}
+
+
+
+JNI_DEFINE_METHOD(jni_boolean_t, initializeNative)(jni_environment_handle_t environment,
+                                                   jni_object_t group_object,
+                                                   jni_object_t native_object_bytes,
+                                                   jni_int_t loops_count)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(group_object);
+  assert(((int32_t) loops_count) > 0);
+  carlie_event_loop_group_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  carlie_event_loop_group_loop_t *const loops = calloc((size_t) loops_count, sizeof(carlie_event_loop_group_loop_t));
+  if (loops == null_ptr) {
+    return (jni_boolean_t) false;
+  }
+  size_t loops_initialized_count = 0u;
+  while ((loops_initialized_count < ((size_t) loops_count)) &&
+         carlie_event_loop_group_initialize_loop(&loops[loops_initialized_count])) {
+    loops_initialized_count += 1u;
+  }
+  if (loops_initialized_count != ((size_t) loops_count)) {
+    for (size_t i = 0u; i < loops_initialized_count; i++) {
+      carlie_event_loop_group_destroy_loop(&loops[i]);
+    }
+    free(loops);
+    return (jni_boolean_t) false;
+  }
+  native_object->loops = loops;
+  native_object->loops_count = (size_t) loops_count;
+  native_object->next_loop_index = 0u;
+  return (jni_boolean_t) true;
+}
+
+
+
+JNI_DEFINE_METHOD(void, closeNative)(jni_environment_handle_t environment,
+                                     jni_object_t group_object,
+                                     jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(group_object);
+  carlie_event_loop_group_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  // NOTE: By now, the loops have stopped running (and have torn themselves
+  // down in `uvRun(…)`), so they can go.
+  free(native_object->loops);
+  // Zero out the native object by setting it to an empty one.
+  native_object[0] = empty_carlie_event_loop_group_native_object;
+}
+
+
+
+JNI_DEFINE_METHOD(void, stopUvLoops)(jni_environment_handle_t environment,
+                                     jni_object_t group_object,
+                                     jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(group_object);
+  carlie_event_loop_group_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_event_loop_group_loop_t *const loop = &native_object->loops[i];
+    carlie_event_loop_group_post_command(loop, &loop->stop_command, carlie_event_loop_group_handle_async_uv_loop_stop);
+  }
+}
+
+
+
+JNI_DEFINE_METHOD(void, uvRun)(jni_environment_handle_t environment,
+                               jni_object_t group_object,
+                               jni_object_t native_object_bytes,
+                               jni_int_t loop_index)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(group_object);
+  carlie_event_loop_group_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) loop_index) >= 0) &&
+         (((size_t) loop_index) < native_object->loops_count));
+  carlie_event_loop_group_loop_t *const loop = &native_object->loops[(size_t) loop_index];
+  // NOTE: It’s perfectly fine to save this environment in the loop, because
+  // the loop runs in a single thread (the current thread); the server loops
+  // attached to it borrow it as well.
+  loop->environment = environment;
+  uv_loop_t *const loop_handle = loop->loop_handle;
+  uv_loop_set_data(loop_handle, (void *) loop);
+  int32_t uv_result;
+  uv_result = (int32_t) uv_run(loop_handle, UV_RUN_DEFAULT);
+  assert(uv_result == 0);
+  uv_loop_set_data(loop_handle, null_ptr);
+  uv_result = (int32_t) uv_loop_close(loop_handle);
+  assert(uv_result != UV_EBUSY);
+}
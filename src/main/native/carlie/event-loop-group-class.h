@@ -0,0 +1,176 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+
+
+#ifndef IO_SEVENTEENNINETYONE_CARLIE_EVENT_LOOP_GROUP_CLASS_H
+#define IO_SEVENTEENNINETYONE_CARLIE_EVENT_LOOP_GROUP_CLASS_H 1
+
+
+
+#include <carlie/common.h>
+#include <carlie/event-loop-group/native-object.h>
+#include <carlie/tcp-server/command-queue.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <uv.h>
+
+
+
+/*
+ *******************************************************************************
+ * JVM and JNI-related macros.                                                 *
+ *******************************************************************************
+ */
+#define JVM_PACKAGE_SIGNATURE JVM_ROOT_PACKAGE_SIGNATURE
+#define JVM_CLASS_NAME EventLoopGroup
+#define JNI_DEFINE_METHOD(return_type, method_signature)                                   \
+  JNI_DEFINE_METHOD0(return_type, JVM_PACKAGE_SIGNATURE, JVM_CLASS_NAME, method_signature)
+
+
+
+static carlie_event_loop_group_native_object_t const empty_carlie_event_loop_group_native_object;
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_event_loop_group_destroy_loop(carlie_event_loop_group_loop_t *const loop);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_event_loop_group_initialize_loop(carlie_event_loop_group_loop_t *const loop);
+
+
+
+void
+carlie_event_loop_group_handle_async_uv_loop_stop(carlie_tcp_server_command_t * command,
+                                                  uv_loop_t * loop_handle);
+
+
+
+void
+carlie_event_loop_group_handle_command_queue_async(uv_async_t * handle);
+
+
+
+// NOTE: Only meant for loops that never got to run (i.e., when the group fails
+// to initialize); a running loop tears itself down in `uvRun(…)`.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_event_loop_group_destroy_loop(carlie_event_loop_group_loop_t *const loop)
+{
+  uv_close((uv_handle_t *) loop->command_queue_async_handle, null_ptr);
+  // NOTE: The loop has to run once for the close to complete.
+  uv_run(loop->loop_handle, UV_RUN_NOWAIT);
+  int32_t const uv_result = (int32_t) uv_loop_close(loop->loop_handle);
+  assert(uv_result != UV_EBUSY);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_event_loop_group_initialize_loop(carlie_event_loop_group_loop_t *const loop)
+{
+  int32_t uv_result;
+  loop->loop_handle = &loop->loop_handle_;
+  uv_result = (int32_t) uv_loop_init(loop->loop_handle);
+  if (uv_result < 0) {
+    return false;
+  }
+  carlie_tcp_server_command_queue_initialize(&loop->command_queue);
+  loop->command_queue_async_handle = &loop->command_queue_async_handle_;
+  uv_result = (int32_t) uv_async_init(loop->loop_handle, loop->command_queue_async_handle, carlie_event_loop_group_handle_command_queue_async);
+  if (uv_result < 0) {
+    uv_loop_close(loop->loop_handle);
+    return false;
+  }
+  uv_handle_set_data((uv_handle_t *) loop->command_queue_async_handle, (void *) loop);
+  return true;
+}
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_EventLoopGroup                      *
+ * Method:    getNativeObjectSize                                              *
+ * Signature: ()I                                                              *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(jni_int_t, getNativeObjectSize)(jni_environment_handle_t environment,
+                                                  jni_class_t group_class);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_EventLoopGroup                      *
+ * Method:    initializeNative                                                 *
+ * Signature: (Ljava/nio/ByteBuffer;I)Z                                        *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(jni_boolean_t, initializeNative)(jni_environment_handle_t environment,
+                                                   jni_object_t group_object,
+                                                   jni_object_t native_object_bytes,
+                                                   jni_int_t loops_count);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_EventLoopGroup                      *
+ * Method:    closeNative                                                      *
+ * Signature: (Ljava/nio/ByteBuffer;)V                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, closeNative)(jni_environment_handle_t environment,
+                                     jni_object_t group_object,
+                                     jni_object_t native_object_bytes);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_EventLoopGroup                      *
+ * Method:    stopUvLoops                                                      *
+ * Signature: (Ljava/nio/ByteBuffer;)V                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, stopUvLoops)(jni_environment_handle_t environment,
+                                     jni_object_t group_object,
+                                     jni_object_t native_object_bytes);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_EventLoopGroup                      *
+ * Method:    uvRun                                                            *
+ * Signature: (Ljava/nio/ByteBuffer;I)V                                        *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, uvRun)(jni_environment_handle_t environment,
+                               jni_object_t group_object,
+                               jni_object_t native_object_bytes,
+                               jni_int_t loop_index);
+
+
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+
+
+#ifndef IO_SEVENTEENNINETYONE_CARLIE_EVENT_LOOP_GROUP_NATIVE_OBJECT_H
+#define IO_SEVENTEENNINETYONE_CARLIE_EVENT_LOOP_GROUP_NATIVE_OBJECT_H 1
+
+
+
+#include <carlie/common.h>
+#include <carlie/tcp-server/command-queue.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <uv.h>
+
+
+
+/*
+ *******************************************************************************
+ * Internal API type definitions.                                              *
+ *******************************************************************************
+ */
+typedef struct _carlie_event_loop_group_loop carlie_event_loop_group_loop_t;
+typedef struct _carlie_event_loop_group_native_object carlie_event_loop_group_native_object_t;
+
+
+
+// NOTE: A group’s loop only ever runs its own command queue’s handle, plus one
+// poll handle per server loop attached to it (see `attachToEventLoopGroup(…)`
+// in the TCP server class); everything else belongs to the servers’ loops.
+struct _carlie_event_loop_group_loop {
+  carlie_tcp_server_command_queue_t command_queue;
+  uv_async_t * command_queue_async_handle;
+  uv_async_t command_queue_async_handle_;
+  jni_environment_handle_t environment;
+  uv_loop_t * loop_handle;
+  uv_loop_t loop_handle_;
+  carlie_tcp_server_command_t stop_command;
+};
+
+
+
+struct _carlie_event_loop_group_native_object {
+  carlie_event_loop_group_loop_t * loops;
+  size_t loops_count;
+  size_t next_loop_index;
+};
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_event_loop_group_post_command(carlie_event_loop_group_loop_t *const loop,
+                                     carlie_tcp_server_command_t *const command,
+                                     carlie_tcp_server_command_handler_t const handler);
+
+
+
+// NOTE: See `carlie_tcp_server_post_command(…)`; this is the same thing, only
+// for a group’s loop.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_event_loop_group_post_command(carlie_event_loop_group_loop_t *const loop,
+                                     carlie_tcp_server_command_t *const command,
+                                     carlie_tcp_server_command_handler_t const handler)
+{
+  command->handler = handler;
+  bool const command_queue_was_empty = carlie_tcp_server_command_queue_push(&loop->command_queue, command);
+  if (! command_queue_was_empty) return;
+  // NOTE: This can’t fail for an initialized handle.
+  int32_t const uv_result = (int32_t) uv_async_send(loop->command_queue_async_handle);
+  assert(uv_result == 0);
+}
+
+
+
+#endif
@@ -23,81 +23,165 @@
 
 
 void
-carlie_tcp_server_handle_async_uv_close(uv_async_t * handle)
+carlie_tcp_server_handle_async_uv_close(carlie_tcp_server_command_t * command,
+                                        uv_loop_t * loop_handle)
 {
-  assert(handle != null_ptr);
-  carlie_tcp_server_async_uv_close_data_t *const data = (carlie_tcp_server_async_uv_close_data_t *) uv_handle_get_data((uv_handle_t *) handle);
-  assert(data != null_ptr);
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  carlie_tcp_server_async_uv_close_data_t *const data = (carlie_tcp_server_async_uv_close_data_t *) (void *) command;
   uv_close_cb const callback = data->callback;
-  uv_handle_t *const handle1 = data->handle;
-  uv_close((uv_handle_t *) handle, carlie_tcp_server_handle_async_uv_close_done);
-  int32_t const uv_result = (int32_t) uv_is_closing(handle1);
+  uv_handle_t *const handle = data->handle;
+  carlie_tcp_server_record_pool_release(&loop_data->server_native_object->async_uv_close_data_pool, data);
+  int32_t const uv_result = (int32_t) uv_is_closing(handle);
   if (uv_result == 0) {
-    uv_close(handle1, callback);
+    // NOTE: A connection’s socket may only go once io_uring and the relays
+    // are done with it.
+    if (callback == carlie_tcp_server_handle_uv_connection_closed) {
+      carlie_tcp_server_connection_native_object_t *const native_object = (carlie_tcp_server_connection_native_object_t *) uv_handle_get_data(handle);
+      __atomic_fetch_or(&native_object->state, CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSING, __ATOMIC_RELEASE);
+      carlie_tcp_server_cancel_io_uring_operations(loop_data->environment, loop_data, native_object);
+      carlie_tcp_server_stop_relays(loop_data->environment, loop_data, native_object);
+    }
+    uv_close(handle, callback);
   }
 }
 
 
 
 void
-carlie_tcp_server_handle_async_uv_close_done(uv_handle_t * handle)
+carlie_tcp_server_handle_async_uv_connection_handoff(carlie_tcp_server_command_t * command,
+                                                     uv_loop_t * loop_handle)
 {
-  assert(handle != null_ptr);
-  carlie_tcp_server_async_uv_close_data_t *const data = (carlie_tcp_server_async_uv_close_data_t *) uv_handle_get_data(handle);
-  assert(data != null_ptr);
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_connection_handoff_data_t *const data = (carlie_tcp_server_connection_handoff_data_t *) (void *) command;
+  int const socket_descriptor = data->socket_descriptor;
   free(data);
-  free(handle);
+  carlie_tcp_server_serve_connection(environment, loop_data, socket_descriptor);
 }
 
 
 
 void
-carlie_tcp_server_handle_async_uv_read(uv_async_t * handle)
+carlie_tcp_server_handle_async_uv_event_loop_group_attach(carlie_tcp_server_command_t * command,
+                                                          uv_loop_t * loop_handle)
 {
-  assert(handle != null_ptr);
-  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_event_loop_group_attachment_t *const attachment = (carlie_tcp_server_event_loop_group_attachment_t *) (void *) command;
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = attachment->loop_data;
+  assert(loop_data != null_ptr);
+  // NOTE: From now on, the server’s loop only ever runs on the group loop’s
+  // thread, so it borrows that thread’s environment.
+  loop_data->environment = attachment->group_loop->environment;
+  assert(loop_data->environment != null_ptr);
+  uv_loop_set_data(loop_data->loop_handle, (void *) loop_data);
+  attachment->poll_handle = &attachment->poll_handle_;
+  int32_t uv_result;
+  uv_result = (int32_t) uv_poll_init(loop_handle, attachment->poll_handle, uv_backend_fd(loop_data->loop_handle));
+  if (uv_result < 0) {
+    carlie_tcp_server_emit_uv_error_event(loop_data->environment, loop_data->server_native_object, uv_result);
+    return;
+  }
+  uv_handle_set_data((uv_handle_t *) attachment->poll_handle, (void *) attachment);
+  uv_result = (int32_t) uv_poll_start(attachment->poll_handle, UV_READABLE, carlie_tcp_server_handle_uv_event_loop_group_attachment_polled);
+  if (uv_result < 0) {
+    uv_close((uv_handle_t *) attachment->poll_handle, null_ptr);
+    carlie_tcp_server_emit_uv_error_event(loop_data->environment, loop_data->server_native_object, uv_result);
+    return;
+  }
+  // NOTE: libuv only registers a loop’s handles with its backend when the loop
+  // runs, so the server’s loop has to run once before its backend can report
+  // anything.
+  carlie_tcp_server_run_attached_loop(attachment);
+}
+
+
+
+void
+carlie_tcp_server_handle_async_io_uring_accept(carlie_tcp_server_command_t * command,
+                                               uv_loop_t * loop_handle)
+{
+  assert(command != null_ptr);
   assert(loop_handle != null_ptr);
   carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
   assert(loop_data != null_ptr);
   jni_environment_handle_t const environment = loop_data->environment;
   assert(environment != null_ptr);
-  carlie_tcp_server_async_uv_read_data_t *const data = (carlie_tcp_server_async_uv_read_data_t *) uv_handle_get_data((uv_handle_t *) handle);
-  assert(data != null_ptr);
+  int32_t const uv_result = (int32_t) uv_is_closing((uv_handle_t *) loop_data->tcp_handle);
+  if (uv_result != 0) return;
+  if (carlie_tcp_server_submit_io_uring_accept(loop_data)) return;
+  int32_t const jni_result = (int32_t) environment[0]->PushLocalFrame(environment, (jni_int_t) 5);
+  // There’s no point in doing anything extra here.
+  if (jni_result != 0) return;
+  carlie_tcp_server_emit_uv_error_event(environment, loop_data->server_native_object, (int32_t) UV_ENOBUFS);
+  environment[0]->PopLocalFrame(environment, null_ptr);
+}
+
+
+
+void
+carlie_tcp_server_handle_async_uv_read(carlie_tcp_server_command_t * command,
+                                       uv_loop_t * loop_handle)
+{
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_async_uv_read_data_t *const data = (carlie_tcp_server_async_uv_read_data_t *) (void *) command;
   carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
   int32_t uv_result;
   // TODO: Is this check actually necessary? Just being careful, but
   // `uv_read_start(…)` probably already handles this case and returns an
   // appropriate error. Look into this.
   uv_result = (int32_t) uv_is_closing((uv_handle_t *) native_object->tcp_handle);
-  if (uv_result != 0) {
-    jni_object_t const bytes_read_count_object = environment[0]->NewObject(environment, native_object->server_native_object->integer_class, native_object->server_native_object->integer_constructor_method_id, (jni_int_t) 0);
-    if (bytes_read_count_object != null_ptr) {
-      environment[0]->CallObjectMethod(environment, data->callback_function_object, data->callback_function_invoke_method_id, bytes_read_count_object, null_ptr);
-    } else {
-      carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    }
-    environment[0]->DeleteGlobalRef(environment, data->callback_function_object);
-    carlie_release_array_bytes(environment, data->buffer, data->buffer_array, (int32_t) JNI_ABORT);
-    environment[0]->DeleteGlobalRef(environment, (jni_object_t) data->buffer_array);
-    uv_close((uv_handle_t *) handle, carlie_tcp_server_handle_async_uv_read_done);
+  if ((uv_result != 0) ||
+      (! carlie_tcp_server_connection_enter_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_READING))) {
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, 0);
+    carlie_tcp_server_release_async_uv_read_buffer(environment, data, (int32_t) JNI_ABORT);
+    carlie_tcp_server_destroy_async_uv_read_data(data);
     return;
   }
-  uv_mutex_lock(native_object->close_flag_mutex);
+  data->is_parked = false;
+  data->is_stopping = false;
+  data->uses_io_uring = false;
   native_object->latest_async_uv_read_data = data;
+  // NOTE: A read issued while reading is paused only starts once it resumes.
+  if (native_object->reading_is_paused) {
+    data->is_parked = true;
+    if (data->is_streaming) {
+      carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_READING);
+    }
+    return;
+  }
+  if (carlie_tcp_server_submit_io_uring_read(data)) {
+    if (data->is_streaming) {
+      carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_READING);
+    }
+    return;
+  }
   uv_result = (int32_t) uv_read_start((uv_stream_t *) native_object->tcp_handle, carlie_tcp_server_handle_async_uv_read_allocate_buffer, carlie_tcp_server_handle_async_uv_read_data_read);
   if (uv_result < 0) {
-    uv_mutex_unlock(native_object->close_flag_mutex);
+    carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_READING);
     carlie_tcp_server_connection_emit_uv_error_event(environment, native_object, uv_result);
-    jni_object_t const bytes_read_count_object = environment[0]->NewObject(environment, native_object->server_native_object->integer_class, native_object->server_native_object->integer_constructor_method_id, (jni_int_t) 0);
-    if (bytes_read_count_object != null_ptr) {
-      environment[0]->CallObjectMethod(environment, data->callback_function_object, data->callback_function_invoke_method_id, bytes_read_count_object, null_ptr);
-    } else {
-      carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    }
-    environment[0]->DeleteGlobalRef(environment, data->callback_function_object);
-    carlie_release_array_bytes(environment, data->buffer, data->buffer_array, (int32_t) JNI_ABORT);
-    environment[0]->DeleteGlobalRef(environment, (jni_object_t) data->buffer_array);
-    uv_close((uv_handle_t *) handle, carlie_tcp_server_handle_async_uv_read_done);
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, 0);
+    carlie_tcp_server_release_async_uv_read_buffer(environment, data, (int32_t) JNI_ABORT);
+    carlie_tcp_server_destroy_async_uv_read_data(data);
+    return;
+  }
+  // NOTE: A streaming read stays active until it is stopped, the end-of-stream
+  // is reached, or the connection is closed, so it must not keep the
+  // connection from being closed in the meantime.
+  if (data->is_streaming) {
+    carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_READING);
   }
 }
 
@@ -114,8 +198,18 @@ carlie_tcp_server_handle_async_uv_read_allocate_buffer(uv_handle_t * handle,
   assert(native_object != null_ptr);
   carlie_tcp_server_async_uv_read_data_t *const async_data = native_object->latest_async_uv_read_data;
   assert(async_data != null_ptr);
-  buffer->base = (char *) async_data->buffer;
-  buffer->len = async_data->buffer_size;
+  if (async_data->is_streaming) {
+    // NOTE: Streaming reads only get a buffer once there actually is data to be
+    // read; if none can be allocated, libuv reports `UV_ENOBUFS`.
+    carlie_tcp_server_buffer_pool_t *const read_buffer_pool = &native_object->loop_data->read_buffer_pool;
+    uint8_t *const bytes = carlie_tcp_server_buffer_pool_acquire(read_buffer_pool, async_data->read_buffer_pool_size_class_index);
+    buffer->base = (char *) bytes;
+    buffer->len = (bytes != null_ptr) ?
+      carlie_tcp_server_buffer_pool_get_block_size(read_buffer_pool, async_data->read_buffer_pool_size_class_index) :
+      0u;
+    return;
+  }
+  buffer[0] = async_data->buffers[async_data->buffer_index];
 }
 
 
@@ -125,7 +219,6 @@ carlie_tcp_server_handle_async_uv_read_data_read(uv_stream_t * handle,
                                                  ssize_t bytes_read_count,
                                                  uv_buf_t const * buffer)
 {
-  CARLIE_INTERNAL_UNUSED_SYMBOL(buffer);
   assert(handle != null_ptr);
   uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
   assert(loop_handle != null_ptr);
@@ -137,38 +230,63 @@ carlie_tcp_server_handle_async_uv_read_data_read(uv_stream_t * handle,
   assert(native_object != null_ptr);
   carlie_tcp_server_async_uv_read_data_t *const async_data = native_object->latest_async_uv_read_data;
   assert(async_data != null_ptr);
+  if (async_data->is_streaming) {
+    // NOTE: Each chunk is handed over (wrapped in a direct byte buffer) as soon
+    // as it has been read, and its block goes back into the pool once the
+    // callback returns, so the JVM side has to consume the chunk before then.
+    carlie_tcp_server_buffer_pool_t *const read_buffer_pool = &native_object->loop_data->read_buffer_pool;
+    if (bytes_read_count > 0) {
+      carlie_tcp_server_connection_hand_over_read_data(environment, native_object, async_data->operation_id, (uint8_t *) buffer->base, (size_t) bytes_read_count);
+      async_data->read_buffer_pool_size_class_index = carlie_tcp_server_buffer_pool_get_next_size_class_index(read_buffer_pool, async_data->read_buffer_pool_size_class_index, (size_t) bytes_read_count);
+    }
+    if (buffer->base != null_ptr) {
+      carlie_tcp_server_buffer_pool_release(read_buffer_pool, (uint8_t *) buffer->base);
+    }
+    if (bytes_read_count >= 0) return;
+  }
+  if (bytes_read_count > 0) {
+    async_data->bytes_read_count += (size_t) bytes_read_count;
+    uv_buf_t *const current_buffer = &async_data->buffers[async_data->buffer_index];
+    current_buffer->base += bytes_read_count;
+    current_buffer->len -= (size_t) bytes_read_count;
+    // NOTE: As long as there are buffers left to read into, the stream is kept
+    // reading whenever the current buffer has been filled up completely (libuv
+    // then keeps reading from the socket right away, if there is more data).
+    if ((current_buffer->len == 0u) &&
+        ((async_data->buffer_index + 1u) < async_data->buffer_count)) {
+      async_data->buffer_index += 1u;
+      return;
+    }
+    bytes_read_count = (ssize_t) async_data->bytes_read_count;
+  } else if ((async_data->bytes_read_count > 0u) &&
+             ((bytes_read_count == 0) ||
+              (bytes_read_count == UV_EOF))) {
+    // NOTE: Whatever has been read so far gets reported; the end-of-stream is
+    // then reported on the next read.
+    bytes_read_count = (ssize_t) async_data->bytes_read_count;
+  }
   if ((bytes_read_count >= 0) ||
       (bytes_read_count == UV_EOF)) {
     bytes_read_count = (bytes_read_count != UV_EOF) ?
       bytes_read_count :
       -1;
     if (bytes_read_count > 0) {
-      // NOTE: This is very important in this case!
+      // NOTE: This is very important in this case! (At least for pinned
+      // arrays; a direct buffer already holds the data at this point.)
       int32_t const buffer_array_bytes_release_mode = 0;
-      carlie_release_array_bytes(environment, async_data->buffer, async_data->buffer_array, buffer_array_bytes_release_mode);
-    }
-    jni_object_t const bytes_read_count_object = environment[0]->NewObject(environment, native_object->server_native_object->integer_class, native_object->server_native_object->integer_constructor_method_id, (jni_int_t) (int32_t) bytes_read_count);
-    if (bytes_read_count_object != null_ptr) {
-      environment[0]->CallObjectMethod(environment, async_data->callback_function_object, async_data->callback_function_invoke_method_id, bytes_read_count_object, null_ptr);
-    } else {
-      carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
+      carlie_tcp_server_release_async_uv_read_buffer(environment, async_data, buffer_array_bytes_release_mode);
     }
+    carlie_tcp_server_connection_complete_io(environment, native_object, async_data->operation_id, (int32_t) bytes_read_count, 0);
   } else {
-    jni_object_t exception_object = null_ptr;
-    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_create_uv_exception(environment, native_object->server_native_object, bytes_read_count, &exception_object);
-    if (carlie_result == CARLIE_TCP_SERVER_RESULT_SUCCESS) {
-      environment[0]->CallObjectMethod(environment, async_data->callback_function_object, async_data->callback_function_invoke_method_id, null_ptr, exception_object);
-    } else {
-      carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    }
+    carlie_tcp_server_connection_complete_io(environment, native_object, async_data->operation_id, 0, (int32_t) bytes_read_count);
+  }
+  if (! async_data->is_streaming) {
+    carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_READING);
   }
-  uv_mutex_unlock(native_object->close_flag_mutex);
-  environment[0]->DeleteGlobalRef(environment, async_data->callback_function_object);
   if (bytes_read_count <= 0) {
-    carlie_release_array_bytes(environment, async_data->buffer, async_data->buffer_array, JNI_ABORT);
+    carlie_tcp_server_release_async_uv_read_buffer(environment, async_data, (int32_t) JNI_ABORT);
   }
-  environment[0]->DeleteGlobalRef(environment, (jni_object_t) async_data->buffer_array);
-  uv_close((uv_handle_t *) async_data->async_handle, carlie_tcp_server_handle_async_uv_read_done);
+  carlie_tcp_server_destroy_async_uv_read_data(async_data);
   native_object->latest_async_uv_read_data = null_ptr;
   int32_t const uv_result = (int32_t) uv_read_stop(handle);
   if (uv_result < 0) {
@@ -179,40 +297,207 @@ carlie_tcp_server_handle_async_uv_read_data_read(uv_stream_t * handle,
 
 
 void
-carlie_tcp_server_handle_async_uv_read_done(uv_handle_t * handle)
+carlie_tcp_server_handle_async_uv_read_pause(carlie_tcp_server_command_t * command,
+                                             uv_loop_t * loop_handle)
 {
-  assert(handle != null_ptr);
-  carlie_tcp_server_async_uv_read_data_t *const data = (carlie_tcp_server_async_uv_read_data_t *) uv_handle_get_data(handle);
-  assert(data != null_ptr);
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_async_uv_read_pause_data_t *const data = (carlie_tcp_server_async_uv_read_pause_data_t *) (void *) command;
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  assert(native_object != null_ptr);
+  bool const is_paused = data->is_paused;
   free(data);
-  free(handle);
+  int32_t uv_result = (int32_t) uv_is_closing((uv_handle_t *) native_object->tcp_handle);
+  if ((uv_result != 0) ||
+      (native_object->reading_is_paused == is_paused)) return;
+  native_object->reading_is_paused = is_paused;
+  carlie_tcp_server_async_uv_read_data_t *const async_data = native_object->latest_async_uv_read_data;
+  if (async_data == null_ptr) return;
+  if (is_paused) {
+    // NOTE: Reads that go through io_uring without streaming are one-shot, so
+    // they’re left to complete; other reads are put on hold right away.
+    if (async_data->uses_io_uring) {
+      if (async_data->is_streaming) {
+        carlie_tcp_server_pause_io_uring_read(async_data);
+      }
+      return;
+    }
+    async_data->is_parked = true;
+    uv_result = (int32_t) uv_read_stop((uv_stream_t *) native_object->tcp_handle);
+    if (uv_result < 0) {
+      carlie_tcp_server_connection_emit_uv_error_event(environment, native_object, uv_result);
+    }
+    return;
+  }
+  if (! async_data->is_parked) return;
+  async_data->is_parked = false;
+  async_data->uses_io_uring = false;
+  if (carlie_tcp_server_submit_io_uring_read(async_data)) return;
+  uv_result = (int32_t) uv_read_start((uv_stream_t *) native_object->tcp_handle, carlie_tcp_server_handle_async_uv_read_allocate_buffer, carlie_tcp_server_handle_async_uv_read_data_read);
+  if (uv_result < 0) {
+    native_object->latest_async_uv_read_data = null_ptr;
+    if (! async_data->is_streaming) {
+      carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_READING);
+    }
+    carlie_tcp_server_connection_emit_uv_error_event(environment, native_object, uv_result);
+    carlie_tcp_server_connection_complete_io(environment, native_object, async_data->operation_id, 0, 0);
+    carlie_tcp_server_release_async_uv_read_buffer(environment, async_data, (int32_t) JNI_ABORT);
+    carlie_tcp_server_destroy_async_uv_read_data(async_data);
+  }
 }
 
 
 
 void
-carlie_tcp_server_handle_async_uv_server_close(uv_async_t * handle)
+carlie_tcp_server_handle_async_uv_read_stop(carlie_tcp_server_command_t * command,
+                                            uv_loop_t * loop_handle)
 {
-  assert(handle != null_ptr);
-  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(command != null_ptr);
   assert(loop_handle != null_ptr);
-  uv_close((uv_handle_t *) handle, carlie_tcp_server_handle_async_uv_server_close_done);
   carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
   assert(loop_data != null_ptr);
-  carlie_tcp_server_native_object_t *const native_object = loop_data->server_native_object;
-  uv_walk(loop_handle, carlie_tcp_server_handle_async_uv_server_close_walk_step, (void *) native_object);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_async_uv_read_stop_data_t *const data = (carlie_tcp_server_async_uv_read_stop_data_t *) (void *) command;
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  assert(native_object != null_ptr);
+  free(data);
+  carlie_tcp_server_connection_stop_streaming_read(environment, native_object);
+}
+
+
+
+void
+carlie_tcp_server_handle_async_uv_relay(carlie_tcp_server_command_t * command,
+                                        uv_loop_t * loop_handle)
+{
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_async_uv_relay_data_t *const data = (carlie_tcp_server_async_uv_relay_data_t *) (void *) command;
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  int32_t uv_result = (int32_t) uv_is_closing((uv_handle_t *) native_object->tcp_handle);
+  if ((uv_result != 0) ||
+      (data->destination_socket_descriptor < 0)) {
+    carlie_tcp_server_stop_relay(environment, data);
+    return;
+  }
+  uv_result = carlie_tcp_server_start_relay(loop_data, data);
+  if (uv_result < 0) {
+    data->error_number = uv_result;
+    carlie_tcp_server_stop_relay(environment, data);
+  }
+}
+
+
+
+void
+carlie_tcp_server_handle_async_uv_relay_destination(carlie_tcp_server_command_t * command,
+                                                    uv_loop_t * loop_handle)
+{
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_async_uv_relay_data_t *const data = (carlie_tcp_server_async_uv_relay_data_t *) (void *) command;
+  carlie_tcp_server_connection_native_object_t *const destination_native_object = data->destination_native_object;
+  int32_t uv_result = (int32_t) uv_is_closing((uv_handle_t *) destination_native_object->tcp_handle);
+  if (uv_result == 0) {
+    uv_result = carlie_tcp_server_duplicate_socket(destination_native_object->tcp_handle, &data->destination_socket_descriptor);
+    if (uv_result < 0) {
+      data->error_number = uv_result;
+    } else {
+      __atomic_add_fetch(&destination_native_object->relays_count, 1u, __ATOMIC_RELEASE);
+    }
+  }
+  carlie_tcp_server_post_command(data->native_object->loop_data, &data->command, carlie_tcp_server_handle_async_uv_relay);
+}
+
+
+
+void
+carlie_tcp_server_handle_async_uv_send_file(carlie_tcp_server_command_t * command,
+                                            uv_loop_t * loop_handle)
+{
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_async_uv_send_file_data_t *const data = (carlie_tcp_server_async_uv_send_file_data_t *) (void *) command;
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
   int32_t const uv_result = (int32_t) uv_is_closing((uv_handle_t *) native_object->tcp_handle);
-  assert(uv_result == 0);
-  uv_close((uv_handle_t *) native_object->tcp_handle, carlie_tcp_server_handle_uv_server_closed);
+  if (uv_result != 0) {
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, 0);
+    carlie_tcp_server_destroy_async_uv_send_file_data(data);
+    return;
+  }
+  carlie_tcp_server_send_file(environment, data);
 }
 
 
 
 void
-carlie_tcp_server_handle_async_uv_server_close_done(uv_handle_t * handle)
+carlie_tcp_server_handle_async_uv_send_file_data_written(uv_write_t * request,
+                                                         int uv_write_status)
 {
-  assert(handle != null_ptr);
-  free(handle);
+  assert(request != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) request->handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_async_uv_send_file_data_t *const data = (carlie_tcp_server_async_uv_send_file_data_t *) uv_req_get_data((uv_req_t *) request);
+  assert(data != null_ptr);
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  int32_t const uv_result = (int32_t) uv_write_status;
+  carlie_tcp_server_connection_remove_pending_write_bytes(environment, native_object, data->chunk_buffer.len);
+  if (uv_result < 0) {
+    // NOTE: Same as for writes, a transfer that got cancelled because the
+    // connection was closed is reported as having sent nothing more.
+    if (uv_result == UV_ECANCELED) {
+      carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, (int32_t) data->bytes_sent_count, 0);
+    } else {
+      carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, uv_result);
+    }
+    carlie_tcp_server_destroy_async_uv_send_file_data(data);
+    return;
+  }
+  data->bytes_sent_count += data->chunk_buffer.len;
+  data->file_offset += (int64_t) data->chunk_buffer.len;
+  carlie_tcp_server_send_file(environment, data);
+}
+
+
+
+void
+carlie_tcp_server_handle_async_uv_server_close(carlie_tcp_server_command_t * command,
+                                               uv_loop_t * loop_handle)
+{
+  assert(command != null_ptr);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  // NOTE: The sockets that get closed below may only go once io_uring and the
+  // relays are done with them.
+  carlie_tcp_server_cancel_io_uring_operations(loop_data->environment, loop_data, null_ptr);
+  carlie_tcp_server_stop_relays(loop_data->environment, loop_data, null_ptr);
+  uv_walk(loop_handle, carlie_tcp_server_handle_async_uv_server_close_walk_step, (void *) loop_data);
+  // NOTE: A loop without a listener reports being closed through its command
+  // queue’s handle instead.
+  uv_handle_t *const last_handle = (loop_data->tcp_handle_is_listener) ?
+    (uv_handle_t *) loop_data->tcp_handle :
+    (uv_handle_t *) loop_data->command_queue_async_handle;
+  int32_t const uv_result = (int32_t) uv_is_closing(last_handle);
+  assert(uv_result == 0);
+  uv_close(last_handle, carlie_tcp_server_handle_uv_server_closed);
 }
 
 
@@ -222,8 +507,11 @@ carlie_tcp_server_handle_async_uv_server_close_walk_step(uv_handle_t * handle,
                                                          void * data)
 {
   assert(handle != null_ptr);
-  carlie_tcp_server_native_object_t *const native_object = (carlie_tcp_server_native_object_t *) data;
-  if (handle == ((uv_handle_t *) native_object->tcp_handle)) return;
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) data;
+  if (loop_data->tcp_handle_is_listener &&
+      (handle == ((uv_handle_t *) loop_data->tcp_handle))) return;
+  if ((! loop_data->tcp_handle_is_listener) &&
+      (handle == ((uv_handle_t *) loop_data->command_queue_async_handle))) return;
   int32_t const uv_result = (int32_t) uv_is_closing(handle);
   if (uv_result != 0) return;
   uv_close(handle, null_ptr);
@@ -232,103 +520,97 @@ carlie_tcp_server_handle_async_uv_server_close_walk_step(uv_handle_t * handle,
 
 
 void
-carlie_tcp_server_handle_async_uv_write(uv_async_t * handle)
+carlie_tcp_server_handle_async_uv_write(carlie_tcp_server_command_t * command,
+                                        uv_loop_t * loop_handle)
 {
-  assert(handle != null_ptr);
-  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(command != null_ptr);
   assert(loop_handle != null_ptr);
   carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
   assert(loop_data != null_ptr);
   jni_environment_handle_t const environment = loop_data->environment;
   assert(environment != null_ptr);
-  carlie_tcp_server_async_uv_write_data_t *const data = (carlie_tcp_server_async_uv_write_data_t *) uv_handle_get_data((uv_handle_t *) handle);
-  assert(data != null_ptr);
-  uv_buf_t *const buffer = data->buffer;
-  jni_byte_array_t const buffer_array = data->buffer_array;
-  jni_method_id_t const callback_function_invoke_method_id = data->callback_function_invoke_method_id;
-  jni_object_t const callback_function_object = data->callback_function_object;
+  carlie_tcp_server_async_uv_write_data_t *const data = (carlie_tcp_server_async_uv_write_data_t *) (void *) command;
   carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
-  uv_close((uv_handle_t *) handle, carlie_tcp_server_handle_async_uv_write_done);
-  int32_t uv_result;
-  // TODO: Is this check actually necessary? Just being careful, but
-  // `uv_try_write(…)` probably already handles this case and returns an
-  // appropriate error. Look into this.
-  uv_result = (int32_t) uv_is_closing((uv_handle_t *) native_object->tcp_handle);
-  if (uv_result != 0) {
-    jni_object_t const bytes_written_count_object = environment[0]->NewObject(environment, native_object->server_native_object->integer_class, native_object->server_native_object->integer_constructor_method_id, (jni_int_t) 0);
-    if (bytes_written_count_object != null_ptr) {
-      environment[0]->CallObjectMethod(environment, data->callback_function_object, data->callback_function_invoke_method_id, bytes_written_count_object, null_ptr);
-    } else {
-      carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    }
-    environment[0]->DeleteGlobalRef(environment, callback_function_object);
-    carlie_release_array_bytes(environment, (uint8_t *) buffer->base, buffer_array, (int32_t) JNI_ABORT);
-    environment[0]->DeleteGlobalRef(environment, (jni_object_t) buffer_array);
-    free(buffer);
+  // NOTE: Writes reach the loop through both the command queue and the
+  // submission ring, so a write may overtake one that was issued before it;
+  // it’s held back until all the writes before it have been started.
+  if (data->operation_id != native_object->next_write_operation_id) {
+    data->next_write_data = native_object->out_of_order_writes;
+    native_object->out_of_order_writes = data;
     return;
   }
-  uv_mutex_lock(native_object->close_flag_mutex);
-  uv_result = (int32_t) uv_try_write((uv_stream_t *) native_object->tcp_handle, buffer, 1u);
-  if (uv_result >= 0) {
-    size_t const bytes_written_count = (size_t) uv_result;
-    jni_object_t const bytes_written_count_object = environment[0]->NewObject(environment, native_object->server_native_object->integer_class, native_object->server_native_object->integer_constructor_method_id, (jni_int_t) (int32_t) bytes_written_count);
-    if (bytes_written_count_object != null_ptr) {
-      environment[0]->CallObjectMethod(environment, callback_function_object, callback_function_invoke_method_id, bytes_written_count_object, null_ptr);
-    } else {
-      carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    }
+  carlie_tcp_server_connection_start_writes(environment, native_object, data);
+}
+
+
+
+void
+carlie_tcp_server_handle_async_uv_write_data_written(uv_write_t * request,
+                                                     int uv_write_status)
+{
+  assert(request != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) request->handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_async_uv_write_data_t *const data = (carlie_tcp_server_async_uv_write_data_t *) uv_req_get_data((uv_req_t *) request);
+  assert(data != null_ptr);
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  int32_t const uv_result = (int32_t) uv_write_status;
+  carlie_tcp_server_connection_remove_pending_write_bytes(environment, native_object, data->bytes_count);
+  if ((uv_result >= 0) || (uv_result == UV_ECANCELED)) {
+    // NOTE: `uv_write(…)` only completes successfully once the whole buffer has
+    // been written, so there is no partial write to report here. A request
+    // that got cancelled because the connection was closed may have been
+    // partly written, but libuv doesn’t report how much of it was, so it gets
+    // reported as having written nothing (i.e., its count is unknown rather
+    // than zero), same as a write issued on a closing connection.
+    size_t const bytes_written_count = (uv_result >= 0) ?
+      data->bytes_count :
+      0u;
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, (int32_t) bytes_written_count, 0);
   } else {
-    if (uv_result == UV_EAGAIN) {
-      carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_write(environment, native_object, buffer_array, buffer->len, callback_function_object, callback_function_invoke_method_id, &uv_result);
-      if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
-        switch (carlie_result) {
-          case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
-            carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
-            break;
-          }
-          case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
-            carlie_tcp_server_connection_emit_uv_error_event(environment, native_object, uv_result);
-            break;
-          }
-          default: {
-            // Unreachable in this case.
-            break;
-          }
-        }
-        jni_object_t const bytes_written_count_object = environment[0]->NewObject(environment, native_object->server_native_object->integer_class, native_object->server_native_object->integer_constructor_method_id, (jni_int_t) 0);
-        if (bytes_written_count_object != null_ptr) {
-          environment[0]->CallObjectMethod(environment, data->callback_function_object, data->callback_function_invoke_method_id, bytes_written_count_object, null_ptr);
-        } else {
-          carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-        }
-      }
-    } else {
-      jni_object_t exception_object = null_ptr;
-      carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_create_uv_exception(environment, native_object->server_native_object, uv_result, &exception_object);
-      if (carlie_result == CARLIE_TCP_SERVER_RESULT_SUCCESS) {
-        environment[0]->CallObjectMethod(environment, callback_function_object, callback_function_invoke_method_id, null_ptr, exception_object);
-      } else {
-        carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-      }
-    }
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, uv_result);
   }
-  uv_mutex_unlock(native_object->close_flag_mutex);
-  environment[0]->DeleteGlobalRef(environment, callback_function_object);
-  carlie_release_array_bytes(environment, (uint8_t *) buffer->base, buffer_array, (int32_t) JNI_ABORT);
-  environment[0]->DeleteGlobalRef(environment, (jni_object_t) buffer_array);
-  free(buffer);
+  carlie_tcp_server_release_async_uv_write_buffer(environment, data);
+  carlie_tcp_server_destroy_async_uv_write_data(data);
 }
 
 
 
 void
-carlie_tcp_server_handle_async_uv_write_done(uv_handle_t * handle)
+carlie_tcp_server_handle_command_queue_async(uv_async_t * handle)
 {
   assert(handle != null_ptr);
-  carlie_tcp_server_async_uv_write_data_t *const data = (carlie_tcp_server_async_uv_write_data_t *) uv_handle_get_data(handle);
-  assert(data != null_ptr);
-  free(data);
-  free(handle);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_handle_get_data((uv_handle_t *) handle);
+  assert(loop_data != null_ptr);
+  carlie_tcp_server_command_t * command = carlie_tcp_server_command_queue_take_all(&loop_data->command_queue);
+  while (command != null_ptr) {
+    // NOTE: The handler may free the command, so the next one has to be looked
+    // up beforehand.
+    carlie_tcp_server_command_t *const next_command = command->next_command;
+    command->handler(command, loop_handle);
+    command = next_command;
+  }
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_accept_batch_check(uv_check_t * handle)
+{
+  assert(handle != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_flush_accept_batch(environment, loop_data);
 }
 
 
@@ -348,22 +630,59 @@ carlie_tcp_server_handle_uv_connection_closed(uv_handle_t * handle)
   if (jni_result != 0) return;
   carlie_tcp_server_connection_native_object_t *const native_object = (carlie_tcp_server_connection_native_object_t *) uv_handle_get_data(handle);
   assert(native_object != null_ptr);
-  environment[0]->CallVoidMethod(environment, native_object->handle_closed_event_function_object, native_object->handle_closed_event_function_handle_method_id);
+  __atomic_store_n(&native_object->state, CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSED, __ATOMIC_RELEASE);
+  carlie_tcp_server_connection_stop_streaming_read(environment, native_object);
+  // NOTE: The connection (if it was just accepted) and its completions have to
+  // reach the JVM side before it learns that the connection has closed.
+  carlie_tcp_server_flush_accept_batch(environment, loop_data);
+  carlie_tcp_server_flush_io_completion_batch(environment, loop_data);
+  if (loop_data->io_rings.is_enabled) {
+    // NOTE: With rings, the connection’s completions are still on their way
+    // (through the completion ring), so its closed event has to follow them.
+    carlie_tcp_server_io_ring_completion_entry_t const entry = {
+      .connection_native_object_address = (uint64_t) (uintptr_t) native_object,
+      .operation_id = CARLIE_TCP_SERVER_IO_RING_CLOSED_OPERATION_ID,
+      .result = 0,
+      .error_number = 0,
+    };
+    carlie_tcp_server_post_io_ring_completion(environment, loop_data, &entry);
+  } else {
+    environment[0]->CallVoidMethod(environment, native_object->handle_closed_event_function_object, native_object->handle_closed_event_function_handle_method_id);
+  }
   environment[0]->PopLocalFrame(environment, null_ptr);
 }
 
 
 
+void
+carlie_tcp_server_handle_uv_connection_handed_off(uv_handle_t * handle)
+{
+  assert(handle != null_ptr);
+  carlie_tcp_server_connection_handoff_data_t *const data = (carlie_tcp_server_connection_handoff_data_t *) uv_handle_get_data(handle);
+  assert(data != null_ptr);
+  // NOTE: Without a socket, the handoff failed, and there’s nothing to hand
+  // over.
+  if (data->socket_descriptor < 0) {
+    free(data);
+    return;
+  }
+  // NOTE: The acceptor’s handle (and its copy of the socket) is gone by now, so
+  // the serving loop owns the socket from here on.
+  carlie_tcp_server_post_command(data->loop_data, &data->command, carlie_tcp_server_handle_async_uv_connection_handoff);
+}
+
+
+
 void
 carlie_tcp_server_handle_uv_connection_received(uv_stream_t * stream,
                                                 int uv_connection_received_status)
 {
   assert(stream != null_ptr);
   uv_tcp_t *const tcp_handle = (uv_tcp_t *) stream;
-  carlie_tcp_server_native_object_t *const server_native_object = (carlie_tcp_server_native_object_t *) uv_handle_get_data((uv_handle_t *) tcp_handle);
-  assert(server_native_object != null_ptr);
-  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(server_native_object->loop_handle);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_handle_get_data((uv_handle_t *) tcp_handle);
   assert(loop_data != null_ptr);
+  carlie_tcp_server_native_object_t *const server_native_object = loop_data->server_native_object;
+  assert(server_native_object != null_ptr);
   jni_environment_handle_t const environment = loop_data->environment;
   assert(environment != null_ptr);
   if (uv_connection_received_status < 0) {
@@ -380,58 +699,207 @@ carlie_tcp_server_handle_uv_connection_received(uv_stream_t * stream,
     environment[0]->PopLocalFrame(environment, null_ptr);
     return;
   }
-  int32_t const jni_result = (int32_t) environment[0]->PushLocalFrame(environment, (jni_int_t) 3);
-  // There’s no point in doing anything extra here.
-  if (jni_result != 0) return;
-  // NOTE: This object is a local reference that must be manually released.
-  jni_object_t connection_native_object_bytes = null_ptr;
-  carlie_tcp_server_connection_native_object_t * connection_native_object = null_ptr;
-  carlie_tcp_server_create_connection_native_object(environment, server_native_object, &connection_native_object_bytes, &connection_native_object);
-  int32_t uv_result;
-  uv_result = (int32_t) uv_mutex_init(connection_native_object->close_flag_mutex);
-  if (uv_result != 0) {
-    environment[0]->PopLocalFrame(environment, null_ptr);
-    return;
-  }
-  // TODO: Investigate this lock acquisition implementation. A quick glance at
-  // the source shows that there seems to be a possible case where this call
-  // would `abort()` the whole process; not good!
-  uv_mutex_lock(connection_native_object->close_flag_mutex);
-  jni_object_t const connection_object = environment[0]->CallObjectMethod(environment, server_native_object->create_connection_method_function_object, server_native_object->create_connection_method_function_invoke_method_id, connection_native_object_bytes);
-  if (! connection_native_object->tcp_handle_is_initialized) {
-    uv_mutex_unlock(connection_native_object->close_flag_mutex);
-    environment[0]->PopLocalFrame(environment, null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const serving_loop_data = carlie_tcp_server_pick_serving_loop_data(loop_data);
+  if (serving_loop_data == loop_data) {
+    carlie_tcp_server_serve_connection(environment, loop_data, -1);
     return;
   }
-  uv_result = (int32_t) uv_accept((uv_stream_t *) server_native_object->tcp_handle, (uv_stream_t *) connection_native_object->tcp_handle);
-  // TODO: When can this happen?
-  if (uv_result < 0) {
-    uv_mutex_unlock(connection_native_object->close_flag_mutex);
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_hand_off_connection(loop_data, serving_loop_data, &uv_result);
+  if (carlie_result == CARLIE_TCP_SERVER_RESULT_UV_FAILURE) {
+    int32_t const jni_result = (int32_t) environment[0]->PushLocalFrame(environment, (jni_int_t) 5);
+    // There’s no point in doing anything extra here.
+    if (jni_result != 0) return;
+    carlie_tcp_server_emit_uv_error_event(environment, server_native_object, uv_result);
     environment[0]->PopLocalFrame(environment, null_ptr);
-    return;
   }
-  uv_mutex_unlock(connection_native_object->close_flag_mutex);
-  environment[0]->CallVoidMethod(environment, server_native_object->handle_client_connected_event_function_object, server_native_object->handle_client_connected_event_function_handle_method_id, connection_object);
-  environment[0]->PopLocalFrame(environment, null_ptr);
 }
 
 
 
 void
-carlie_tcp_server_handle_uv_server_closed(uv_handle_t * handle)
+carlie_tcp_server_handle_uv_event_loop_group_attachment_closed(uv_handle_t * handle)
 {
   assert(handle != null_ptr);
-  uv_loop_t *const loop_handle = uv_handle_get_loop(handle);
-  assert(loop_handle != null_ptr);
-  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
-  assert(loop_data != null_ptr);
-  jni_environment_handle_t const environment = loop_data->environment;
-  assert(environment != null_ptr);
+  carlie_tcp_server_event_loop_group_attachment_t *const attachment = (carlie_tcp_server_event_loop_group_attachment_t *) uv_handle_get_data(handle);
+  assert(attachment != null_ptr);
+  carlie_tcp_server_finish_loop(attachment->loop_data);
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_event_loop_group_attachment_polled(uv_poll_t * handle,
+                                                               int status,
+                                                               int events)
+{
+  assert(handle != null_ptr);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(status);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(events);
+  carlie_tcp_server_event_loop_group_attachment_t *const attachment = (carlie_tcp_server_event_loop_group_attachment_t *) uv_handle_get_data((uv_handle_t *) handle);
+  assert(attachment != null_ptr);
+  carlie_tcp_server_run_attached_loop(attachment);
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_io_completion_batch_check(uv_check_t * handle)
+{
+  assert(handle != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_flush_io_completion_batch(environment, loop_data);
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_io_rings_check(uv_check_t * handle)
+{
+  assert(handle != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_drain_io_rings(environment, loop_data);
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_io_rings_prepare(uv_prepare_t * handle)
+{
+  assert(handle != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_drain_io_rings(environment, loop_data);
+  // NOTE: The loop is about to poll for I/O, which may block.
+  carlie_tcp_server_arm_io_rings(loop_data);
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_io_uring_check(uv_check_t * handle)
+{
+  assert(handle != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_flush_io_uring(environment, loop_data);
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_io_uring_polled(uv_poll_t * handle,
+                                            int status,
+                                            int events)
+{
+  assert(handle != null_ptr);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(status);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(events);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_reap_io_uring_completions(environment, loop_data);
+#endif
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_io_uring_prepare(uv_prepare_t * handle)
+{
+  assert(handle != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop((uv_handle_t *) handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  // NOTE: The loop is about to poll for I/O, which may block.
+  carlie_tcp_server_flush_io_uring(environment, loop_data);
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_relay_closed(uv_handle_t * handle)
+{
+  assert(handle != null_ptr);
+  carlie_tcp_server_async_uv_relay_data_t *const data = (carlie_tcp_server_async_uv_relay_data_t *) uv_handle_get_data(handle);
+  assert(data != null_ptr);
+  data->handles_count -= 1u;
+  if (data->handles_count == 0u) {
+    carlie_tcp_server_destroy_async_uv_relay_data(data);
+  }
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_relay_polled(uv_poll_t * handle,
+                                         int status,
+                                         int events)
+{
+  assert(handle != null_ptr);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(events);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(uv_handle_get_loop((uv_handle_t *) handle));
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_async_uv_relay_data_t *const data = (carlie_tcp_server_async_uv_relay_data_t *) uv_handle_get_data((uv_handle_t *) handle);
+  assert(data != null_ptr);
+  if (status < 0) {
+    data->error_number = (int32_t) status;
+    carlie_tcp_server_stop_relay(environment, data);
+    return;
+  }
+  carlie_tcp_server_relay(environment, data);
+}
+
+
+
+void
+carlie_tcp_server_handle_uv_server_closed(uv_handle_t * handle)
+{
+  assert(handle != null_ptr);
+  uv_loop_t *const loop_handle = uv_handle_get_loop(handle);
+  assert(loop_handle != null_ptr);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(loop_handle);
+  assert(loop_data != null_ptr);
+  jni_environment_handle_t const environment = loop_data->environment;
+  assert(environment != null_ptr);
+  carlie_tcp_server_native_object_t *const native_object = loop_data->server_native_object;
+  assert(native_object != null_ptr);
+  carlie_tcp_server_flush_accept_batch(environment, loop_data);
+  carlie_tcp_server_flush_io_completion_batch(environment, loop_data);
+  // NOTE: The server only counts as closed once the listeners of all its loops
+  // have closed, so only the last loop to get there reports it.
+  size_t const open_loops_count = __atomic_sub_fetch(&native_object->open_loops_count, 1u, __ATOMIC_ACQ_REL);
+  if (open_loops_count != 0u) return;
   int32_t const jni_result = (int32_t) environment[0]->PushLocalFrame(environment, (jni_int_t) 1);
   // There’s no point in doing anything extra here.
   if (jni_result != 0) return;
-  carlie_tcp_server_native_object_t *const native_object = (carlie_tcp_server_native_object_t *) uv_handle_get_data(handle);
-  assert(native_object != null_ptr);
   environment[0]->CallVoidMethod(environment, native_object->handle_closed_event_function_object, native_object->handle_closed_event_function_handle_method_id);
   environment[0]->PopLocalFrame(environment, null_ptr);
 }
@@ -464,8 +932,10 @@ carlie_tcp_server_uv_job_close_connection_completed(uv_work_t * handle,
 {
   assert(handle != null_ptr);
   CARLIE_INTERNAL_UNUSED_SYMBOL(uv_job_completed_status);
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = (carlie_tcp_server_native_object_loop_data_t *) uv_loop_get_data(handle->loop);
+  assert(loop_data != null_ptr);
   uv_req_set_data((uv_req_t *) handle, null_ptr);
-  free(handle);
+  carlie_tcp_server_record_pool_release(&loop_data->server_native_object->close_connection_job_pool, handle);
 }
 
 
@@ -497,6 +967,8 @@ JNI_DEFINE_METHOD(jni_int_t, getNativeObjectSize)(jni_environment_handle_t envir
 JNI_DEFINE_METHOD(jni_boolean_t, initializeNative)(jni_environment_handle_t environment,
                                                    jni_object_t server_object,
                                                    jni_object_t native_object_bytes,
+                                                   jni_int_t loops_count,
+                                                   jni_boolean_t uses_acceptor_handoff,
                                                    jni_object_t create_connection_native_object_static_method_function_object,
                                                    jni_class_t create_connection_native_object_static_method_function_class,
                                                    jni_object_t create_connection_method_function_object,
@@ -518,10 +990,7 @@ JNI_DEFINE_METHOD(jni_boolean_t, initializeNative)(jni_environment_handle_t envi
   if (jni_result < 0) {
     return (jni_boolean_t) false;
   }
-  uv_loop_t *const loop_handle = uv_default_loop();
-  if (loop_handle == null_ptr) {
-    return (jni_boolean_t) false;
-  }
+  assert(((int32_t) loops_count) > 0);
   jni_method_id_t const create_connection_method_function_invoke_method_id = environment[0]->GetMethodID(environment, create_connection_method_function_class, "invoke", "(Ljava/lang/Object;)Ljava/lang/Object;");
   jni_method_id_t const create_connection_native_object_static_method_function_invoke_method_id = environment[0]->GetMethodID(environment, create_connection_native_object_static_method_function_class, "invoke", "()Ljava/lang/Object;");
   jni_method_id_t const handle_client_connected_event_function_handle_method_id = environment[0]->GetMethodID(environment, handle_client_connected_event_function_class, "handle", "(Lio/seventeenninetyone/carlie/TcpServer$Connection;)V");
@@ -582,8 +1051,6 @@ JNI_DEFINE_METHOD(jni_boolean_t, initializeNative)(jni_environment_handle_t envi
   carlie_tcp_server_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
   native_object->java_vm = java_vm;
-  native_object->loop_handle = loop_handle;
-  native_object->tcp_handle = &native_object->tcp_handle_;
   native_object->create_connection_method_function_invoke_method_id = create_connection_method_function_invoke_method_id;
   native_object->create_connection_method_function_object = create_connection_method_function_object;
   native_object->create_connection_native_object_static_method_function_invoke_method_id = create_connection_native_object_static_method_function_invoke_method_id;
@@ -603,6 +1070,77 @@ JNI_DEFINE_METHOD(jni_boolean_t, initializeNative)(jni_environment_handle_t envi
   native_object->runtime_exception_constructor_method_id = runtime_exception_constructor_method_id;
   native_object->uv_exception_class = uv_exception_class;
   native_object->uv_exception_constructor_method_id = uv_exception_constructor_method_id;
+  carlie_tcp_server_record_pool_t *const record_pools[] = {
+    &native_object->async_uv_close_data_pool,
+    &native_object->async_uv_read_data_pool,
+    &native_object->async_uv_write_data_pool,
+    &native_object->close_connection_job_pool,
+  };
+  size_t const record_sizes[] = {
+    sizeof(carlie_tcp_server_async_uv_close_data_t),
+    sizeof(carlie_tcp_server_async_uv_read_data_t),
+    sizeof(carlie_tcp_server_async_uv_write_data_t),
+    sizeof(uv_work_t),
+  };
+  size_t const record_pools_count = sizeof(record_pools) / sizeof(record_pools[0]);
+  size_t record_pools_initialized_count = 0u;
+  while ((record_pools_initialized_count < record_pools_count) &&
+         carlie_tcp_server_record_pool_initialize(record_pools[record_pools_initialized_count], record_sizes[record_pools_initialized_count])) {
+    record_pools_initialized_count += 1u;
+  }
+  bool const loops_stopped_semaphore_is_initialized = (record_pools_initialized_count == record_pools_count) &&
+    (uv_sem_init(&native_object->loops_stopped_semaphore, 0u) == 0);
+  carlie_tcp_server_native_object_loop_data_t *const loops_data = (loops_stopped_semaphore_is_initialized) ?
+    calloc((size_t) loops_count, sizeof(carlie_tcp_server_native_object_loop_data_t)) :
+    null_ptr;
+  size_t loops_initialized_count = 0u;
+  if (loops_data != null_ptr) {
+    int32_t uv_result;
+    while ((loops_initialized_count < ((size_t) loops_count)) &&
+           (carlie_tcp_server_initialize_loop_data(native_object, &loops_data[loops_initialized_count], &uv_result) == CARLIE_TCP_SERVER_RESULT_SUCCESS)) {
+      loops_initialized_count += 1u;
+    }
+  }
+  if (loops_initialized_count != ((size_t) loops_count)) {
+    for (size_t i = 0u; i < loops_initialized_count; i++) {
+      carlie_tcp_server_destroy_loop_data(&loops_data[i]);
+    }
+    free(loops_data);
+    if (loops_stopped_semaphore_is_initialized) {
+      uv_sem_destroy(&native_object->loops_stopped_semaphore);
+    }
+    for (size_t i = 0u; i < record_pools_initialized_count; i++) {
+      carlie_tcp_server_record_pool_destroy(record_pools[i]);
+    }
+    jni_object_t const global_object_references[] = {
+      create_connection_method_function_object,
+      create_connection_native_object_static_method_function_object,
+      handle_client_connected_event_function_object,
+      handle_closed_event_function_object,
+      handle_error_occurred_event_function_object,
+      (jni_object_t) integer_class,
+      (jni_object_t) null_pointer_exception_class,
+      (jni_object_t) runtime_exception_class,
+      (jni_object_t) uv_exception_class,
+    };
+    size_t const global_object_references_count = sizeof(global_object_references) / sizeof(global_object_references[0]);
+    for (size_t i = 0u; i < global_object_references_count; i++) {
+      environment[0]->DeleteGlobalRef(environment, global_object_references[i]);
+    }
+    native_object[0] = empty_carlie_tcp_server_native_object;
+    return (jni_boolean_t) false;
+  }
+  native_object->loops_data = loops_data;
+  native_object->loops_count = (size_t) loops_count;
+  native_object->open_loops_count = (size_t) loops_count;
+  native_object->uses_acceptor_handoff = (bool) uses_acceptor_handoff;
+  native_object->write_high_watermark = (uint64_t) CARLIE_TCP_SERVER_DEFAULT_WRITE_HIGH_WATERMARK;
+  native_object->write_low_watermark = (uint64_t) CARLIE_TCP_SERVER_DEFAULT_WRITE_LOW_WATERMARK;
+  // NOTE: When handing connections off, only the first loop has a listener.
+  native_object->listeners_count = (native_object->uses_acceptor_handoff) ? 1u : native_object->loops_count;
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    loops_data[i].tcp_handle_is_listener = (i < native_object->listeners_count);
+  }
   return (jni_boolean_t) true;
 }
 
@@ -633,13 +1171,86 @@ JNI_DEFINE_METHOD(void, closeNative)(jni_environment_handle_t environment,
     assert(global_object_reference != null_ptr);
     environment[0]->DeleteGlobalRef(environment, global_object_reference);
   }
-  uv_handle_set_data((uv_handle_t *) native_object->tcp_handle, null_ptr);
+  if (native_object->accept_batch_sink_function_object != null_ptr) {
+    environment[0]->DeleteGlobalRef(environment, native_object->accept_batch_sink_function_object);
+  }
+  if (native_object->io_completion_batch_sink_function_object != null_ptr) {
+    environment[0]->DeleteGlobalRef(environment, native_object->io_completion_batch_sink_function_object);
+  }
+  if (native_object->io_ring_wake_up_function_object != null_ptr) {
+    environment[0]->DeleteGlobalRef(environment, native_object->io_ring_wake_up_function_object);
+  }
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    jni_object_t const connections_array = native_object->loops_data[i].accept_batch.connections_array;
+    if (connections_array != null_ptr) {
+      environment[0]->DeleteGlobalRef(environment, connections_array);
+    }
+    carlie_tcp_server_io_completion_batch_t *const batch = &native_object->loops_data[i].io_completion_batch;
+    if (batch->sinks_array != null_ptr) {
+      environment[0]->DeleteGlobalRef(environment, batch->sinks_array);
+    }
+    if (batch->values_array != null_ptr) {
+      environment[0]->DeleteGlobalRef(environment, batch->values_array);
+    }
+    // NOTE: The JVM side is done with the rings’ memory by now (see
+    // `TcpServer.finishClosing()`).
+    carlie_tcp_server_destroy_io_rings(&native_object->loops_data[i]);
+    // NOTE: Same goes for io_uring, which the loop was done with before it
+    // stopped (see `carlie_tcp_server_finish_loop(…)`).
+    carlie_tcp_server_destroy_io_uring_transport(&native_object->loops_data[i]);
+  }
+  carlie_tcp_server_record_pool_t *const record_pools[] = {
+    &native_object->async_uv_close_data_pool,
+    &native_object->async_uv_read_data_pool,
+    &native_object->async_uv_write_data_pool,
+    &native_object->close_connection_job_pool,
+  };
+  size_t const record_pools_count = sizeof(record_pools) / sizeof(record_pools[0]);
+  for (size_t i = 0u; i < record_pools_count; i++) {
+    carlie_tcp_server_record_pool_destroy(record_pools[i]);
+  }
+  // NOTE: By now, the loops have stopped running (and have torn themselves
+  // down; see `waitForUvLoops(…)`), so their data can go.
+  free(native_object->loops_data);
+  uv_sem_destroy(&native_object->loops_stopped_semaphore);
   // Zero out the native object by setting it to an empty one.
   native_object[0] = empty_carlie_tcp_server_native_object;
 }
 
 
 
+JNI_DEFINE_METHOD(void, attachToEventLoopGroup)(jni_environment_handle_t environment,
+                                                jni_object_t server_object,
+                                                jni_object_t native_object_bytes,
+                                                jni_object_t group_native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  carlie_event_loop_group_native_object_t * group_native_object = null_ptr;
+  carlie_get_native_object(environment, group_native_object_bytes, (void **) &group_native_object);
+  // NOTE: Not every platform has a backend that can be polled (e.g., there’s
+  // no such thing on Windows).
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    if (uv_backend_fd(native_object->loops_data[i].loop_handle) < 0) {
+      carlie_tcp_server_throw_uv_exception(environment, native_object, (int32_t) UV_ENOTSUP);
+      return;
+    }
+  }
+  // NOTE: Each server starts off at the group’s next loop, so that servers
+  // with fewer loops than the group don’t all end up on its first loops.
+  size_t const first_group_loop_index = __atomic_fetch_add(&group_native_object->next_loop_index, 1u, __ATOMIC_RELAXED);
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    carlie_tcp_server_event_loop_group_attachment_t *const attachment = &loop_data->event_loop_group_attachment;
+    attachment->group_loop = &group_native_object->loops[(first_group_loop_index + i) % group_native_object->loops_count];
+    attachment->loop_data = loop_data;
+    carlie_event_loop_group_post_command(attachment->group_loop, &attachment->command, carlie_tcp_server_handle_async_uv_event_loop_group_attach);
+  }
+}
+
+
+
 JNI_DEFINE_METHOD(void, bindUvTcpHandle)(jni_environment_handle_t environment,
                                          jni_object_t server_object,
                                          jni_object_t native_object_bytes,
@@ -654,7 +1265,7 @@ JNI_DEFINE_METHOD(void, bindUvTcpHandle)(jni_environment_handle_t environment,
   if (ip_address == null_ptr) {
     carlie_throw_null_pointer_exception(environment, native_object->null_pointer_exception_class, native_object->null_pointer_exception_constructor_method_id);
     int32_t uv_result;
-    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object, (uv_handle_t *) native_object->tcp_handle, null_ptr, &uv_result);
+    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close_tcp_handles(native_object, &uv_result);
     if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
       switch (carlie_result) {
         case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
@@ -686,7 +1297,7 @@ JNI_DEFINE_METHOD(void, bindUvTcpHandle)(jni_environment_handle_t environment,
   }
   if (uv_result < 0) {
     carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
-    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object, (uv_handle_t *) native_object->tcp_handle, null_ptr, &uv_result);
+    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close_tcp_handles(native_object, &uv_result);
     if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
       switch (carlie_result) {
         case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
@@ -710,10 +1321,31 @@ JNI_DEFINE_METHOD(void, bindUvTcpHandle)(jni_environment_handle_t environment,
       (struct sockaddr *) &socket_address_v6 :
       (struct sockaddr *) &socket_address_v4;
   uint32_t const uv_tcp_bind_flags = 0x00000000u;
-  uv_result = (int32_t) uv_tcp_bind(native_object->tcp_handle, socket_address_ptr, (unsigned int) uv_tcp_bind_flags);
+  // NOTE: With more than one loop, every loop’s listener is bound to the same
+  // address with `SO_REUSEPORT`, and the kernel spreads incoming connections
+  // across them. The first listener is bound to the requested address, and the
+  // others to whatever it ended up bound to, so that an arbitrary port (`0`)
+  // is only picked once.
+  struct sockaddr_storage bound_socket_address;
+  for (size_t i = 0u; i < native_object->listeners_count; i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    if (native_object->listeners_count > 1u) {
+      carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_open_reuse_port_socket(loop_data->tcp_handle, (int) socket_address_ptr->sa_family, &uv_result);
+      if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) break;
+    }
+    if (i == 0u) {
+      uv_result = (int32_t) uv_tcp_bind(loop_data->tcp_handle, socket_address_ptr, (unsigned int) uv_tcp_bind_flags);
+      if (uv_result < 0) break;
+      int bound_socket_address_size = (int) sizeof(bound_socket_address);
+      uv_result = (int32_t) uv_tcp_getsockname(loop_data->tcp_handle, (struct sockaddr *) &bound_socket_address, &bound_socket_address_size);
+    } else {
+      uv_result = (int32_t) uv_tcp_bind(loop_data->tcp_handle, (struct sockaddr *) &bound_socket_address, (unsigned int) uv_tcp_bind_flags);
+    }
+    if (uv_result < 0) break;
+  }
   if (uv_result < 0) {
     carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
-    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object, (uv_handle_t *) native_object->tcp_handle, null_ptr, &uv_result);
+    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close_tcp_handles(native_object, &uv_result);
     if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
       switch (carlie_result) {
         case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
@@ -765,6 +1397,65 @@ JNI_DEFINE_METHOD(void, closeUvTcpHandle)(jni_environment_handle_t environment,
 
 
 
+JNI_DEFINE_METHOD(jni_object_t, getIoRing)(jni_environment_handle_t environment,
+                                           jni_object_t server_object,
+                                           jni_object_t native_object_bytes,
+                                           jni_int_t loop_index,
+                                           jni_boolean_t is_completion_ring)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) loop_index) >= 0) &&
+         (((size_t) loop_index) < native_object->loops_count));
+  carlie_tcp_server_io_rings_t *const io_rings = &native_object->loops_data[(size_t) loop_index].io_rings;
+  assert(io_rings->is_enabled);
+  carlie_tcp_server_io_ring_t *const ring = (is_completion_ring) ?
+    &io_rings->completion_ring :
+    &io_rings->submission_ring;
+  jni_object_t const ring_object = environment[0]->NewDirectByteBuffer(environment, (void *) ring->memory, (jni_long_t) (CARLIE_TCP_SERVER_IO_RING_HEADER_SIZE + (CARLIE_TCP_SERVER_IO_RING_CAPACITY * CARLIE_TCP_SERVER_IO_RING_ENTRY_SIZE)));
+  if (ring_object == null_ptr) {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return null_ptr;
+  }
+  return ring_object;
+}
+
+
+
+JNI_DEFINE_METHOD(void, getRecordPoolCounts)(jni_environment_handle_t environment,
+                                             jni_object_t server_object,
+                                             jni_object_t native_object_bytes,
+                                             jni_long_array_t counts)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  carlie_tcp_server_record_pool_t *const record_pools[] = {
+    &native_object->async_uv_close_data_pool,
+    &native_object->async_uv_read_data_pool,
+    &native_object->async_uv_write_data_pool,
+    &native_object->close_connection_job_pool,
+  };
+  size_t const record_pools_count = sizeof(record_pools) / sizeof(record_pools[0]);
+  uint64_t total_hits_count = 0u;
+  uint64_t total_misses_count = 0u;
+  for (size_t i = 0u; i < record_pools_count; i++) {
+    uint64_t hits_count;
+    uint64_t misses_count;
+    carlie_tcp_server_record_pool_get_counts(record_pools[i], &hits_count, &misses_count);
+    total_hits_count += hits_count;
+    total_misses_count += misses_count;
+  }
+  jni_long_t const counts_values[] = {
+    (jni_long_t) total_hits_count,
+    (jni_long_t) total_misses_count,
+  };
+  environment[0]->SetLongArrayRegion(environment, counts, 0, 2, counts_values);
+}
+
+
+
 JNI_DEFINE_METHOD(jni_object_t, getUvTcpBoundAddress)(jni_environment_handle_t environment,
                                                       jni_object_t server_object,
                                                       jni_object_t native_object_bytes,
@@ -775,99 +1466,330 @@ JNI_DEFINE_METHOD(jni_object_t, getUvTcpBoundAddress)(jni_environment_handle_t e
   carlie_tcp_server_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
   jni_object_t address_object = null_ptr;
-  carlie_tcp_server_get_uv_address(environment, native_object, native_object->tcp_handle, uv_tcp_getsockname, create_address_method_function_object, create_address_method_function_class, &address_object);
+  carlie_tcp_server_get_uv_address(environment, native_object, native_object->loops_data[0].tcp_handle, uv_tcp_getsockname, create_address_method_function_object, create_address_method_function_class, &address_object);
   return address_object;
 }
 
 
 
-JNI_DEFINE_METHOD(void, initializeUvTcpHandle)(jni_environment_handle_t environment,
-                                               jni_object_t server_object,
-                                               jni_object_t native_object_bytes)
+JNI_DEFINE_METHOD(void, getWriteCounts)(jni_environment_handle_t environment,
+                                        jni_object_t server_object,
+                                        jni_object_t native_object_bytes,
+                                        jni_long_array_t counts)
 {
   CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
   carlie_tcp_server_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
-  int32_t uv_result;
-  uv_result = (int32_t) uv_tcp_init(native_object->loop_handle, native_object->tcp_handle);
-  if (uv_result < 0) {
-    carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
-    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object, (uv_handle_t *) native_object->tcp_handle, null_ptr, &uv_result);
-    if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
-      switch (carlie_result) {
-        case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
-          carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
-          return;
-        }
-        case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
-          carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
-          return;
-        }
-        default: {
-          // Unreachable in this case.
-          return;
-        }
-      }
-    }
-    return;
-  }
-  uv_handle_set_data((uv_handle_t *) native_object->tcp_handle, (void *) native_object);
+  jni_long_t const counts_values[] = {
+    (jni_long_t) __atomic_load_n(&native_object->pending_write_bytes_count, __ATOMIC_RELAXED),
+    (jni_long_t) __atomic_load_n(&native_object->unwritable_connections_count, __ATOMIC_RELAXED),
+  };
+  environment[0]->SetLongArrayRegion(environment, counts, 0, 2, counts_values);
 }
 
 
 
-JNI_DEFINE_METHOD(void, uvRun)(jni_environment_handle_t environment,
-                               jni_object_t server_object,
-                               jni_object_t native_object_bytes)
+JNI_DEFINE_METHOD(void, initializeAcceptBatches)(jni_environment_handle_t environment,
+                                                 jni_object_t server_object,
+                                                 jni_object_t native_object_bytes,
+                                                 jni_int_t accept_batch_capacity,
+                                                 jni_object_t accept_batch_sink_function_object,
+                                                 jni_class_t accept_batch_sink_function_class)
 {
   CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
   carlie_tcp_server_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
-  carlie_tcp_server_native_object_loop_data_t *const loop_data = calloc(1u, sizeof(carlie_tcp_server_native_object_loop_data_t));
-  if (loop_data == null_ptr) {
+  assert(((int32_t) accept_batch_capacity) > 0);
+  jni_method_id_t const accept_batch_sink_function_handle_clients_connected_batch_method_id = environment[0]->GetMethodID(environment, accept_batch_sink_function_class, "handleClientsConnectedBatch", "([Ljava/lang/Object;I)V");
+  if (accept_batch_sink_function_handle_clients_connected_batch_method_id == null_ptr) {
     carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
     return;
   }
-  // NOTE: It’s perfectly fine to save this environment in the loop, because the
-  // loop runs in a single thread (the current thread).
-  loop_data->environment = environment;
-  loop_data->server_native_object = native_object;
-  uv_loop_set_data(native_object->loop_handle, (void *) loop_data);
-  // NOTE: Saving the loop on the stack since the native object should be
-  // cleared by the time the loop stops running.
-  uv_loop_t *const loop_handle = native_object->loop_handle;
-  int32_t uv_result;
-  uv_result = (int32_t) uv_run(native_object->loop_handle, UV_RUN_DEFAULT);
-  assert(uv_result == 0);
-  free(loop_data);
-  uv_loop_set_data(loop_handle, null_ptr);
-  uv_result = (int32_t) uv_loop_close(loop_handle);
-  assert(uv_result != UV_EBUSY);
+  jni_class_t const object_class = environment[0]->FindClass(environment, "java/lang/Object");
+  if (object_class == null_ptr) {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return;
+  }
+  accept_batch_sink_function_object = environment[0]->NewGlobalRef(environment, accept_batch_sink_function_object);
+  if (accept_batch_sink_function_object == null_ptr) {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return;
+  }
+  native_object->accept_batch_sink_function_handle_clients_connected_batch_method_id = accept_batch_sink_function_handle_clients_connected_batch_method_id;
+  native_object->accept_batch_sink_function_object = accept_batch_sink_function_object;
+  // NOTE: Same as with completion batches, whatever gets created here before a
+  // failure is released along with the server, in `closeNative(…)`.
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_accept_batch_t *const batch = &native_object->loops_data[i].accept_batch;
+    jni_object_t const connections_array = (jni_object_t) environment[0]->NewObjectArray(environment, (jni_size_t) accept_batch_capacity, object_class, null_ptr);
+    if (connections_array == null_ptr) {
+      carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+      return;
+    }
+    batch->connections_array = environment[0]->NewGlobalRef(environment, connections_array);
+    environment[0]->DeleteLocalRef(environment, connections_array);
+    if (batch->connections_array == null_ptr) {
+      carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+      return;
+    }
+  }
+  environment[0]->DeleteLocalRef(environment, (jni_object_t) object_class);
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    carlie_tcp_server_accept_batch_t *const batch = &loop_data->accept_batch;
+    batch->check_handle = &batch->check_handle_;
+    int32_t uv_result;
+    uv_result = (int32_t) uv_check_init(loop_data->loop_handle, batch->check_handle);
+    if (uv_result < 0) {
+      carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+      return;
+    }
+    uv_result = (int32_t) uv_check_start(batch->check_handle, carlie_tcp_server_handle_uv_accept_batch_check);
+    assert(uv_result == 0);
+    // NOTE: Same as with completion batches, the check handle mustn’t keep the
+    // loop alive by itself.
+    uv_unref((uv_handle_t *) batch->check_handle);
+    batch->capacity = (size_t) (int32_t) accept_batch_capacity;
+    batch->count = 0u;
+    batch->is_enabled = true;
+  }
 }
 
 
 
-JNI_DEFINE_METHOD(void, uvTcpListen)(jni_environment_handle_t environment,
-                                     jni_object_t server_object,
-                                     jni_object_t native_object_bytes)
+JNI_DEFINE_METHOD(void, initializeIoCompletionBatches)(jni_environment_handle_t environment,
+                                                       jni_object_t server_object,
+                                                       jni_object_t native_object_bytes,
+                                                       jni_object_t io_completion_batch_sink_function_object,
+                                                       jni_class_t io_completion_batch_sink_function_class)
 {
   CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
   carlie_tcp_server_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
-  // Use `listen(2)` backlog of `511`, like Redis, Apache (the web server), etc.
-  uint16_t const tcp_listen_backlog = 511u;
-  int32_t uv_result;
-  uv_result = (int32_t) uv_listen((uv_stream_t *) native_object->tcp_handle, (int) tcp_listen_backlog, native_object->handle_uv_connection_received);
-  if (uv_result < 0) {
-    carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
-    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object, (uv_handle_t *) native_object->tcp_handle, null_ptr, &uv_result);
-    if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
-      switch (carlie_result) {
-        case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
-          carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
-          return;
-        }
-        case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+  jni_method_id_t const io_completion_batch_sink_function_handle_io_completed_batch_method_id = environment[0]->GetMethodID(environment, io_completion_batch_sink_function_class, "handleIoCompletedBatch", "([Ljava/lang/Object;[II)V");
+  if (io_completion_batch_sink_function_handle_io_completed_batch_method_id == null_ptr) {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return;
+  }
+  jni_class_t const object_class = environment[0]->FindClass(environment, "java/lang/Object");
+  if (object_class == null_ptr) {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return;
+  }
+  io_completion_batch_sink_function_object = environment[0]->NewGlobalRef(environment, io_completion_batch_sink_function_object);
+  if (io_completion_batch_sink_function_object == null_ptr) {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return;
+  }
+  native_object->io_completion_batch_sink_function_handle_io_completed_batch_method_id = io_completion_batch_sink_function_handle_io_completed_batch_method_id;
+  native_object->io_completion_batch_sink_function_object = io_completion_batch_sink_function_object;
+  // NOTE: Whatever gets created here before a failure is released along with
+  // the server, in `closeNative(…)`; the loops only start batching once all of
+  // them are ready to.
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_io_completion_batch_t *const batch = &native_object->loops_data[i].io_completion_batch;
+    jni_object_t const sinks_array = (jni_object_t) environment[0]->NewObjectArray(environment, (jni_size_t) CARLIE_TCP_SERVER_IO_COMPLETION_BATCH_CAPACITY, object_class, null_ptr);
+    jni_object_t const values_array = (jni_object_t) environment[0]->NewIntArray(environment, (jni_size_t) (CARLIE_TCP_SERVER_IO_COMPLETION_BATCH_CAPACITY * 3u));
+    batch->sinks_array = (sinks_array != null_ptr) ?
+      environment[0]->NewGlobalRef(environment, sinks_array) :
+      null_ptr;
+    batch->values_array = (values_array != null_ptr) ?
+      environment[0]->NewGlobalRef(environment, values_array) :
+      null_ptr;
+    if (sinks_array != null_ptr) {
+      environment[0]->DeleteLocalRef(environment, sinks_array);
+    }
+    if (values_array != null_ptr) {
+      environment[0]->DeleteLocalRef(environment, values_array);
+    }
+    if ((batch->sinks_array == null_ptr) ||
+        (batch->values_array == null_ptr)) {
+      carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+      return;
+    }
+  }
+  environment[0]->DeleteLocalRef(environment, (jni_object_t) object_class);
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    carlie_tcp_server_io_completion_batch_t *const batch = &loop_data->io_completion_batch;
+    batch->check_handle = &batch->check_handle_;
+    int32_t uv_result;
+    uv_result = (int32_t) uv_check_init(loop_data->loop_handle, batch->check_handle);
+    if (uv_result < 0) {
+      carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+      return;
+    }
+    uv_result = (int32_t) uv_check_start(batch->check_handle, carlie_tcp_server_handle_uv_io_completion_batch_check);
+    assert(uv_result == 0);
+    // NOTE: The check handle mustn’t keep the loop alive by itself; it gets
+    // closed along with everything else when the server closes.
+    uv_unref((uv_handle_t *) batch->check_handle);
+    batch->count = 0u;
+    batch->is_enabled = true;
+  }
+}
+
+
+
+JNI_DEFINE_METHOD(void, initializeIoRings)(jni_environment_handle_t environment,
+                                           jni_object_t server_object,
+                                           jni_object_t native_object_bytes,
+                                           jni_object_t io_ring_wake_up_function_object,
+                                           jni_class_t io_ring_wake_up_function_class)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  jni_method_id_t const io_ring_wake_up_function_handle_completions_available_method_id = environment[0]->GetMethodID(environment, io_ring_wake_up_function_class, "handleCompletionsAvailable", "(I)V");
+  if (io_ring_wake_up_function_handle_completions_available_method_id == null_ptr) {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return;
+  }
+  io_ring_wake_up_function_object = environment[0]->NewGlobalRef(environment, io_ring_wake_up_function_object);
+  if (io_ring_wake_up_function_object == null_ptr) {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return;
+  }
+  native_object->io_ring_wake_up_function_handle_completions_available_method_id = io_ring_wake_up_function_handle_completions_available_method_id;
+  native_object->io_ring_wake_up_function_object = io_ring_wake_up_function_object;
+  // NOTE: Same as for batches, whatever gets created here before a failure is
+  // released along with the server, in `closeNative(…)`.
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_io_rings_t *const io_rings = &native_object->loops_data[i].io_rings;
+    if ((! carlie_tcp_server_io_ring_initialize(&io_rings->submission_ring, true)) ||
+        (! carlie_tcp_server_io_ring_initialize(&io_rings->completion_ring, false))) {
+      carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+      return;
+    }
+  }
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    carlie_tcp_server_io_rings_t *const io_rings = &loop_data->io_rings;
+    io_rings->check_handle = &io_rings->check_handle_;
+    io_rings->prepare_handle = &io_rings->prepare_handle_;
+    int32_t uv_result;
+    uv_result = (int32_t) uv_check_init(loop_data->loop_handle, io_rings->check_handle);
+    if (uv_result < 0) {
+      carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+      return;
+    }
+    uv_result = (int32_t) uv_prepare_init(loop_data->loop_handle, io_rings->prepare_handle);
+    if (uv_result < 0) {
+      uv_close((uv_handle_t *) io_rings->check_handle, null_ptr);
+      carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+      return;
+    }
+    uv_result = (int32_t) uv_check_start(io_rings->check_handle, carlie_tcp_server_handle_uv_io_rings_check);
+    assert(uv_result == 0);
+    uv_result = (int32_t) uv_prepare_start(io_rings->prepare_handle, carlie_tcp_server_handle_uv_io_rings_prepare);
+    assert(uv_result == 0);
+    // NOTE: Neither handle may keep the loop alive by itself; they get closed
+    // along with everything else when the server closes.
+    uv_unref((uv_handle_t *) io_rings->check_handle);
+    uv_unref((uv_handle_t *) io_rings->prepare_handle);
+    io_rings->overflowed_completions = null_ptr;
+    io_rings->overflowed_completions_tail = null_ptr;
+    io_rings->is_enabled = true;
+  }
+}
+
+
+
+// NOTE: Either all of the server’s loops use io_uring, or none of them does;
+// returns whether they do. Any failure (most likely, a kernel that’s too old,
+// or that has io_uring disabled) means sticking with libuv.
+JNI_DEFINE_METHOD(jni_boolean_t, initializeIoUring)(jni_environment_handle_t environment,
+                                                    jni_object_t server_object,
+                                                    jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  size_t initialized_loops_count = 0u;
+  bool is_supported = true;
+  for (; initialized_loops_count < native_object->loops_count; initialized_loops_count++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[initialized_loops_count];
+    carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+    int32_t error_number;
+    is_supported = carlie_tcp_server_io_uring_initialize(&transport->ring, &error_number);
+    if (! is_supported) break;
+    transport->poll_handle = &transport->poll_handle_;
+    int32_t const uv_result = (int32_t) uv_poll_init(loop_data->loop_handle, transport->poll_handle, transport->ring.descriptor);
+    if (uv_result < 0) {
+      carlie_tcp_server_io_uring_destroy(&transport->ring);
+      is_supported = false;
+      break;
+    }
+  }
+  if (! is_supported) {
+    for (size_t i = 0u; i < initialized_loops_count; i++) {
+      carlie_tcp_server_io_uring_transport_t *const transport = &native_object->loops_data[i].io_uring_transport;
+      uv_close((uv_handle_t *) transport->poll_handle, null_ptr);
+      carlie_tcp_server_io_uring_destroy(&transport->ring);
+    }
+    return (jni_boolean_t) false;
+  }
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+    transport->check_handle = &transport->check_handle_;
+    transport->prepare_handle = &transport->prepare_handle_;
+    int32_t uv_result;
+    uv_result = (int32_t) uv_check_init(loop_data->loop_handle, transport->check_handle);
+    assert(uv_result == 0);
+    uv_result = (int32_t) uv_prepare_init(loop_data->loop_handle, transport->prepare_handle);
+    assert(uv_result == 0);
+    // NOTE: Check and prepare handles run in the reverse order they were
+    // started in, so these (started before any other) run last, and submit
+    // whatever the other handles queued.
+    uv_result = (int32_t) uv_check_start(transport->check_handle, carlie_tcp_server_handle_uv_io_uring_check);
+    assert(uv_result == 0);
+    uv_result = (int32_t) uv_prepare_start(transport->prepare_handle, carlie_tcp_server_handle_uv_io_uring_prepare);
+    assert(uv_result == 0);
+    uv_result = (int32_t) uv_poll_start(transport->poll_handle, UV_READABLE, carlie_tcp_server_handle_uv_io_uring_polled);
+    assert(uv_result == 0);
+    // NOTE: None of these handles may keep the loop alive by itself; they get
+    // closed along with everything else when the server closes.
+    uv_unref((uv_handle_t *) transport->check_handle);
+    uv_unref((uv_handle_t *) transport->prepare_handle);
+    uv_unref((uv_handle_t *) transport->poll_handle);
+    transport->listener_socket_descriptor = -1;
+    transport->operations_are_cancelled = false;
+    transport->operations_count = 0u;
+    transport->is_enabled = true;
+  }
+  return (jni_boolean_t) true;
+#else
+  return (jni_boolean_t) false;
+#endif
+}
+
+
+
+JNI_DEFINE_METHOD(void, initializeUvTcpHandle)(jni_environment_handle_t environment,
+                                               jni_object_t server_object,
+                                               jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  int32_t uv_result = 0;
+  for (size_t i = 0u; (i < native_object->listeners_count) && (uv_result >= 0); i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    uv_result = (int32_t) uv_tcp_init(loop_data->loop_handle, loop_data->tcp_handle);
+    uv_handle_set_data((uv_handle_t *) loop_data->tcp_handle, (void *) loop_data);
+  }
+  if (uv_result < 0) {
+    carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close_tcp_handles(native_object, &uv_result);
+    if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+      switch (carlie_result) {
+        case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+          carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+          return;
+        }
+        case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
           carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
           return;
         }
@@ -883,6 +1805,148 @@ JNI_DEFINE_METHOD(void, uvTcpListen)(jni_environment_handle_t environment,
 
 
 
+JNI_DEFINE_METHOD(void, setDefaultSocketOption)(jni_environment_handle_t environment,
+                                                jni_object_t server_object,
+                                                jni_object_t native_object_bytes,
+                                                jni_int_t option_id,
+                                                jni_int_t value)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) option_id) >= 0) &&
+         (((int32_t) option_id) < ((int32_t) CARLIE_TCP_SERVER_SOCKET_OPTIONS_COUNT)));
+  if (! carlie_tcp_server_socket_option_is_supported((int32_t) option_id)) {
+    carlie_tcp_server_throw_uv_exception(environment, native_object, UV_ENOTSUP);
+    return;
+  }
+  __atomic_store_n(&native_object->default_socket_option_values[(int32_t) option_id], (int32_t) value, __ATOMIC_RELAXED);
+  __atomic_or_fetch(&native_object->default_socket_options_mask, (UINT32_C(1) << ((int32_t) option_id)), __ATOMIC_RELEASE);
+}
+
+
+
+JNI_DEFINE_METHOD(void, setWriteWatermarks)(jni_environment_handle_t environment,
+                                            jni_object_t server_object,
+                                            jni_object_t native_object_bytes,
+                                            jni_long_t low_watermark,
+                                            jni_long_t high_watermark)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((low_watermark >= 0) &&
+         (low_watermark <= high_watermark));
+  __atomic_store_n(&native_object->write_low_watermark, (uint64_t) low_watermark, __ATOMIC_RELAXED);
+  __atomic_store_n(&native_object->write_high_watermark, (uint64_t) high_watermark, __ATOMIC_RELAXED);
+}
+
+
+
+JNI_DEFINE_METHOD(void, uvRun)(jni_environment_handle_t environment,
+                               jni_object_t server_object,
+                               jni_object_t native_object_bytes,
+                               jni_int_t loop_index)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) loop_index) >= 0) &&
+         (((size_t) loop_index) < native_object->loops_count));
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[(size_t) loop_index];
+  // NOTE: It’s perfectly fine to save this environment in the loop’s data,
+  // because the loop runs in a single thread (the current thread).
+  loop_data->environment = environment;
+  uv_loop_t *const loop_handle = loop_data->loop_handle;
+  uv_loop_set_data(loop_handle, (void *) loop_data);
+  int32_t const uv_result = (int32_t) uv_run(loop_handle, UV_RUN_DEFAULT);
+  assert(uv_result == 0);
+  carlie_tcp_server_finish_loop(loop_data);
+}
+
+
+
+JNI_DEFINE_METHOD(void, uvTcpListen)(jni_environment_handle_t environment,
+                                     jni_object_t server_object,
+                                     jni_object_t native_object_bytes,
+                                     jni_int_t listen_backlog)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  // NOTE: A backlog of `0` (or one beyond what the system allows) stands for
+  // the largest backlog the system allows.
+  int const maximum_tcp_listen_backlog = carlie_tcp_server_get_maximum_listen_backlog();
+  int const tcp_listen_backlog = ((((int32_t) listen_backlog) > 0) && (((int32_t) listen_backlog) < maximum_tcp_listen_backlog)) ?
+    (int) listen_backlog :
+    maximum_tcp_listen_backlog;
+  int32_t uv_result = 0;
+  for (size_t i = 0u; (i < native_object->listeners_count) && (uv_result >= 0); i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    uv_result = (loop_data->io_uring_transport.is_enabled) ?
+      carlie_tcp_server_listen_on_io_uring(loop_data, (int) tcp_listen_backlog) :
+      (int32_t) uv_listen((uv_stream_t *) loop_data->tcp_handle, (int) tcp_listen_backlog, native_object->handle_uv_connection_received);
+  }
+  if (uv_result < 0) {
+    carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close_tcp_handles(native_object, &uv_result);
+    if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+      switch (carlie_result) {
+        case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+          carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+          return;
+        }
+        case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+          carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+          return;
+        }
+        default: {
+          // Unreachable in this case.
+          return;
+        }
+      }
+    }
+    return;
+  }
+}
+
+
+
+JNI_DEFINE_METHOD(void, waitForUvLoops)(jni_environment_handle_t environment,
+                                        jni_object_t server_object,
+                                        jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  // NOTE: Each loop lets this know once it has torn itself down, whether it
+  // ran on a thread of its own or as part of an event loop group.
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    uv_sem_wait(&native_object->loops_stopped_semaphore);
+  }
+}
+
+
+
+// NOTE: The doorbell of a loop’s submission ring; only ever rung when the loop
+// said it’s about to block (see `carlie_tcp_server_arm_io_rings(…)`), or when
+// the JVM side made room for overflowed completions.
+JNI_DEFINE_METHOD(void, wakeUpUvLoop)(jni_environment_handle_t environment,
+                                      jni_object_t server_object,
+                                      jni_object_t native_object_bytes,
+                                      jni_int_t loop_index)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(server_object);
+  carlie_tcp_server_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) loop_index) >= 0) &&
+         (((size_t) loop_index) < native_object->loops_count));
+  int32_t const uv_result = (int32_t) uv_async_send(native_object->loops_data[(size_t) loop_index].command_queue_async_handle);
+  assert(uv_result == 0);
+}
+
+
+
 JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_boolean_t, initializeNative)(jni_environment_handle_t environment,
                                                                        jni_object_t connection_object,
                                                                        jni_object_t connection_native_object_bytes,
@@ -892,7 +1956,9 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_boolean_t, initializeNative)(jni_envir
                                                                        jni_object_t handle_closed_event_function_object,
                                                                        jni_class_t handle_closed_event_function_class,
                                                                        jni_object_t handle_error_occurred_event_function_object,
-                                                                       jni_class_t handle_error_occurred_event_function_class)
+                                                                       jni_class_t handle_error_occurred_event_function_class,
+                                                                       jni_object_t io_completion_sink_function_object,
+                                                                       jni_class_t io_completion_sink_function_class)
 {
   CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
   carlie_tcp_server_native_object_t * server_native_object = null_ptr;
@@ -902,21 +1968,28 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_boolean_t, initializeNative)(jni_envir
   jni_method_id_t const close_method_function_invoke_method_id = environment[0]->GetMethodID(environment, close_method_function_class, "invoke", "()Ljava/lang/Object;");
   jni_method_id_t const handle_closed_event_function_handle_method_id = environment[0]->GetMethodID(environment, handle_closed_event_function_class, "handle", "()V");
   jni_method_id_t const handle_error_occurred_event_function_handle_method_id = environment[0]->GetMethodID(environment, handle_error_occurred_event_function_class, "handle", "(Ljava/lang/Throwable;)V");
+  jni_method_id_t const io_completion_sink_function_handle_data_read_method_id = environment[0]->GetMethodID(environment, io_completion_sink_function_class, "handleDataRead", "(ILjava/nio/ByteBuffer;)V");
+  jni_method_id_t const io_completion_sink_function_handle_io_completed_method_id = environment[0]->GetMethodID(environment, io_completion_sink_function_class, "handleIoCompleted", "(III)V");
   if ((close_method_function_invoke_method_id == null_ptr) ||
       (handle_closed_event_function_handle_method_id == null_ptr) ||
-      (handle_error_occurred_event_function_handle_method_id == null_ptr)) {
+      (handle_error_occurred_event_function_handle_method_id == null_ptr) ||
+      (io_completion_sink_function_handle_data_read_method_id == null_ptr) ||
+      (io_completion_sink_function_handle_io_completed_method_id == null_ptr)) {
     return (jni_boolean_t) false;
   }
   close_method_function_object = environment[0]->NewGlobalRef(environment, close_method_function_object);
   handle_closed_event_function_object = environment[0]->NewGlobalRef(environment, handle_closed_event_function_object);
   handle_error_occurred_event_function_object = environment[0]->NewGlobalRef(environment, handle_error_occurred_event_function_object);
+  io_completion_sink_function_object = environment[0]->NewGlobalRef(environment, io_completion_sink_function_object);
   if ((close_method_function_object == null_ptr) ||
       (handle_closed_event_function_object == null_ptr) ||
-      (handle_error_occurred_event_function_object == null_ptr)) {
+      (handle_error_occurred_event_function_object == null_ptr) ||
+      (io_completion_sink_function_object == null_ptr)) {
     jni_object_t const global_object_references[] = {
       close_method_function_object,
       handle_closed_event_function_object,
       handle_error_occurred_event_function_object,
+      io_completion_sink_function_object,
     };
     size_t const global_object_references_count = sizeof(global_object_references) / sizeof(global_object_references[0]);
     for (size_t i = 0u; i < global_object_references_count; i++) {
@@ -935,6 +2008,9 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_boolean_t, initializeNative)(jni_envir
   connection_native_object->handle_closed_event_function_object = handle_closed_event_function_object;
   connection_native_object->handle_error_occurred_event_function_handle_method_id = handle_error_occurred_event_function_handle_method_id;
   connection_native_object->handle_error_occurred_event_function_object = handle_error_occurred_event_function_object;
+  connection_native_object->io_completion_sink_function_handle_data_read_method_id = io_completion_sink_function_handle_data_read_method_id;
+  connection_native_object->io_completion_sink_function_handle_io_completed_method_id = io_completion_sink_function_handle_io_completed_method_id;
+  connection_native_object->io_completion_sink_function_object = io_completion_sink_function_object;
   return (jni_boolean_t) true;
 }
 
@@ -951,6 +2027,7 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, closeNative)(jni_environment_handle_
     native_object->close_method_function_object,
     native_object->handle_closed_event_function_object,
     native_object->handle_error_occurred_event_function_object,
+    native_object->io_completion_sink_function_object,
   };
   size_t const global_object_references_count = sizeof(global_object_references) / sizeof(global_object_references[0]);
   for (size_t i = global_object_references_count; i > 0u;) {
@@ -960,7 +2037,6 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, closeNative)(jni_environment_handle_
     environment[0]->DeleteGlobalRef(environment, global_object_reference);
   }
   uv_handle_set_data((uv_handle_t *) native_object->tcp_handle, null_ptr);
-  uv_mutex_destroy(native_object->close_flag_mutex);
   // Zero out the native object by setting it to an empty one.
   native_object[0] = empty_carlie_tcp_server_connection_native_object;
 }
@@ -974,14 +2050,16 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, closeInUvWorker)(jni_environment_han
   CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
   carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
-  uv_work_t *const job_handle = calloc(1u, sizeof(uv_work_t));
+  uv_work_t *const job_handle = carlie_tcp_server_record_pool_acquire(&native_object->server_native_object->close_connection_job_pool);
   if (job_handle == null_ptr) {
     carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
     return;
   }
+  memset(job_handle, 0, sizeof(uv_work_t));
   uv_req_set_data((uv_req_t *) job_handle, (void *) native_object);
-  int32_t const uv_result = (int32_t) uv_queue_work(native_object->server_native_object->loop_handle, job_handle, carlie_tcp_server_uv_job_close_connection, carlie_tcp_server_uv_job_close_connection_completed);
+  int32_t const uv_result = (int32_t) uv_queue_work(native_object->loop_data->loop_handle, job_handle, carlie_tcp_server_uv_job_close_connection, carlie_tcp_server_uv_job_close_connection_completed);
   if (uv_result < 0) {
+    carlie_tcp_server_record_pool_release(&native_object->server_native_object->close_connection_job_pool, job_handle);
     carlie_tcp_server_connection_emit_uv_error_event(environment, native_object, uv_result);
     return;
   }
@@ -997,7 +2075,7 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, closeUvTcpHandle)(jni_environment_ha
   carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
   int32_t uv_result;
-  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object->server_native_object, (uv_handle_t *) native_object->tcp_handle, carlie_tcp_server_handle_uv_connection_closed, &uv_result);
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object->loop_data, (uv_handle_t *) native_object->tcp_handle, carlie_tcp_server_handle_uv_connection_closed, &uv_result);
   if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
     switch (carlie_result) {
       case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
@@ -1018,6 +2096,18 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, closeUvTcpHandle)(jni_environment_ha
 
 
 
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_int_t, getLoopIndex)(jni_environment_handle_t environment,
+                                                               jni_object_t connection_object,
+                                                               jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  return (jni_int_t) (int32_t) (native_object->loop_data - native_object->server_native_object->loops_data);
+}
+
+
+
 JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_object_t, getUvTcpBoundAddress)(jni_environment_handle_t environment,
                                                                           jni_object_t connection_object,
                                                                           jni_object_t native_object_bytes,
@@ -1058,10 +2148,10 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, initializeUvTcpHandle)(jni_environme
   carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
   int32_t uv_result;
-  uv_result = (int32_t) uv_tcp_init(native_object->server_native_object->loop_handle, native_object->tcp_handle);
+  uv_result = (int32_t) uv_tcp_init(native_object->loop_data->loop_handle, native_object->tcp_handle);
   if (uv_result < 0) {
     carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
-    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object->server_native_object, (uv_handle_t *) native_object->tcp_handle, null_ptr, &uv_result);
+    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(native_object->loop_data, (uv_handle_t *) native_object->tcp_handle, null_ptr, &uv_result);
     if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
       switch (carlie_result) {
         case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
@@ -1093,15 +2183,13 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_boolean_t, isCloseable)(jni_environmen
   CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
   carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
-  // TODO: Investigate this lock acquisition implementation. A quick glance at
-  // the source shows that there seems to be a possible case where this call
-  // would `abort()` the whole process; not good!
-  int32_t const uv_result = (int32_t) uv_mutex_trylock(native_object->close_flag_mutex);
-  if (uv_result != 0) {
-    return (jni_boolean_t) false;
+  // NOTE: A connection that is already closing (or closed) is reported as
+  // closeable, since closing it again is a no-op.
+  uint32_t const state = __atomic_load_n(&native_object->state, __ATOMIC_ACQUIRE);
+  if ((state & (CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSING | CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSED)) != 0u) {
+    return (jni_boolean_t) true;
   }
-  uv_mutex_unlock(native_object->close_flag_mutex);
-  return (jni_boolean_t) true;
+  return (jni_boolean_t) ((state & CARLIE_TCP_SERVER_CONNECTION_STATE_BUSY_MASK) == 0u);
 }
 
 
@@ -1137,24 +2225,312 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpEnableKeepAlive)(jni_environmen
 
 
 
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_int_t, uvTcpGetSocketOption)(jni_environment_handle_t environment,
+                                                                       jni_object_t connection_object,
+                                                                       jni_object_t native_object_bytes,
+                                                                       jni_int_t option_id)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  int32_t value = 0;
+  int32_t const uv_result = carlie_tcp_server_get_socket_option(native_object->tcp_handle, (int32_t) option_id, &value);
+  if (uv_result < 0) {
+    carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+    return (jni_int_t) 0;
+  }
+  return (jni_int_t) value;
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpPauseReading)(jni_environment_handle_t environment,
+                                                               jni_object_t connection_object,
+                                                               jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_read_pause(native_object, true, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
+  }
+}
+
+
+
 JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpRead)(jni_environment_handle_t environment,
                                                        jni_object_t connection_object,
                                                        jni_object_t native_object_bytes,
                                                        jni_byte_array_t buffer_bytes,
                                                        jni_int_t buffer_bytes_size,
-                                                       jni_object_t callback_function_object,
-                                                       jni_class_t callback_function_class)
+                                                       jni_int_t operation_id)
 {
   CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
   carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
-  jni_method_id_t const callback_function_invoke_method_id = environment[0]->GetMethodID(environment, callback_function_class, "invoke", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
-  if (callback_function_invoke_method_id == null_ptr) {
-    carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    return;
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_read(environment, native_object, buffer_bytes, null_ptr, 0u, (size_t) (int32_t) buffer_bytes_size, false, (int32_t) operation_id, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
+  }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpReadDirect)(jni_environment_handle_t environment,
+                                                             jni_object_t connection_object,
+                                                             jni_object_t native_object_bytes,
+                                                             jni_object_t buffer_object,
+                                                             jni_int_t buffer_offset,
+                                                             jni_int_t buffer_size,
+                                                             jni_int_t operation_id)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) buffer_offset) >= 0) &&
+         (((int32_t) buffer_size) >= 0) &&
+         ((((int64_t) buffer_offset) + ((int64_t) buffer_size)) <= ((int64_t) environment[0]->GetDirectBufferCapacity(environment, buffer_object))));
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_read(environment, native_object, null_ptr, buffer_object, (size_t) (int32_t) buffer_offset, (size_t) (int32_t) buffer_size, false, (int32_t) operation_id, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
+  }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpReadScattered)(jni_environment_handle_t environment,
+                                                                jni_object_t connection_object,
+                                                                jni_object_t native_object_bytes,
+                                                                jni_object_array_t buffer_objects,
+                                                                jni_int_array_t buffer_offsets,
+                                                                jni_int_array_t buffer_sizes,
+                                                                jni_int_t buffer_count,
+                                                                jni_int_t operation_id)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) buffer_count) > 0) &&
+         (((int32_t) buffer_count) <= ((int32_t) environment[0]->GetArrayLength(environment, buffer_objects))));
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_read_scattered(environment, native_object, buffer_objects, buffer_offsets, buffer_sizes, (size_t) (int32_t) buffer_count, (int32_t) operation_id, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
+  }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpRelay)(jni_environment_handle_t environment,
+                                                        jni_object_t connection_object,
+                                                        jni_object_t native_object_bytes,
+                                                        jni_object_t destination_native_object_bytes,
+                                                        jni_int_t operation_id)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  carlie_tcp_server_connection_native_object_t * destination_native_object = null_ptr;
+  carlie_get_native_object(environment, destination_native_object_bytes, (void **) &destination_native_object);
+  assert(native_object != destination_native_object);
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_relay(native_object, destination_native_object, (int32_t) operation_id, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
+  }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpResumeReading)(jni_environment_handle_t environment,
+                                                                jni_object_t connection_object,
+                                                                jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_read_pause(native_object, false, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
   }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpSendFile)(jni_environment_handle_t environment,
+                                                           jni_object_t connection_object,
+                                                           jni_object_t native_object_bytes,
+                                                           jni_object_t file_channel_object,
+                                                           jni_long_t position,
+                                                           jni_int_t count,
+                                                           jni_int_t operation_id)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int64_t) position) >= 0) &&
+         (((int32_t) count) > 0));
   int32_t uv_result;
-  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_read(environment, native_object, buffer_bytes, (size_t) (int32_t) buffer_bytes_size, callback_function_object, callback_function_invoke_method_id, &uv_result);
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_send_file(environment, native_object, file_channel_object, (int64_t) position, (size_t) (int32_t) count, (int32_t) operation_id, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
+  }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpSetSocketOption)(jni_environment_handle_t environment,
+                                                                  jni_object_t connection_object,
+                                                                  jni_object_t native_object_bytes,
+                                                                  jni_int_t option_id,
+                                                                  jni_int_t value)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  int32_t const uv_result = carlie_tcp_server_set_socket_option(native_object->tcp_handle, (int32_t) option_id, (int32_t) value);
+  if (uv_result < 0) {
+    carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+  }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpStartReading)(jni_environment_handle_t environment,
+                                                               jni_object_t connection_object,
+                                                               jni_object_t native_object_bytes,
+                                                               jni_int_t operation_id)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_read(environment, native_object, null_ptr, null_ptr, 0u, 0u, true, (int32_t) operation_id, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
+  }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpStopReading)(jni_environment_handle_t environment,
+                                                              jni_object_t connection_object,
+                                                              jni_object_t native_object_bytes)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_read_stop(native_object, &uv_result);
   if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
     switch (carlie_result) {
       case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
@@ -1180,19 +2556,85 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpWrite)(jni_environment_handle_t
                                                         jni_object_t native_object_bytes,
                                                         jni_byte_array_t buffer_bytes,
                                                         jni_int_t buffer_bytes_size,
-                                                        jni_object_t callback_function_object,
-                                                        jni_class_t callback_function_class)
+                                                        jni_int_t operation_id)
 {
   CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
   carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
   carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
-  jni_method_id_t const callback_function_invoke_method_id = environment[0]->GetMethodID(environment, callback_function_class, "invoke", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
-  if (callback_function_invoke_method_id == null_ptr) {
-    carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    return;
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_write(environment, native_object, buffer_bytes, null_ptr, 0u, (size_t) (int32_t) buffer_bytes_size, (int32_t) operation_id, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
   }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpWriteDirect)(jni_environment_handle_t environment,
+                                                              jni_object_t connection_object,
+                                                              jni_object_t native_object_bytes,
+                                                              jni_object_t buffer_object,
+                                                              jni_int_t buffer_offset,
+                                                              jni_int_t buffer_size,
+                                                              jni_int_t operation_id)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) buffer_offset) >= 0) &&
+         (((int32_t) buffer_size) >= 0) &&
+         ((((int64_t) buffer_offset) + ((int64_t) buffer_size)) <= ((int64_t) environment[0]->GetDirectBufferCapacity(environment, buffer_object))));
+  int32_t uv_result;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_write(environment, native_object, null_ptr, buffer_object, (size_t) (int32_t) buffer_offset, (size_t) (int32_t) buffer_size, (int32_t) operation_id, &uv_result);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    switch (carlie_result) {
+      case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+        carlie_throw_runtime_exception(environment, native_object->server_native_object->runtime_exception_class, native_object->server_native_object->runtime_exception_constructor_method_id);
+        return;
+      }
+      case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+        carlie_tcp_server_throw_uv_exception(environment, native_object->server_native_object, uv_result);
+        return;
+      }
+      default: {
+        // Unreachable in this case.
+        return;
+      }
+    }
+  }
+}
+
+
+
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpWriteGathered)(jni_environment_handle_t environment,
+                                                                jni_object_t connection_object,
+                                                                jni_object_t native_object_bytes,
+                                                                jni_object_array_t buffer_objects,
+                                                                jni_int_array_t buffer_offsets,
+                                                                jni_int_array_t buffer_sizes,
+                                                                jni_int_t buffer_count,
+                                                                jni_int_t operation_id)
+{
+  CARLIE_INTERNAL_UNUSED_SYMBOL(connection_object);
+  carlie_tcp_server_connection_native_object_t * native_object = null_ptr;
+  carlie_get_native_object(environment, native_object_bytes, (void **) &native_object);
+  assert((((int32_t) buffer_count) > 0) &&
+         (((int32_t) buffer_count) <= ((int32_t) environment[0]->GetArrayLength(environment, buffer_objects))));
   int32_t uv_result;
-  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_write(environment, native_object, buffer_bytes, (size_t) (int32_t) buffer_bytes_size, callback_function_object, callback_function_invoke_method_id, &uv_result);
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_write_gathered(environment, native_object, buffer_objects, buffer_offsets, buffer_sizes, (size_t) (int32_t) buffer_count, (int32_t) operation_id, &uv_result);
   if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
     switch (carlie_result) {
       case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
@@ -24,11 +24,31 @@
 
 
 #include <carlie/common.h>
+#include <carlie/event-loop-group/native-object.h>
+#include <carlie/tcp-server/buffer-pool.h>
+#include <carlie/tcp-server/command-queue.h>
+#include <carlie/tcp-server/io-ring.h>
+#include <carlie/tcp-server/io-uring.h>
+#include <carlie/tcp-server/record-pool.h>
+#include <errno.h>
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 #include <uv.h>
+#if ! defined(_WIN32)
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <stdio.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
 
 
 
@@ -47,10 +67,92 @@
 
 
 
+/*
+ *******************************************************************************
+ * Some useful macros.                                                         *
+ *******************************************************************************
+ */
+// NOTE: Scattered reads of up to this many buffers keep them in their read data
+// (as does every other read, which only has one).
+#define CARLIE_TCP_SERVER_ASYNC_UV_READ_DATA_INLINE_BUFFERS_COUNT 4u
+// NOTE: Writes of up to this many bytes are copied into their write data, and
+// gathered writes of up to this many buffers keep them in their write data.
+#define CARLIE_TCP_SERVER_ASYNC_UV_WRITE_DATA_INLINE_BYTES_SIZE 128u
+#define CARLIE_TCP_SERVER_ASYNC_UV_WRITE_DATA_INLINE_BUFFERS_COUNT 4u
+// NOTE: The bits of a connection’s state word. A connection is open when none
+// of them are set; it’s opening until its socket has been accepted, and it’s
+// reading or writing while the loop is in the middle of a read (that isn’t a
+// streaming one) or of a write. Only the loop’s thread changes the state, but
+// JVM threads look at it (see `isCloseable(…)`), so it’s accessed atomically.
+#define CARLIE_TCP_SERVER_CONNECTION_STATE_BUSY_MASK 7u
+#define CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSED 16u
+#define CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSING 8u
+#define CARLIE_TCP_SERVER_CONNECTION_STATE_OPEN 0u
+#define CARLIE_TCP_SERVER_CONNECTION_STATE_OPENING 1u
+#define CARLIE_TCP_SERVER_CONNECTION_STATE_READING 2u
+#define CARLIE_TCP_SERVER_CONNECTION_STATE_WRITING 4u
+// NOTE: A connection stops being writable once more than the high watermark’s
+// worth of bytes are waiting to be written on it, and becomes writable again
+// once no more than the low watermark’s worth are; these are the defaults.
+#define CARLIE_TCP_SERVER_DEFAULT_WRITE_HIGH_WATERMARK (64u * 1024u)
+#define CARLIE_TCP_SERVER_DEFAULT_WRITE_LOW_WATERMARK (32u * 1024u)
+// NOTE: The JVM side numbers a connection’s writes, from this operation ID on
+// (wrapping around back to it), in the order they’re issued; the loop starts
+// them in that same order (see `carlie_tcp_server_connection_start_writes(…)`).
+#define CARLIE_TCP_SERVER_FIRST_WRITE_OPERATION_ID 2
+// NOTE: The number of I/O completions a loop collects before it hands them to
+// the JVM side, even if the current loop iteration isn’t over yet.
+#define CARLIE_TCP_SERVER_IO_COMPLETION_BATCH_CAPACITY 256u
+// NOTE: The initial delay (in seconds) of keep-alive probes on accepted
+// connections; it’s what libuv used to apply back when keep-alive got enabled
+// before the connection’s socket was open.
+#define CARLIE_TCP_SERVER_KEEP_ALIVE_INITIAL_DELAY 60u
+// NOTE: A relay moves up to a pipe’s (default) capacity at a time, and at most
+// this many bytes per loop iteration, for the same reason as file transfers.
+// `splice(…)` is only declared with `_GNU_SOURCE`, so relays call it through
+// `syscall(…)`, with `SPLICE_F_MOVE | SPLICE_F_NONBLOCK` as its flags.
+#define CARLIE_TCP_SERVER_RELAY_BYTES_PER_TURN_COUNT (1024u * 1024u)
+#define CARLIE_TCP_SERVER_RELAY_CHUNK_SIZE (64u * 1024u)
+#define CARLIE_TCP_SERVER_RELAY_SPLICE_FLAGS 3u
+// NOTE: A file transfer sends at most this many bytes with `sendfile(…)` per
+// loop iteration, so that a single connection can’t hog its loop; after that
+// (or whenever the socket doesn’t take any more), it copies a chunk of up to
+// this many bytes and writes it with `uv_write(…)` instead.
+#define CARLIE_TCP_SERVER_SEND_FILE_BYTES_PER_TURN_COUNT (1024u * 1024u)
+#define CARLIE_TCP_SERVER_SEND_FILE_CHUNK_SIZE (64u * 1024u)
+// NOTE: The IDs of the socket options that can be set on connections (and as a
+// server’s defaults for the connections it accepts); they match the IDs of
+// `SocketOption`’s entries on the JVM side.
+#define CARLIE_TCP_SERVER_SOCKET_OPTION_LINGER 5
+#define CARLIE_TCP_SERVER_SOCKET_OPTION_NO_DELAY 0
+#define CARLIE_TCP_SERVER_SOCKET_OPTION_NOT_SENT_LOW_WATERMARK 6
+#define CARLIE_TCP_SERVER_SOCKET_OPTION_QUICK_ACK 3
+#define CARLIE_TCP_SERVER_SOCKET_OPTION_RECEIVE_BUFFER_SIZE 1
+#define CARLIE_TCP_SERVER_SOCKET_OPTION_SEND_BUFFER_SIZE 2
+#define CARLIE_TCP_SERVER_SOCKET_OPTION_USER_TIMEOUT 4
+#define CARLIE_TCP_SERVER_SOCKET_OPTIONS_COUNT 7u
+// NOTE: The operation ID a connection’s writability changes are reported with,
+// through the same path as its completions (rings included); it must not clash
+// with `CARLIE_TCP_SERVER_IO_RING_CLOSED_OPERATION_ID`.
+#define CARLIE_TCP_SERVER_WRITABILITY_CHANGED_OPERATION_ID (-2)
+
+
+
+typedef struct _carlie_tcp_server_accept_batch carlie_tcp_server_accept_batch_t;
 typedef struct _carlie_tcp_server_async_uv_close_data carlie_tcp_server_async_uv_close_data_t;
 typedef struct _carlie_tcp_server_async_uv_read_data carlie_tcp_server_async_uv_read_data_t;
+typedef struct _carlie_tcp_server_async_uv_read_pause_data carlie_tcp_server_async_uv_read_pause_data_t;
+typedef struct _carlie_tcp_server_async_uv_read_stop_data carlie_tcp_server_async_uv_read_stop_data_t;
+typedef struct _carlie_tcp_server_async_uv_relay_data carlie_tcp_server_async_uv_relay_data_t;
+typedef struct _carlie_tcp_server_async_uv_send_file_data carlie_tcp_server_async_uv_send_file_data_t;
 typedef struct _carlie_tcp_server_async_uv_write_data carlie_tcp_server_async_uv_write_data_t;
+typedef struct _carlie_tcp_server_connection_handoff_data carlie_tcp_server_connection_handoff_data_t;
 typedef struct _carlie_tcp_server_connection_native_object carlie_tcp_server_connection_native_object_t;
+typedef struct _carlie_tcp_server_event_loop_group_attachment carlie_tcp_server_event_loop_group_attachment_t;
+typedef struct _carlie_tcp_server_io_completion_batch carlie_tcp_server_io_completion_batch_t;
+typedef struct _carlie_tcp_server_io_rings carlie_tcp_server_io_rings_t;
+typedef struct _carlie_tcp_server_io_rings_overflowed_completion carlie_tcp_server_io_rings_overflowed_completion_t;
+typedef struct _carlie_tcp_server_io_uring_transport carlie_tcp_server_io_uring_transport_t;
 typedef struct _carlie_tcp_server_native_object carlie_tcp_server_native_object_t;
 typedef struct _carlie_tcp_server_native_object_loop_data carlie_tcp_server_native_object_loop_data_t;
 
@@ -70,6 +172,7 @@ typedef enum {
 
 
 struct _carlie_tcp_server_async_uv_close_data {
+  carlie_tcp_server_command_t command;
   uv_close_cb callback;
   uv_handle_t * handle;
 };
@@ -77,38 +180,171 @@ struct _carlie_tcp_server_async_uv_close_data {
 
 
 struct _carlie_tcp_server_async_uv_read_data {
-  uv_async_t * async_handle;
+  carlie_tcp_server_command_t command;
   uint8_t * buffer;
   jni_byte_array_t buffer_array;
-  size_t buffer_size;
-  jni_method_id_t callback_function_invoke_method_id;
-  jni_object_t callback_function_object;
+  size_t buffer_count;
+  size_t buffer_index;
+  uv_buf_t * buffers;
+  uv_buf_t buffers_[CARLIE_TCP_SERVER_ASYNC_UV_READ_DATA_INLINE_BUFFERS_COUNT];
+  size_t bytes_read_count;
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  struct msghdr io_uring_message;
+#endif
+  // NOTE: Whether the read is on hold, because reading got paused, after which
+  // it’s started back up once reading resumes.
+  bool is_parked;
+  bool is_stopping;
+  bool is_streaming;
+  carlie_tcp_server_connection_native_object_t * native_object;
+  int32_t operation_id;
+  size_t read_buffer_pool_size_class_index;
+  bool uses_io_uring;
+};
+
+
+
+struct _carlie_tcp_server_async_uv_read_pause_data {
+  carlie_tcp_server_command_t command;
+  bool is_paused;
+  carlie_tcp_server_connection_native_object_t * native_object;
+};
+
+
+
+struct _carlie_tcp_server_async_uv_read_stop_data {
+  carlie_tcp_server_command_t command;
+  carlie_tcp_server_connection_native_object_t * native_object;
+};
+
+
+
+// NOTE: A relay from a connection (the source, on whose loop the relay runs)
+// to another one (the destination, which may be served by another loop). It
+// works on duplicates of both sockets, so that it can poll them without
+// getting in libuv’s way, and moves the data through a pipe with `splice(…)`,
+// so that it never leaves the kernel (or through `buffer`, other than on
+// Linux). The buffered bytes are the ones read from the source, but not yet
+// written to the destination. Its memory goes once its handles are closed.
+struct _carlie_tcp_server_async_uv_relay_data {
+  carlie_tcp_server_command_t command;
+  uint8_t * buffer;
+  size_t buffered_bytes_count;
+  size_t buffered_bytes_offset;
+  carlie_tcp_server_connection_native_object_t * destination_native_object;
+  uv_poll_t * destination_poll_handle;
+  uv_poll_t destination_poll_handle_;
+  int destination_socket_descriptor;
+  int32_t error_number;
+  size_t handles_count;
+  carlie_tcp_server_native_object_loop_data_t * loop_data;
+  carlie_tcp_server_connection_native_object_t * native_object;
+  carlie_tcp_server_async_uv_relay_data_t * next_relay;
+  int32_t operation_id;
+  int pipe_descriptors[2];
+  carlie_tcp_server_async_uv_relay_data_t * previous_relay;
+  uv_poll_t * source_poll_handle;
+  uv_poll_t source_poll_handle_;
+  int source_socket_descriptor;
+  bool waits_for_destination;
+};
+
+
+
+// NOTE: The file descriptor is a duplicate, owned by the transfer; the chunk
+// only gets allocated once part of the file has to be written with
+// `uv_write(…)` (see `carlie_tcp_server_send_file(…)`).
+struct _carlie_tcp_server_async_uv_send_file_data {
+  carlie_tcp_server_command_t command;
+  size_t bytes_count;
+  size_t bytes_sent_count;
+  uint8_t * chunk;
+  uv_buf_t chunk_buffer;
+  int file_descriptor;
+  int64_t file_offset;
   carlie_tcp_server_connection_native_object_t * native_object;
+  int32_t operation_id;
+  bool sendfile_is_unsupported;
+  uv_write_t write_request;
 };
 
 
 
 struct _carlie_tcp_server_async_uv_write_data {
+  carlie_tcp_server_command_t command;
   uv_buf_t * buffer;
   jni_byte_array_t buffer_array;
-  jni_method_id_t callback_function_invoke_method_id;
-  jni_object_t callback_function_object;
+  size_t buffer_count;
+  uv_buf_t buffers_[CARLIE_TCP_SERVER_ASYNC_UV_WRITE_DATA_INLINE_BUFFERS_COUNT];
+  uint8_t bytes_[CARLIE_TCP_SERVER_ASYNC_UV_WRITE_DATA_INLINE_BYTES_SIZE];
+  size_t bytes_count;
+  // NOTE: Only kept track of for sends through io_uring, which may come up
+  // short; libuv doesn’t report the progress of its write requests.
+  size_t bytes_written_count;
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  struct iovec io_uring_buffer;
+  struct msghdr io_uring_message;
+#endif
   carlie_tcp_server_connection_native_object_t * native_object;
+  // NOTE: Links the write into its connection’s out-of-order writes, or into
+  // its io_uring write queue.
+  carlie_tcp_server_async_uv_write_data_t * next_write_data;
+  int32_t operation_id;
+  uv_write_t write_request;
+};
+
+
+
+// NOTE: A connection accepted by one loop, on its way to the loop that’ll serve
+// it: it’s accepted into `tcp_handle_` (on the accepting loop), and its socket
+// is duplicated, so that the handle can be closed there and the duplicate
+// handed over, as a command, to the serving loop.
+struct _carlie_tcp_server_connection_handoff_data {
+  carlie_tcp_server_command_t command;
+  carlie_tcp_server_native_object_loop_data_t * loop_data;
+  int socket_descriptor;
+  uv_tcp_t tcp_handle_;
 };
 
 
 
 struct _carlie_tcp_server_connection_native_object {
-  uv_mutex_t * close_flag_mutex;
-  uv_mutex_t close_flag_mutex_;
   jni_method_id_t close_method_function_invoke_method_id;
   jni_object_t close_method_function_object;
   jni_method_id_t handle_closed_event_function_handle_method_id;
   jni_object_t handle_closed_event_function_object;
   jni_method_id_t handle_error_occurred_event_function_handle_method_id;
   jni_object_t handle_error_occurred_event_function_object;
+  jni_method_id_t io_completion_sink_function_handle_data_read_method_id;
+  jni_method_id_t io_completion_sink_function_handle_io_completed_method_id;
+  jni_object_t io_completion_sink_function_object;
+  bool io_uring_operations_are_cancelled;
+  size_t io_uring_operations_count;
+  // NOTE: At most one send goes through io_uring at a time per connection,
+  // since sends on the same socket aren’t ordered by the kernel (and a short
+  // one gets resubmitted); it’s the head of this queue, and the writes behind
+  // it wait for it to complete. Only ever touched on the loop’s thread.
+  carlie_tcp_server_async_uv_write_data_t * io_uring_write_queue_head;
+  carlie_tcp_server_async_uv_write_data_t * io_uring_write_queue_tail;
+  bool is_writable;
   carlie_tcp_server_async_uv_read_data_t * latest_async_uv_read_data;
+  carlie_tcp_server_native_object_loop_data_t * loop_data;
+  // NOTE: The operation ID of the write the connection expects next, and the
+  // writes that reached the loop ahead of it (in no particular order); only
+  // ever touched on the loop’s thread.
+  int32_t next_write_operation_id;
+  carlie_tcp_server_async_uv_write_data_t * out_of_order_writes;
+  // NOTE: The number of bytes handed to libuv (or io_uring) for writing that
+  // haven’t been written yet; only ever touched on the loop’s thread.
+  size_t pending_write_bytes_count;
+  // NOTE: Only ever touched on the loop’s thread.
+  bool reading_is_paused;
+  // NOTE: The connection’s own relay (if any), and the number of relays into
+  // it, which may run on other loops (hence updated atomically).
+  carlie_tcp_server_async_uv_relay_data_t * relay;
+  size_t relays_count;
   carlie_tcp_server_native_object_t * server_native_object;
+  uint32_t state;
   uv_tcp_t * tcp_handle;
   uv_tcp_t tcp_handle_;
   bool tcp_handle_is_initialized;
@@ -116,11 +352,121 @@ struct _carlie_tcp_server_connection_native_object {
 
 
 
+// NOTE: What ties one of a server’s loops to one of a group’s loops: the
+// server’s loop gets embedded in the group’s loop by polling its backend (see
+// `uv_backend_fd(…)`), and by running it, without blocking, whenever that has
+// anything to report.
+struct _carlie_tcp_server_event_loop_group_attachment {
+  carlie_tcp_server_command_t command;
+  carlie_event_loop_group_loop_t * group_loop;
+  carlie_tcp_server_native_object_loop_data_t * loop_data;
+  uv_poll_t * poll_handle;
+  uv_poll_t poll_handle_;
+};
+
+
+
+// NOTE: Same as with completions, a loop can collect the connections it
+// accepts here, rather than calling into the JVM once per connection, and hand
+// them all over in a single call from a check handle (or as soon as the batch
+// is full). Each batch holds up to `capacity` connections.
+struct _carlie_tcp_server_accept_batch {
+  size_t capacity;
+  uv_check_t * check_handle;
+  uv_check_t check_handle_;
+  jni_object_t connections_array;
+  size_t count;
+  bool is_enabled;
+};
+
+
+
+// NOTE: Rather than calling into the JVM once per completed read or write, a
+// loop can collect its completions here (the connections’ sinks in one array,
+// and their operation IDs, results and error numbers, three by three, in the
+// other), and hand them all over in a single call from a check handle, i.e.,
+// once per loop iteration, right after polling for I/O.
+struct _carlie_tcp_server_io_completion_batch {
+  uv_check_t * check_handle;
+  uv_check_t check_handle_;
+  size_t count;
+  bool is_enabled;
+  jni_object_t sinks_array;
+  int32_t values[CARLIE_TCP_SERVER_IO_COMPLETION_BATCH_CAPACITY * 3u];
+  jni_object_t values_array;
+};
+
+
+
+// NOTE: A loop’s rings, shared with the JVM side: JVM threads put reads,
+// writes and closes into the submission ring without calling into the native
+// layer, and the loop puts its completions into the completion ring, which a
+// JVM thread of its own consumes. Either side only gets woken up (by a JNI
+// call) when it said it’s about to go idle, through the ring’s
+// `needs_wake_up` word. Completions that don’t fit into the completion ring
+// wait in a list until the JVM side makes room for them.
+struct _carlie_tcp_server_io_rings {
+  uv_check_t * check_handle;
+  uv_check_t check_handle_;
+  carlie_tcp_server_io_ring_t completion_ring;
+  bool is_enabled;
+  carlie_tcp_server_io_rings_overflowed_completion_t * overflowed_completions;
+  carlie_tcp_server_io_rings_overflowed_completion_t * overflowed_completions_tail;
+  uv_prepare_t * prepare_handle;
+  uv_prepare_t prepare_handle_;
+  carlie_tcp_server_io_ring_t submission_ring;
+};
+
+
+
+struct _carlie_tcp_server_io_rings_overflowed_completion {
+  carlie_tcp_server_io_ring_completion_entry_t entry;
+  carlie_tcp_server_io_rings_overflowed_completion_t * next_completion;
+};
+
+
+
+// NOTE: A loop’s io_uring, when the server uses that transport: the loop
+// still is a libuv loop (for its timers, commands, etc.), but its sockets’
+// reads, writes and accepts go through the ring, whose descriptor the loop
+// polls for completions. Entries queued during a round of callbacks get
+// submitted all at once, by a check handle (after polling for I/O) and a
+// prepare handle (before polling for I/O). The operation counts are those of
+// the operations the kernel still has (or will have) in its hands.
+struct _carlie_tcp_server_io_uring_transport {
+  carlie_tcp_server_command_t accept_command;
+  uv_check_t * check_handle;
+  uv_check_t check_handle_;
+  bool is_enabled;
+  int listener_socket_descriptor;
+  bool operations_are_cancelled;
+  size_t operations_count;
+  uv_poll_t * poll_handle;
+  uv_poll_t poll_handle_;
+  uv_prepare_t * prepare_handle;
+  uv_prepare_t prepare_handle_;
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_io_uring_t ring;
+#endif
+};
+
+
+
 struct _carlie_tcp_server_native_object {
+  jni_method_id_t accept_batch_sink_function_handle_clients_connected_batch_method_id;
+  jni_object_t accept_batch_sink_function_object;
+  carlie_tcp_server_record_pool_t async_uv_close_data_pool;
+  carlie_tcp_server_record_pool_t async_uv_read_data_pool;
+  carlie_tcp_server_record_pool_t async_uv_write_data_pool;
+  carlie_tcp_server_record_pool_t close_connection_job_pool;
   jni_method_id_t create_connection_method_function_invoke_method_id;
   jni_object_t create_connection_method_function_object;
   jni_method_id_t create_connection_native_object_static_method_function_invoke_method_id;
   jni_object_t create_connection_native_object_static_method_function_object;
+  // NOTE: Set from JVM threads and read on the loops’ threads, whenever they
+  // accept a connection; an option’s value is stored before its bit is set.
+  int32_t default_socket_option_values[CARLIE_TCP_SERVER_SOCKET_OPTIONS_COUNT];
+  uint32_t default_socket_options_mask;
   jni_method_id_t handle_client_connected_event_function_handle_method_id;
   jni_object_t handle_client_connected_event_function_object;
   jni_method_id_t handle_closed_event_function_handle_method_id;
@@ -130,23 +476,59 @@ struct _carlie_tcp_server_native_object {
   uv_connection_cb handle_uv_connection_received;
   jni_class_t integer_class;
   jni_method_id_t integer_constructor_method_id;
+  jni_method_id_t io_completion_batch_sink_function_handle_io_completed_batch_method_id;
+  jni_object_t io_completion_batch_sink_function_object;
+  jni_method_id_t io_ring_wake_up_function_handle_completions_available_method_id;
+  jni_object_t io_ring_wake_up_function_object;
   jni_java_vm_t * java_vm;
-  uv_loop_t * loop_handle;
+  size_t listeners_count;
+  carlie_tcp_server_native_object_loop_data_t * loops_data;
+  size_t loops_count;
+  uv_sem_t loops_stopped_semaphore;
+  size_t next_serving_loop_index;
   jni_class_t null_pointer_exception_class;
   jni_method_id_t null_pointer_exception_constructor_method_id;
+  size_t open_loops_count;
+  // NOTE: Totals across all the server’s connections (and loops), hence updated
+  // atomically.
+  uint64_t pending_write_bytes_count;
   jni_class_t runtime_exception_class;
   jni_method_id_t runtime_exception_constructor_method_id;
-  uv_tcp_t * tcp_handle;
-  uv_tcp_t tcp_handle_;
+  uint64_t unwritable_connections_count;
   jni_class_t uv_exception_class;
   jni_method_id_t uv_exception_constructor_method_id;
+  bool uses_acceptor_handoff;
+  // NOTE: Set from JVM threads and read on the loops’ threads.
+  uint64_t write_high_watermark;
+  uint64_t write_low_watermark;
 };
 
 
 
+// NOTE: Everything that belongs to a single loop (and is only ever touched on
+// that loop’s thread, apart from pushing commands) lives here; a server has
+// one of these per loop, each with its own listener. Every loop is a loop of
+// its own (never `uv_default_loop()`), so that servers don’t share loops, or
+// each other’s loop data, even when they share an event loop group’s threads.
 struct _carlie_tcp_server_native_object_loop_data {
+  carlie_tcp_server_accept_batch_t accept_batch;
+  carlie_tcp_server_command_queue_t command_queue;
+  uv_async_t * command_queue_async_handle;
+  uv_async_t command_queue_async_handle_;
   jni_environment_handle_t environment;
+  carlie_tcp_server_event_loop_group_attachment_t event_loop_group_attachment;
+  carlie_tcp_server_io_completion_batch_t io_completion_batch;
+  carlie_tcp_server_io_rings_t io_rings;
+  carlie_tcp_server_io_uring_transport_t io_uring_transport;
+  uv_loop_t * loop_handle;
+  uv_loop_t loop_handle_;
+  carlie_tcp_server_buffer_pool_t read_buffer_pool;
+  carlie_tcp_server_async_uv_relay_data_t * relays;
+  carlie_tcp_server_command_t server_close_command;
   carlie_tcp_server_native_object_t * server_native_object;
+  uv_tcp_t * tcp_handle;
+  uv_tcp_t tcp_handle_;
+  bool tcp_handle_is_listener;
 };
 
 
@@ -156,25 +538,88 @@ static carlie_tcp_server_native_object_t const empty_carlie_tcp_server_native_ob
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_apply_default_socket_options(carlie_tcp_server_native_object_t *const server_native_object,
+                                               carlie_tcp_server_connection_native_object_t *const connection_native_object);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_arm_io_rings(carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_async_uv_close(carlie_tcp_server_native_object_t *const native_object,
+carlie_tcp_server_async_uv_close(carlie_tcp_server_native_object_loop_data_t *const loop_data,
                                  uv_handle_t *const handle,
                                  uv_close_cb const callback,
                                  int32_t *const uv_result_ptr);
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_close_tcp_handles(carlie_tcp_server_native_object_t *const native_object,
+                                             int32_t *const uv_result_ptr);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
 carlie_tcp_server_async_uv_read(jni_environment_handle_t const environment,
                                 carlie_tcp_server_connection_native_object_t *const native_object,
                                 jni_byte_array_t buffer_bytes,
+                                jni_object_t buffer_object,
+                                size_t const buffer_offset,
                                 size_t const buffer_bytes_size,
-                                jni_object_t callback_function_object,
-                                jni_method_id_t const callback_function_invoke_method_id,
+                                bool const is_streaming,
+                                int32_t const operation_id,
                                 int32_t *const uv_result_ptr);
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_read_scattered(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_connection_native_object_t *const native_object,
+                                          jni_object_array_t buffer_objects,
+                                          jni_int_array_t const buffer_offsets,
+                                          jni_int_array_t const buffer_sizes,
+                                          size_t const buffer_count,
+                                          int32_t const operation_id,
+                                          int32_t *const uv_result_ptr);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_read_pause(carlie_tcp_server_connection_native_object_t *const native_object,
+                                      bool const is_paused,
+                                      int32_t *const uv_result_ptr);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_read_stop(carlie_tcp_server_connection_native_object_t *const native_object,
+                                     int32_t *const uv_result_ptr);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_relay(carlie_tcp_server_connection_native_object_t *const native_object,
+                                 carlie_tcp_server_connection_native_object_t *const destination_native_object,
+                                 int32_t const operation_id,
+                                 int32_t *const uv_result_ptr);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_send_file(jni_environment_handle_t const environment,
+                                     carlie_tcp_server_connection_native_object_t *const native_object,
+                                     jni_object_t const file_channel_object,
+                                     int64_t const file_offset,
+                                     size_t const bytes_count,
+                                     int32_t const operation_id,
+                                     int32_t *const uv_result_ptr);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
 carlie_tcp_server_async_uv_server_close(carlie_tcp_server_native_object_t *const native_object,
                                         int32_t *const uv_result_ptr);
@@ -185,13 +630,91 @@ CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
 carlie_tcp_server_async_uv_write(jni_environment_handle_t const environment,
                                  carlie_tcp_server_connection_native_object_t *const native_object,
                                  jni_byte_array_t buffer_bytes,
+                                 jni_object_t buffer_object,
+                                 size_t const buffer_offset,
                                  size_t const buffer_bytes_size,
-                                 jni_object_t callback_function_object,
-                                 jni_method_id_t const callback_function_invoke_method_id,
+                                 int32_t const operation_id,
                                  int32_t *const uv_result_ptr);
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_write_gathered(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_connection_native_object_t *const native_object,
+                                          jni_object_array_t buffer_objects,
+                                          jni_int_array_t const buffer_offsets,
+                                          jni_int_array_t const buffer_sizes,
+                                          size_t const buffer_count,
+                                          int32_t const operation_id,
+                                          int32_t *const uv_result_ptr);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_cancel_io_uring_operations(jni_environment_handle_t const environment,
+                                             carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                             carlie_tcp_server_connection_native_object_t *const native_object);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_cancel_io_uring_read(jni_environment_handle_t const environment,
+                                       carlie_tcp_server_async_uv_read_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_close_socket(int const socket_descriptor);
+
+
+
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_complete_io_uring_accept(jni_environment_handle_t const environment,
+                                           carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                           int32_t const result,
+                                           uint32_t const flags);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_complete_io_uring_read(jni_environment_handle_t const environment,
+                                         carlie_tcp_server_async_uv_read_data_t *const data,
+                                         int32_t result,
+                                         uint32_t const flags);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_complete_io_uring_write(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_async_uv_write_data_t *const data,
+                                          int32_t const result);
+#endif
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_add_pending_write_bytes(jni_environment_handle_t const environment,
+                                                     carlie_tcp_server_connection_native_object_t *const native_object,
+                                                     size_t const bytes_count);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_complete_io(jni_environment_handle_t const environment,
+                                         carlie_tcp_server_connection_native_object_t *const native_object,
+                                         int32_t const operation_id,
+                                         int32_t const result,
+                                         int32_t const error_number);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_connection_stop_streaming_read(jni_environment_handle_t const environment,
+                                                 carlie_tcp_server_connection_native_object_t *const native_object);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
 carlie_tcp_server_connection_emit_uv_error_event(jni_environment_handle_t const environment,
                                                  carlie_tcp_server_connection_native_object_t *const native_object,
@@ -199,9 +722,57 @@ carlie_tcp_server_connection_emit_uv_error_event(jni_environment_handle_t const
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_connection_enter_state(carlie_tcp_server_connection_native_object_t *const native_object,
+                                         uint32_t const state);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_hand_over_read_data(jni_environment_handle_t const environment,
+                                                 carlie_tcp_server_connection_native_object_t *const native_object,
+                                                 int32_t const operation_id,
+                                                 uint8_t *const bytes,
+                                                 size_t const bytes_count);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_leave_state(carlie_tcp_server_connection_native_object_t *const native_object,
+                                         uint32_t const state);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_remove_pending_write_bytes(jni_environment_handle_t const environment,
+                                                        carlie_tcp_server_connection_native_object_t *const native_object,
+                                                        size_t const bytes_count);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_set_writability(jni_environment_handle_t const environment,
+                                             carlie_tcp_server_connection_native_object_t *const native_object,
+                                             bool const is_writable);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_start_writes(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_connection_native_object_t *const native_object,
+                                          carlie_tcp_server_async_uv_write_data_t * data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_async_uv_write_data_t *
+carlie_tcp_server_connection_take_next_write(carlie_tcp_server_connection_native_object_t *const native_object,
+                                             int32_t const operation_id);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
 carlie_tcp_server_create_connection_native_object(jni_environment_handle_t const environment,
-                                                  carlie_tcp_server_native_object_t *const server_native_object,
+                                                  carlie_tcp_server_native_object_loop_data_t *const loop_data,
                                                   jni_object_t *const connection_native_object_bytes_ptr,
                                                   carlie_tcp_server_connection_native_object_t **const connection_native_object_ptr);
 
@@ -215,6 +786,59 @@ carlie_tcp_server_create_uv_exception(jni_environment_handle_t const environment
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_async_uv_read_data(carlie_tcp_server_async_uv_read_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_async_uv_relay_data(carlie_tcp_server_async_uv_relay_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_async_uv_send_file_data(carlie_tcp_server_async_uv_send_file_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_async_uv_write_data(carlie_tcp_server_async_uv_write_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_deliver_io_ring_completion(jni_environment_handle_t const environment,
+                                             carlie_tcp_server_io_ring_completion_entry_t const *const entry);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_io_rings(carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_io_uring_transport(carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_loop_data(carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_drain_io_rings(jni_environment_handle_t const environment,
+                                 carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_duplicate_socket(uv_tcp_t *const tcp_handle,
+                                   int *const socket_descriptor_ptr);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
 carlie_tcp_server_emit_uv_error_event(jni_environment_handle_t const environment,
                                       carlie_tcp_server_native_object_t *const native_object,
@@ -222,12 +846,60 @@ carlie_tcp_server_emit_uv_error_event(jni_environment_handle_t const environment
 
 
 
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_finish_loop(carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_flush_accept_batch(jni_environment_handle_t const environment,
+                                     carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_flush_io_completion_batch(jni_environment_handle_t const environment,
+                                            carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_flush_io_uring(jni_environment_handle_t const environment,
+                                 carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_flush_overflowed_io_ring_completions(jni_environment_handle_t const environment,
+                                                       carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
 carlie_tcp_server_get_jni_environment_from_server_native_object(carlie_tcp_server_native_object_t *const native_object,
                                                                 jni_environment_handle_t *const environment_ptr);
 
 
 
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+CARLIE_C_ALWAYS_INLINE static inline struct io_uring_sqe *
+carlie_tcp_server_get_io_uring_submission_entry(carlie_tcp_server_native_object_loop_data_t *const loop_data);
+#endif
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline int
+carlie_tcp_server_get_maximum_listen_backlog(void);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_get_socket_option(uv_tcp_t *const tcp_handle,
+                                    int32_t const option_id,
+                                    int32_t *const value_ptr);
+
+
+
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
 carlie_tcp_server_get_uv_address(jni_environment_handle_t const environment,
                                  carlie_tcp_server_native_object_t *const native_object,
@@ -241,139 +913,1985 @@ carlie_tcp_server_get_uv_address(jni_environment_handle_t const environment,
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline char const *
-carlie_tcp_server_result_get_value(carlie_tcp_server_result_t const status);
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_hand_off_connection(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                      carlie_tcp_server_native_object_loop_data_t *const serving_loop_data,
+                                      int32_t *const uv_result_ptr);
 
 
 
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_throw_uv_exception(jni_environment_handle_t const environment,
-                                     carlie_tcp_server_native_object_t *const native_object,
-                                     int32_t const error_number);
+carlie_tcp_server_initialize_loop_data(carlie_tcp_server_native_object_t *const native_object,
+                                       carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                       int32_t *const uv_result_ptr);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_close(uv_async_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_listen_on_io_uring(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                     int const backlog);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_close_done(uv_handle_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_open_reuse_port_socket(uv_tcp_t *const tcp_handle,
+                                         int const address_family,
+                                         int32_t *const uv_result_ptr);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_read(uv_async_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_pause_io_uring_read(carlie_tcp_server_async_uv_read_data_t *const data);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_read_allocate_buffer(uv_handle_t * handle,
-                                                       size_t suggested_size,
-                                                       uv_buf_t * buffer);
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_native_object_loop_data_t *
+carlie_tcp_server_pick_serving_loop_data(carlie_tcp_server_native_object_loop_data_t *const loop_data);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_read_data_read(uv_stream_t * handle,
-                                                 ssize_t bytes_read_count,
-                                                 uv_buf_t const * buffer);
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_post_command(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                               carlie_tcp_server_command_t *const command,
+                               carlie_tcp_server_command_handler_t const handler);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_read_done(uv_handle_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_post_io_ring_completion(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                          carlie_tcp_server_io_ring_completion_entry_t const *const entry);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_server_close(uv_async_t * handle);
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_reap_io_uring_completions(jni_environment_handle_t const environment,
+                                           carlie_tcp_server_native_object_loop_data_t *const loop_data);
+#endif
 
 
 
-void
-carlie_tcp_server_handle_async_uv_server_close_done(uv_handle_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_relay(jni_environment_handle_t const environment,
+                        carlie_tcp_server_async_uv_relay_data_t *const data);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_server_close_walk_step(uv_handle_t * handle,
-                                                         void * data);
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_release_async_uv_read_buffer(jni_environment_handle_t const environment,
+                                               carlie_tcp_server_async_uv_read_data_t *const data,
+                                               int32_t const mode);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_write(uv_async_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_release_async_uv_write_buffer(jni_environment_handle_t const environment,
+                                                carlie_tcp_server_async_uv_write_data_t *const data);
 
 
 
-void
-carlie_tcp_server_handle_async_uv_write_done(uv_handle_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_resolve_socket_option(int32_t const option_id,
+                                        int *const level_ptr,
+                                        int *const name_ptr);
 
 
 
-void
-carlie_tcp_server_handle_uv_connection_closed(uv_handle_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline char const *
+carlie_tcp_server_result_get_value(carlie_tcp_server_result_t const status);
 
 
 
-void
-carlie_tcp_server_handle_uv_connection_received(uv_stream_t * stream,
-                                                int uv_connection_received_status);
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_run_attached_loop(carlie_tcp_server_event_loop_group_attachment_t *const attachment);
 
 
 
-void
-carlie_tcp_server_handle_uv_server_closed(uv_handle_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_run_io_ring_submission(jni_environment_handle_t const environment,
+                                         carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                         carlie_tcp_server_io_ring_submission_entry_t const *const entry);
 
 
 
-void
-carlie_tcp_server_uv_job_close_connection(uv_work_t * handle);
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_send_file(jni_environment_handle_t const environment,
+                            carlie_tcp_server_async_uv_send_file_data_t *const data);
 
 
 
-void
-carlie_tcp_server_uv_job_close_connection_completed(uv_work_t * handle,
-                                                    int uv_job_completed_status);
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_serve_connection(jni_environment_handle_t const environment,
+                                   carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                   int const socket_descriptor);
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_async_uv_close(carlie_tcp_server_native_object_t *const native_object,
-                                 uv_handle_t *const handle,
-                                 uv_close_cb const callback,
-                                 int32_t *const uv_result_ptr)
-{
-  uv_async_t *const async_close_handle = calloc(1u, sizeof(uv_async_t));
-  if (async_close_handle == null_ptr) {
-    uv_result_ptr[0] = 0;
-    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_set_socket_option(uv_tcp_t *const tcp_handle,
+                                    int32_t const option_id,
+                                    int32_t const value);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_socket_option_is_supported(int32_t const option_id);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_start_async_uv_write(jni_environment_handle_t const environment,
+                                       carlie_tcp_server_async_uv_write_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_start_relay(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                              carlie_tcp_server_async_uv_relay_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_stop_relay(jni_environment_handle_t const environment,
+                             carlie_tcp_server_async_uv_relay_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_stop_relays(jni_environment_handle_t const environment,
+                              carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                              carlie_tcp_server_connection_native_object_t *const native_object);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_submit_async_uv_write(jni_environment_handle_t const environment,
+                                        carlie_tcp_server_async_uv_write_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_submit_io_uring_accept(carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_submit_io_uring_read(carlie_tcp_server_async_uv_read_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_submit_io_uring_write(carlie_tcp_server_async_uv_write_data_t *const data);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_throw_uv_exception(jni_environment_handle_t const environment,
+                                     carlie_tcp_server_native_object_t *const native_object,
+                                     int32_t const error_number);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_wake_up_io_ring_consumer(jni_environment_handle_t const environment,
+                                           carlie_tcp_server_native_object_loop_data_t *const loop_data);
+
+
+
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_wait_for_io_uring_completions(jni_environment_handle_t const environment,
+                                                carlie_tcp_server_native_object_loop_data_t *const loop_data);
+#endif
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_wait_for_relay_peer(jni_environment_handle_t const environment,
+                                      carlie_tcp_server_async_uv_relay_data_t *const data,
+                                      bool const waits_for_destination);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_close(carlie_tcp_server_command_t * command,
+                                        uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_connection_handoff(carlie_tcp_server_command_t * command,
+                                                     uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_event_loop_group_attach(carlie_tcp_server_command_t * command,
+                                                          uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_io_uring_accept(carlie_tcp_server_command_t * command,
+                                               uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_read(carlie_tcp_server_command_t * command,
+                                       uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_read_allocate_buffer(uv_handle_t * handle,
+                                                       size_t suggested_size,
+                                                       uv_buf_t * buffer);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_read_data_read(uv_stream_t * handle,
+                                                 ssize_t bytes_read_count,
+                                                 uv_buf_t const * buffer);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_read_pause(carlie_tcp_server_command_t * command,
+                                             uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_read_stop(carlie_tcp_server_command_t * command,
+                                            uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_relay(carlie_tcp_server_command_t * command,
+                                        uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_relay_destination(carlie_tcp_server_command_t * command,
+                                                    uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_send_file(carlie_tcp_server_command_t * command,
+                                            uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_send_file_data_written(uv_write_t * request,
+                                                         int uv_write_status);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_server_close(carlie_tcp_server_command_t * command,
+                                               uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_server_close_walk_step(uv_handle_t * handle,
+                                                         void * data);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_write(carlie_tcp_server_command_t * command,
+                                        uv_loop_t * loop_handle);
+
+
+
+void
+carlie_tcp_server_handle_async_uv_write_data_written(uv_write_t * request,
+                                                     int uv_write_status);
+
+
+
+void
+carlie_tcp_server_handle_command_queue_async(uv_async_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_accept_batch_check(uv_check_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_connection_closed(uv_handle_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_connection_handed_off(uv_handle_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_connection_received(uv_stream_t * stream,
+                                                int uv_connection_received_status);
+
+
+
+void
+carlie_tcp_server_handle_uv_event_loop_group_attachment_closed(uv_handle_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_event_loop_group_attachment_polled(uv_poll_t * handle,
+                                                               int status,
+                                                               int events);
+
+
+
+void
+carlie_tcp_server_handle_uv_io_completion_batch_check(uv_check_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_io_rings_check(uv_check_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_io_rings_prepare(uv_prepare_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_io_uring_check(uv_check_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_io_uring_polled(uv_poll_t * handle,
+                                            int status,
+                                            int events);
+
+
+
+void
+carlie_tcp_server_handle_uv_io_uring_prepare(uv_prepare_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_relay_closed(uv_handle_t * handle);
+
+
+
+void
+carlie_tcp_server_handle_uv_relay_polled(uv_poll_t * handle,
+                                         int status,
+                                         int events);
+
+
+
+void
+carlie_tcp_server_handle_uv_server_closed(uv_handle_t * handle);
+
+
+
+void
+carlie_tcp_server_uv_job_close_connection(uv_work_t * handle);
+
+
+
+void
+carlie_tcp_server_uv_job_close_connection_completed(uv_work_t * handle,
+                                                    int uv_job_completed_status);
+
+
+
+// NOTE: Lets the JVM side know that the loop is about to block, so that it
+// rings the loop’s doorbell (see `wakeUpUvLoop(…)`) for whatever it submits
+// from then on. Anything that got submitted in the meantime wakes the loop
+// right back up instead, since the loop would otherwise block with it.
+// NOTE: Called on the serving loop’s thread, once the connection’s socket is
+// open. The defaults were checked when they were set, so failing to apply any
+// of them isn’t reported (nor does it keep the others from being applied).
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_apply_default_socket_options(carlie_tcp_server_native_object_t *const server_native_object,
+                                               carlie_tcp_server_connection_native_object_t *const connection_native_object)
+{
+  uv_tcp_keepalive(connection_native_object->tcp_handle, (int) true, CARLIE_TCP_SERVER_KEEP_ALIVE_INITIAL_DELAY);
+  uint32_t const default_socket_options_mask = __atomic_load_n(&server_native_object->default_socket_options_mask, __ATOMIC_ACQUIRE);
+  for (int32_t option_id = 0; option_id < (int32_t) CARLIE_TCP_SERVER_SOCKET_OPTIONS_COUNT; option_id++) {
+    if ((default_socket_options_mask & (UINT32_C(1) << option_id)) == 0u) continue;
+    int32_t const value = __atomic_load_n(&server_native_object->default_socket_option_values[option_id], __ATOMIC_RELAXED);
+    carlie_tcp_server_set_socket_option(connection_native_object->tcp_handle, option_id, value);
+  }
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_arm_io_rings(carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_rings_t *const io_rings = &loop_data->io_rings;
+  if (! io_rings->is_enabled) return;
+  carlie_tcp_server_io_ring_header_t *const header = io_rings->submission_ring.header;
+  __atomic_store_n(&header->needs_wake_up, 1u, __ATOMIC_SEQ_CST);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (! carlie_tcp_server_io_ring_has_submission(&io_rings->submission_ring)) return;
+  __atomic_store_n(&header->needs_wake_up, 0u, __ATOMIC_RELAXED);
+  int32_t const uv_result = (int32_t) uv_async_send(loop_data->command_queue_async_handle);
+  assert(uv_result == 0);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_close(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                 uv_handle_t *const handle,
+                                 uv_close_cb const callback,
+                                 int32_t *const uv_result_ptr)
+{
+  carlie_tcp_server_async_uv_close_data_t *const async_close_data = carlie_tcp_server_record_pool_acquire(&loop_data->server_native_object->async_uv_close_data_pool);
+  if (async_close_data == null_ptr) {
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  async_close_data->handle = handle;
+  async_close_data->callback = callback;
+  carlie_tcp_server_post_command(loop_data, &async_close_data->command, carlie_tcp_server_handle_async_uv_close);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+// NOTE: Closes the listeners of all the server’s (listening) loops; each close goes
+// through the command queue of the loop that owns the listener.
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_close_tcp_handles(carlie_tcp_server_native_object_t *const native_object,
+                                             int32_t *const uv_result_ptr)
+{
+  for (size_t i = 0u; i < native_object->listeners_count; i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_async_uv_close(loop_data, (uv_handle_t *) loop_data->tcp_handle, null_ptr, uv_result_ptr);
+    if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+      return carlie_result;
+    }
+  }
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_read(jni_environment_handle_t const environment,
+                                carlie_tcp_server_connection_native_object_t *const native_object,
+                                jni_byte_array_t buffer_bytes,
+                                jni_object_t buffer_object,
+                                size_t const buffer_offset,
+                                size_t const buffer_bytes_size,
+                                bool const is_streaming,
+                                int32_t const operation_id,
+                                int32_t *const uv_result_ptr)
+{
+  carlie_tcp_server_record_pool_t *const async_read_data_pool = &native_object->server_native_object->async_uv_read_data_pool;
+  carlie_tcp_server_async_uv_read_data_t *const async_read_data = carlie_tcp_server_record_pool_acquire(async_read_data_pool);
+  if (async_read_data == null_ptr) {
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  // NOTE: Exactly one of `buffer_bytes` (a JVM byte array, which has to be
+  // pinned) or `buffer_object` (a direct byte buffer, which libuv can read into
+  // as-is) is expected to be non-null, except for streaming reads, which read
+  // into blocks drawn from the loop’s read buffer pool instead.
+  assert(is_streaming ?
+         ((buffer_bytes == null_ptr) && (buffer_object == null_ptr)) :
+         ((buffer_bytes == null_ptr) != (buffer_object == null_ptr)));
+  uint8_t * buffer = null_ptr;
+  if (buffer_bytes != null_ptr) {
+    // NOTE: Pinned arrays are always read into from their start, since the
+    // array elements have to be released from the same address later on.
+    assert(buffer_offset == 0u);
+    carlie_get_array_bytes(environment, buffer_bytes, &buffer);
+    jni_byte_array_t const buffer_bytes_local_reference = buffer_bytes;
+    buffer_bytes = (jni_byte_array_t) environment[0]->NewGlobalRef(environment, (jni_object_t) buffer_bytes);
+    if (buffer_bytes == null_ptr) {
+      carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
+      uv_result_ptr[0] = 0;
+      carlie_release_array_bytes(environment, buffer, buffer_bytes_local_reference, (int32_t) JNI_ABORT);
+      carlie_tcp_server_record_pool_release(async_read_data_pool, async_read_data);
+      return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+    }
+  } else if (buffer_object != null_ptr) {
+    // NOTE: The JVM side keeps the direct buffer reachable until the read
+    // completes, so there’s no need for a global reference to it here.
+    carlie_get_direct_buffer_bytes(environment, buffer_object, buffer_offset, &buffer);
+  }
+  async_read_data->buffer = buffer;
+  async_read_data->buffer_array = buffer_bytes;
+  async_read_data->buffer_count = 1u;
+  async_read_data->buffer_index = 0u;
+  async_read_data->buffers = async_read_data->buffers_;
+  async_read_data->buffers_[0].base = (char *) buffer;
+  async_read_data->buffers_[0].len = buffer_bytes_size;
+  async_read_data->bytes_read_count = 0u;
+  async_read_data->is_streaming = is_streaming;
+  async_read_data->read_buffer_pool_size_class_index = 0u;
+  async_read_data->operation_id = operation_id;
+  async_read_data->native_object = native_object;
+  carlie_tcp_server_post_command(native_object->loop_data, &async_read_data->command, carlie_tcp_server_handle_async_uv_read);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_read_scattered(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_connection_native_object_t *const native_object,
+                                          jni_object_array_t buffer_objects,
+                                          jni_int_array_t const buffer_offsets,
+                                          jni_int_array_t const buffer_sizes,
+                                          size_t const buffer_count,
+                                          int32_t const operation_id,
+                                          int32_t *const uv_result_ptr)
+{
+  carlie_tcp_server_record_pool_t *const async_read_data_pool = &native_object->server_native_object->async_uv_read_data_pool;
+  carlie_tcp_server_async_uv_read_data_t *const async_read_data = carlie_tcp_server_record_pool_acquire(async_read_data_pool);
+  if (async_read_data == null_ptr) {
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  uv_buf_t *const buffers = (buffer_count <= CARLIE_TCP_SERVER_ASYNC_UV_READ_DATA_INLINE_BUFFERS_COUNT) ?
+    async_read_data->buffers_ :
+    malloc(buffer_count * sizeof(uv_buf_t));
+  if (buffers == null_ptr) {
+    uv_result_ptr[0] = 0;
+    carlie_tcp_server_record_pool_release(async_read_data_pool, async_read_data);
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  // NOTE: Every buffer is expected to be a direct byte buffer, so that libuv
+  // can read into all of them as-is, one after the other. The JVM side keeps
+  // the buffers reachable until the read completes.
+  for (size_t buffer_index = 0u; buffer_index < buffer_count; buffer_index += 1u) {
+    jni_object_t const buffer_object = environment[0]->GetObjectArrayElement(environment, buffer_objects, (jni_size_t) buffer_index);
+    jni_int_t buffer_offset;
+    jni_int_t buffer_size;
+    environment[0]->GetIntArrayRegion(environment, buffer_offsets, (jni_size_t) buffer_index, 1, &buffer_offset);
+    environment[0]->GetIntArrayRegion(environment, buffer_sizes, (jni_size_t) buffer_index, 1, &buffer_size);
+    assert((((int32_t) buffer_offset) >= 0) &&
+           (((int32_t) buffer_size) >= 0) &&
+           ((((int64_t) buffer_offset) + ((int64_t) buffer_size)) <= ((int64_t) environment[0]->GetDirectBufferCapacity(environment, buffer_object))));
+    carlie_get_direct_buffer_bytes(environment, buffer_object, (size_t) (int32_t) buffer_offset, (uint8_t **) &buffers[buffer_index].base);
+    buffers[buffer_index].len = (size_t) (int32_t) buffer_size;
+    environment[0]->DeleteLocalRef(environment, buffer_object);
+  }
+  async_read_data->buffer = null_ptr;
+  async_read_data->buffer_array = null_ptr;
+  async_read_data->buffer_count = buffer_count;
+  async_read_data->buffer_index = 0u;
+  async_read_data->buffers = buffers;
+  async_read_data->bytes_read_count = 0u;
+  async_read_data->is_streaming = false;
+  async_read_data->read_buffer_pool_size_class_index = 0u;
+  async_read_data->operation_id = operation_id;
+  async_read_data->native_object = native_object;
+  carlie_tcp_server_post_command(native_object->loop_data, &async_read_data->command, carlie_tcp_server_handle_async_uv_read);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_read_pause(carlie_tcp_server_connection_native_object_t *const native_object,
+                                      bool const is_paused,
+                                      int32_t *const uv_result_ptr)
+{
+  carlie_tcp_server_async_uv_read_pause_data_t *const async_read_pause_data = malloc(sizeof(carlie_tcp_server_async_uv_read_pause_data_t));
+  if (async_read_pause_data == null_ptr) {
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  async_read_pause_data->is_paused = is_paused;
+  async_read_pause_data->native_object = native_object;
+  carlie_tcp_server_post_command(native_object->loop_data, &async_read_pause_data->command, carlie_tcp_server_handle_async_uv_read_pause);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_read_stop(carlie_tcp_server_connection_native_object_t *const native_object,
+                                     int32_t *const uv_result_ptr)
+{
+  carlie_tcp_server_async_uv_read_stop_data_t *const async_read_stop_data = malloc(sizeof(carlie_tcp_server_async_uv_read_stop_data_t));
+  if (async_read_stop_data == null_ptr) {
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  async_read_stop_data->native_object = native_object;
+  carlie_tcp_server_post_command(native_object->loop_data, &async_read_stop_data->command, carlie_tcp_server_handle_async_uv_read_stop);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_relay(carlie_tcp_server_connection_native_object_t *const native_object,
+                                 carlie_tcp_server_connection_native_object_t *const destination_native_object,
+                                 int32_t const operation_id,
+                                 int32_t *const uv_result_ptr)
+{
+#if ! defined(_WIN32)
+  carlie_tcp_server_async_uv_relay_data_t *const async_relay_data = calloc(1u, sizeof(carlie_tcp_server_async_uv_relay_data_t));
+  if (async_relay_data == null_ptr) {
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  async_relay_data->destination_native_object = destination_native_object;
+  async_relay_data->destination_socket_descriptor = -1;
+  async_relay_data->native_object = native_object;
+  async_relay_data->operation_id = operation_id;
+  async_relay_data->pipe_descriptors[0] = -1;
+  async_relay_data->pipe_descriptors[1] = -1;
+  async_relay_data->source_socket_descriptor = -1;
+  // NOTE: The destination’s socket gets duplicated on the destination’s loop
+  // first, where it can’t be closed in the meantime; the relay then gets
+  // started on the source’s loop.
+  carlie_tcp_server_post_command(destination_native_object->loop_data, &async_relay_data->command, carlie_tcp_server_handle_async_uv_relay_destination);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(native_object);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(destination_native_object);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(operation_id);
+  uv_result_ptr[0] = UV_ENOTSUP;
+  return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+#endif
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_send_file(jni_environment_handle_t const environment,
+                                     carlie_tcp_server_connection_native_object_t *const native_object,
+                                     jni_object_t const file_channel_object,
+                                     int64_t const file_offset,
+                                     size_t const bytes_count,
+                                     int32_t const operation_id,
+                                     int32_t *const uv_result_ptr)
+{
+#if ! defined(_WIN32)
+  // NOTE: The file’s descriptor is taken from the channel’s (private) `fd`
+  // field, which JNI doesn’t mind, and duplicated, so that the channel may be
+  // closed while the transfer is still pending. Channels that aren’t backed by
+  // a file descriptor aren’t supported.
+  jni_class_t const file_channel_class = environment[0]->GetObjectClass(environment, file_channel_object);
+  jni_field_id_t const file_descriptor_object_field_id = environment[0]->GetFieldID(environment, file_channel_class, "fd", "Ljava/io/FileDescriptor;");
+  if (file_descriptor_object_field_id == null_ptr) {
+    environment[0]->ExceptionClear(environment);
+    uv_result_ptr[0] = UV_ENOTSUP;
+    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+  }
+  jni_object_t const file_descriptor_object = environment[0]->GetObjectField(environment, file_channel_object, file_descriptor_object_field_id);
+  if (file_descriptor_object == null_ptr) {
+    uv_result_ptr[0] = UV_EBADF;
+    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+  }
+  jni_class_t const file_descriptor_class = environment[0]->GetObjectClass(environment, file_descriptor_object);
+  jni_field_id_t const file_descriptor_field_id = environment[0]->GetFieldID(environment, file_descriptor_class, "fd", "I");
+  if (file_descriptor_field_id == null_ptr) {
+    environment[0]->ExceptionClear(environment);
+    uv_result_ptr[0] = UV_ENOTSUP;
+    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+  }
+  int const file_descriptor = fcntl((int) environment[0]->GetIntField(environment, file_descriptor_object, file_descriptor_field_id), F_DUPFD_CLOEXEC, 0);
+  if (file_descriptor < 0) {
+    uv_result_ptr[0] = (int32_t) uv_translate_sys_error(errno);
+    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+  }
+  carlie_tcp_server_async_uv_send_file_data_t *const async_send_file_data = malloc(sizeof(carlie_tcp_server_async_uv_send_file_data_t));
+  if (async_send_file_data == null_ptr) {
+    close(file_descriptor);
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  async_send_file_data->bytes_count = bytes_count;
+  async_send_file_data->bytes_sent_count = 0u;
+  async_send_file_data->chunk = null_ptr;
+  async_send_file_data->file_descriptor = file_descriptor;
+  async_send_file_data->file_offset = file_offset;
+  async_send_file_data->native_object = native_object;
+  async_send_file_data->operation_id = operation_id;
+#if defined(__linux__)
+  async_send_file_data->sendfile_is_unsupported = false;
+#else
+  // NOTE: `sendfile(…)` differs from one system to another, and is only used
+  // on Linux; elsewhere, the file is written with `uv_write(…)`, a chunk at a
+  // time.
+  async_send_file_data->sendfile_is_unsupported = true;
+#endif
+  carlie_tcp_server_post_command(native_object->loop_data, &async_send_file_data->command, carlie_tcp_server_handle_async_uv_send_file);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(environment);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(native_object);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(file_channel_object);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(file_offset);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(bytes_count);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(operation_id);
+  uv_result_ptr[0] = UV_ENOTSUP;
+  return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+#endif
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_server_close(carlie_tcp_server_native_object_t *const native_object,
+                                        int32_t *const uv_result_ptr)
+{
+  // NOTE: The server is only ever closed once, so its close commands (one per
+  // loop) can be embedded in its loops’ data instead of being allocated.
+  for (size_t i = 0u; i < native_object->loops_count; i++) {
+    carlie_tcp_server_native_object_loop_data_t *const loop_data = &native_object->loops_data[i];
+    carlie_tcp_server_post_command(loop_data, &loop_data->server_close_command, carlie_tcp_server_handle_async_uv_server_close);
+  }
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_write(jni_environment_handle_t const environment,
+                                 carlie_tcp_server_connection_native_object_t *const native_object,
+                                 jni_byte_array_t buffer_bytes,
+                                 jni_object_t buffer_object,
+                                 size_t const buffer_offset,
+                                 size_t const buffer_bytes_size,
+                                 int32_t const operation_id,
+                                 int32_t *const uv_result_ptr)
+{
+  carlie_tcp_server_record_pool_t *const async_write_data_pool = &native_object->server_native_object->async_uv_write_data_pool;
+  carlie_tcp_server_async_uv_write_data_t *const async_write_data = carlie_tcp_server_record_pool_acquire(async_write_data_pool);
+  if (async_write_data == null_ptr) {
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  async_write_data->native_object = native_object;
+  uv_buf_t *const buffer = async_write_data->buffers_;
+  // NOTE: Exactly one of `buffer_bytes` (a JVM byte array, which has to be
+  // pinned) or `buffer_object` (a direct byte buffer, which libuv can write
+  // from as-is) is expected to be non-null.
+  assert((buffer_bytes == null_ptr) != (buffer_object == null_ptr));
+  if (buffer_bytes_size <= CARLIE_TCP_SERVER_ASYNC_UV_WRITE_DATA_INLINE_BYTES_SIZE) {
+    // NOTE: Tiny writes are copied into the write data instead, which is a lot
+    // cheaper than pinning the array for as long as the write is pending.
+    if (buffer_bytes != null_ptr) {
+      assert(buffer_offset == 0u);
+      environment[0]->GetByteArrayRegion(environment, buffer_bytes, 0, (jni_size_t) buffer_bytes_size, (jni_byte_t *) async_write_data->bytes_);
+    } else {
+      uint8_t * bytes = null_ptr;
+      carlie_get_direct_buffer_bytes(environment, buffer_object, buffer_offset, &bytes);
+      memcpy(async_write_data->bytes_, bytes, buffer_bytes_size);
+    }
+    buffer->base = (char *) async_write_data->bytes_;
+    buffer_bytes = null_ptr;
+  } else if (buffer_bytes != null_ptr) {
+    assert(buffer_offset == 0u);
+    carlie_get_array_bytes(environment, buffer_bytes, (uint8_t **) &buffer->base);
+    jni_byte_array_t const buffer_bytes_local_reference = buffer_bytes;
+    buffer_bytes = (jni_byte_array_t) environment[0]->NewGlobalRef(environment, (jni_object_t) buffer_bytes);
+    if (buffer_bytes == null_ptr) {
+      carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
+      uv_result_ptr[0] = 0;
+      carlie_release_array_bytes(environment, (uint8_t *) buffer->base, buffer_bytes_local_reference, (int32_t) JNI_ABORT);
+      carlie_tcp_server_record_pool_release(async_write_data_pool, async_write_data);
+      return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+    }
+  } else {
+    // NOTE: Same as for reads, the JVM side keeps the direct buffer reachable
+    // until the write completes.
+    carlie_get_direct_buffer_bytes(environment, buffer_object, buffer_offset, (uint8_t **) &buffer->base);
+  }
+  buffer->len = buffer_bytes_size;
+  async_write_data->buffer = buffer;
+  async_write_data->buffer_count = 1u;
+  async_write_data->buffer_array = buffer_bytes;
+  async_write_data->operation_id = operation_id;
+  carlie_tcp_server_post_command(native_object->loop_data, &async_write_data->command, carlie_tcp_server_handle_async_uv_write);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_async_uv_write_gathered(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_connection_native_object_t *const native_object,
+                                          jni_object_array_t buffer_objects,
+                                          jni_int_array_t const buffer_offsets,
+                                          jni_int_array_t const buffer_sizes,
+                                          size_t const buffer_count,
+                                          int32_t const operation_id,
+                                          int32_t *const uv_result_ptr)
+{
+  carlie_tcp_server_record_pool_t *const async_write_data_pool = &native_object->server_native_object->async_uv_write_data_pool;
+  carlie_tcp_server_async_uv_write_data_t *const async_write_data = carlie_tcp_server_record_pool_acquire(async_write_data_pool);
+  if (async_write_data == null_ptr) {
+    uv_result_ptr[0] = 0;
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  async_write_data->native_object = native_object;
+  uv_buf_t *const buffers = (buffer_count <= CARLIE_TCP_SERVER_ASYNC_UV_WRITE_DATA_INLINE_BUFFERS_COUNT) ?
+    async_write_data->buffers_ :
+    malloc(buffer_count * sizeof(uv_buf_t));
+  if (buffers == null_ptr) {
+    uv_result_ptr[0] = 0;
+    carlie_tcp_server_record_pool_release(async_write_data_pool, async_write_data);
+    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  }
+  // NOTE: Every buffer is expected to be a direct byte buffer, so that libuv
+  // can write from all of them as-is, in a single `writev(…)` call. The JVM
+  // side keeps the buffers reachable until the write completes.
+  for (size_t buffer_index = 0u; buffer_index < buffer_count; buffer_index += 1u) {
+    jni_object_t const buffer_object = environment[0]->GetObjectArrayElement(environment, buffer_objects, (jni_size_t) buffer_index);
+    jni_int_t buffer_offset;
+    jni_int_t buffer_size;
+    environment[0]->GetIntArrayRegion(environment, buffer_offsets, (jni_size_t) buffer_index, 1, &buffer_offset);
+    environment[0]->GetIntArrayRegion(environment, buffer_sizes, (jni_size_t) buffer_index, 1, &buffer_size);
+    assert((((int32_t) buffer_offset) >= 0) &&
+           (((int32_t) buffer_size) >= 0) &&
+           ((((int64_t) buffer_offset) + ((int64_t) buffer_size)) <= ((int64_t) environment[0]->GetDirectBufferCapacity(environment, buffer_object))));
+    carlie_get_direct_buffer_bytes(environment, buffer_object, (size_t) (int32_t) buffer_offset, (uint8_t **) &buffers[buffer_index].base);
+    buffers[buffer_index].len = (size_t) (int32_t) buffer_size;
+    environment[0]->DeleteLocalRef(environment, buffer_object);
+  }
+  async_write_data->buffer = buffers;
+  async_write_data->buffer_array = null_ptr;
+  async_write_data->buffer_count = buffer_count;
+  async_write_data->operation_id = operation_id;
+  carlie_tcp_server_post_command(native_object->loop_data, &async_write_data->command, carlie_tcp_server_handle_async_uv_write);
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+// NOTE: Cancels whatever a connection (or, without one, the whole loop) still
+// has in io_uring’s hands, and waits for all of it to complete, since the
+// kernel may use the operations’ sockets and buffers until then. The
+// completions get handled as usual (i.e., reported as cancelled), and none of
+// the operations gets started again afterwards. Should the cancellation not
+// fit into the submission queue, the operations are waited for all the same.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_cancel_io_uring_operations(jni_environment_handle_t const environment,
+                                             carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                             carlie_tcp_server_connection_native_object_t *const native_object)
+{
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+  if (! transport->is_enabled) return;
+  size_t * operations_count_ptr;
+  if (native_object != null_ptr) {
+    native_object->io_uring_operations_are_cancelled = true;
+    operations_count_ptr = &native_object->io_uring_operations_count;
+  } else {
+    transport->operations_are_cancelled = true;
+    operations_count_ptr = &transport->operations_count;
+  }
+  if (operations_count_ptr[0] == 0u) return;
+  struct io_uring_sqe *const entry = carlie_tcp_server_get_io_uring_submission_entry(loop_data);
+  if (entry != null_ptr) {
+    entry->opcode = (uint8_t) IORING_OP_ASYNC_CANCEL;
+    if (native_object != null_ptr) {
+      uv_os_fd_t socket_descriptor = -1;
+      int32_t const uv_result = (int32_t) uv_fileno((uv_handle_t *) native_object->tcp_handle, &socket_descriptor);
+      assert(uv_result == 0);
+      entry->fd = (int32_t) socket_descriptor;
+      entry->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    } else {
+      entry->fd = -1;
+      entry->cancel_flags = IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL;
+    }
+  }
+  while (operations_count_ptr[0] > 0u) {
+    if (! carlie_tcp_server_wait_for_io_uring_completions(environment, loop_data)) return;
+  }
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(environment);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(loop_data);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(native_object);
+#endif
+}
+
+
+
+// NOTE: Stops a streaming read that goes through io_uring: its multishot
+// receive gets cancelled, and the read ends (as stopped) once the receive’s
+// last completion has been handled.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_cancel_io_uring_read(jni_environment_handle_t const environment,
+                                       carlie_tcp_server_async_uv_read_data_t *const data)
+{
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = native_object->loop_data;
+  data->is_stopping = true;
+  struct io_uring_sqe *const entry = carlie_tcp_server_get_io_uring_submission_entry(loop_data);
+  if (entry != null_ptr) {
+    entry->opcode = (uint8_t) IORING_OP_ASYNC_CANCEL;
+    entry->fd = -1;
+    entry->addr = ((uint64_t) (uintptr_t) data) | CARLIE_TCP_SERVER_IO_URING_OPERATION_READ;
+  }
+  while (native_object->latest_async_uv_read_data == data) {
+    if (! carlie_tcp_server_wait_for_io_uring_completions(environment, loop_data)) return;
+  }
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(environment);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(data);
+#endif
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_close_socket(int const socket_descriptor)
+{
+#if ! defined(_WIN32)
+  if (socket_descriptor < 0) return;
+  close(socket_descriptor);
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(socket_descriptor);
+#endif
+}
+
+
+
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+// NOTE: A multishot accept keeps going until it fails, or gets cancelled (when
+// the loop closes); it gets started right back up in the former case.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_complete_io_uring_accept(jni_environment_handle_t const environment,
+                                           carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                           int32_t const result,
+                                           uint32_t const flags)
+{
+  carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+  bool const is_final = ((flags & IORING_CQE_F_MORE) == 0u);
+  if (is_final) {
+    transport->operations_count -= 1u;
+  }
+  int32_t error_number = 0;
+  if (result >= 0) {
+    int const socket_descriptor = (int) result;
+    carlie_tcp_server_native_object_loop_data_t *const serving_loop_data = carlie_tcp_server_pick_serving_loop_data(loop_data);
+    if (transport->operations_are_cancelled) {
+      carlie_tcp_server_close_socket(socket_descriptor);
+    } else if (serving_loop_data == loop_data) {
+      carlie_tcp_server_serve_connection(environment, loop_data, socket_descriptor);
+    } else {
+      // NOTE: Unlike with libuv, the accepted socket isn’t tied to this loop in
+      // any way, so it can be handed over as is.
+      carlie_tcp_server_connection_handoff_data_t *const data = malloc(sizeof(carlie_tcp_server_connection_handoff_data_t));
+      if (data == null_ptr) {
+        carlie_tcp_server_close_socket(socket_descriptor);
+        error_number = (int32_t) UV_ENOMEM;
+      } else {
+        data->loop_data = serving_loop_data;
+        data->socket_descriptor = socket_descriptor;
+        carlie_tcp_server_post_command(serving_loop_data, &data->command, carlie_tcp_server_handle_async_uv_connection_handoff);
+      }
+    }
+  } else if (result != UV_ECANCELED) {
+    error_number = result;
+  }
+  if (is_final &&
+      (result != UV_ECANCELED) &&
+      (! transport->operations_are_cancelled) &&
+      (! carlie_tcp_server_submit_io_uring_accept(loop_data))) {
+    error_number = (int32_t) UV_ENOBUFS;
+  }
+  if (error_number == 0) return;
+  int32_t const jni_result = (int32_t) environment[0]->PushLocalFrame(environment, (jni_int_t) 5);
+  // There’s no point in doing anything extra here.
+  if (jni_result != 0) return;
+  carlie_tcp_server_emit_uv_error_event(environment, loop_data->server_native_object, error_number);
+  environment[0]->PopLocalFrame(environment, null_ptr);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_complete_io_uring_read(jni_environment_handle_t const environment,
+                                         carlie_tcp_server_async_uv_read_data_t *const data,
+                                         int32_t result,
+                                         uint32_t const flags)
+{
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  carlie_tcp_server_io_uring_transport_t *const transport = &native_object->loop_data->io_uring_transport;
+  if (data->is_streaming) {
+    // NOTE: Same as with libuv, each chunk is handed over as soon as it has
+    // been read, and its buffer goes back to the kernel once the callback
+    // returns.
+    if ((flags & IORING_CQE_F_BUFFER) != 0u) {
+      uint16_t const buffer_id = (uint16_t) (flags >> IORING_CQE_BUFFER_SHIFT);
+      if (result > 0) {
+        uint8_t *const bytes = carlie_tcp_server_io_uring_get_read_buffer(&transport->ring, buffer_id);
+        carlie_tcp_server_connection_hand_over_read_data(environment, native_object, data->operation_id, bytes, (size_t) result);
+      }
+      carlie_tcp_server_io_uring_provide_read_buffer(&transport->ring, buffer_id);
+    }
+    if ((flags & IORING_CQE_F_MORE) != 0u) return;
+    native_object->io_uring_operations_count -= 1u;
+    transport->operations_count -= 1u;
+    bool const is_cancelled = data->is_stopping ||
+      native_object->io_uring_operations_are_cancelled ||
+      transport->operations_are_cancelled;
+    // NOTE: A multishot receive also ends when it runs out of read buffers (or
+    // of room for its completions), or when it got cancelled because reading
+    // was paused, in which case the stream keeps going (once reading resumes).
+    if ((! is_cancelled) &&
+        ((result > 0) || (result == UV_ENOBUFS) || (result == UV_ECANCELED))) {
+      if (native_object->reading_is_paused) {
+        data->is_parked = true;
+        return;
+      }
+      if (carlie_tcp_server_submit_io_uring_read(data)) return;
+      result = (int32_t) UV_ENOBUFS;
+    }
+    native_object->latest_async_uv_read_data = null_ptr;
+    if (is_cancelled || (result == UV_ECANCELED)) {
+      // NOTE: A zero byte count signals the end of the streaming read, same as
+      // when a streaming read through libuv gets stopped.
+      carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, 0);
+    } else if (result == 0) {
+      carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, -1, 0);
+    } else {
+      carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, result);
+    }
+    carlie_tcp_server_destroy_async_uv_read_data(data);
+    return;
+  }
+  native_object->io_uring_operations_count -= 1u;
+  transport->operations_count -= 1u;
+  native_object->latest_async_uv_read_data = null_ptr;
+  if (result > 0) {
+    data->bytes_read_count = (size_t) result;
+    // NOTE: This is very important in this case! (At least for pinned arrays;
+    // a direct buffer already holds the data at this point.)
+    int32_t const buffer_array_bytes_release_mode = 0;
+    carlie_tcp_server_release_async_uv_read_buffer(environment, data, buffer_array_bytes_release_mode);
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, result, 0);
+  } else if (result == 0) {
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, -1, 0);
+  } else if (result == UV_ECANCELED) {
+    // NOTE: The connection is being closed; that’s reported the same way as a
+    // read issued on a closing connection.
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, 0);
+  } else {
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, result);
+  }
+  carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_READING);
+  if (result <= 0) {
+    carlie_tcp_server_release_async_uv_read_buffer(environment, data, (int32_t) JNI_ABORT);
+  }
+  carlie_tcp_server_destroy_async_uv_read_data(data);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_complete_io_uring_write(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_async_uv_write_data_t *const data,
+                                          int32_t const result)
+{
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  carlie_tcp_server_io_uring_transport_t *const transport = &native_object->loop_data->io_uring_transport;
+  native_object->io_uring_operations_count -= 1u;
+  transport->operations_count -= 1u;
+  int32_t error_number = (result < 0) ?
+    result :
+    0;
+  if (result > 0) {
+    data->bytes_written_count += (size_t) result;
+    // NOTE: Unlike `uv_write(…)`, a send may come up short (e.g., when it got
+    // interrupted), in which case the buffers get advanced past whatever has
+    // been written, and the rest goes out with another send.
+    struct msghdr *const message = &data->io_uring_message;
+    size_t bytes_count = (size_t) result;
+    while ((message->msg_iovlen > 0u) &&
+           (bytes_count >= message->msg_iov[0].iov_len)) {
+      bytes_count -= message->msg_iov[0].iov_len;
+      message->msg_iov += 1;
+      message->msg_iovlen -= 1u;
+    }
+    if (message->msg_iovlen > 0u) {
+      message->msg_iov[0].iov_base = (void *) (((uint8_t *) message->msg_iov[0].iov_base) + bytes_count);
+      message->msg_iov[0].iov_len -= bytes_count;
+      if (native_object->io_uring_operations_are_cancelled ||
+          transport->operations_are_cancelled) {
+        error_number = (int32_t) UV_ECANCELED;
+      } else if (carlie_tcp_server_submit_io_uring_write(data)) {
+        return;
+      } else {
+        error_number = (int32_t) UV_ENOBUFS;
+      }
+    }
+  }
+  assert(native_object->io_uring_write_queue_head == data);
+  carlie_tcp_server_async_uv_write_data_t * queued_data = data->next_write_data;
+  native_object->io_uring_write_queue_head = null_ptr;
+  native_object->io_uring_write_queue_tail = null_ptr;
+  carlie_tcp_server_connection_remove_pending_write_bytes(environment, native_object, data->bytes_count);
+  if ((error_number == 0) || (error_number == UV_ECANCELED)) {
+    // NOTE: Unlike with libuv, a write that got cancelled because the
+    // connection was closed is reported with however much of it had been
+    // sent by then.
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, (int32_t) data->bytes_written_count, 0);
+  } else {
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, error_number);
+  }
+  carlie_tcp_server_release_async_uv_write_buffer(environment, data);
+  carlie_tcp_server_destroy_async_uv_write_data(data);
+  // NOTE: The writes queued behind the send go next, in order, unless the
+  // connection’s operations got cancelled, in which case they’re reported as
+  // cancelled too, without anything of them having been written.
+  bool const writes_are_cancelled = (native_object->io_uring_operations_are_cancelled ||
+                                     transport->operations_are_cancelled);
+  while (queued_data != null_ptr) {
+    carlie_tcp_server_async_uv_write_data_t *const next_queued_data = queued_data->next_write_data;
+    queued_data->next_write_data = null_ptr;
+    if (writes_are_cancelled) {
+      carlie_tcp_server_connection_remove_pending_write_bytes(environment, native_object, queued_data->bytes_count);
+      carlie_tcp_server_connection_complete_io(environment, native_object, queued_data->operation_id, 0, 0);
+      carlie_tcp_server_release_async_uv_write_buffer(environment, queued_data);
+      carlie_tcp_server_destroy_async_uv_write_data(queued_data);
+    } else {
+      carlie_tcp_server_submit_async_uv_write(environment, queued_data);
+    }
+    queued_data = next_queued_data;
+  }
+}
+#endif
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_add_pending_write_bytes(jni_environment_handle_t const environment,
+                                                     carlie_tcp_server_connection_native_object_t *const native_object,
+                                                     size_t const bytes_count)
+{
+  carlie_tcp_server_native_object_t *const server_native_object = native_object->server_native_object;
+  native_object->pending_write_bytes_count += bytes_count;
+  __atomic_add_fetch(&server_native_object->pending_write_bytes_count, (uint64_t) bytes_count, __ATOMIC_RELAXED);
+  uint64_t const high_watermark = __atomic_load_n(&server_native_object->write_high_watermark, __ATOMIC_RELAXED);
+  if (native_object->is_writable &&
+      (((uint64_t) native_object->pending_write_bytes_count) > high_watermark)) {
+    carlie_tcp_server_connection_set_writability(environment, native_object, false);
+  }
+}
+
+
+
+// NOTE: Every read and write of a connection is reported through the same
+// sink, which was registered once along with the connection, so there’s no
+// global reference to create (or delete) per operation.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_complete_io(jni_environment_handle_t const environment,
+                                         carlie_tcp_server_connection_native_object_t *const native_object,
+                                         int32_t const operation_id,
+                                         int32_t const result,
+                                         int32_t const error_number)
+{
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = native_object->loop_data;
+  if (loop_data->io_rings.is_enabled) {
+    carlie_tcp_server_io_ring_completion_entry_t const entry = {
+      .connection_native_object_address = (uint64_t) (uintptr_t) native_object,
+      .operation_id = operation_id,
+      .result = result,
+      .error_number = error_number,
+    };
+    carlie_tcp_server_post_io_ring_completion(environment, loop_data, &entry);
+    return;
+  }
+  carlie_tcp_server_io_completion_batch_t *const batch = &loop_data->io_completion_batch;
+  if (! batch->is_enabled) {
+    environment[0]->CallVoidMethod(environment, native_object->io_completion_sink_function_object, native_object->io_completion_sink_function_handle_io_completed_method_id, (jni_int_t) operation_id, (jni_int_t) result, (jni_int_t) error_number);
+    return;
+  }
+  environment[0]->SetObjectArrayElement(environment, (jni_object_array_t) batch->sinks_array, (jni_size_t) batch->count, native_object->io_completion_sink_function_object);
+  int32_t *const values = &batch->values[batch->count * 3u];
+  values[0] = operation_id;
+  values[1] = result;
+  values[2] = error_number;
+  batch->count += 1u;
+  if (batch->count == CARLIE_TCP_SERVER_IO_COMPLETION_BATCH_CAPACITY) {
+    carlie_tcp_server_flush_io_completion_batch(environment, loop_data);
+  }
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_connection_stop_streaming_read(jni_environment_handle_t const environment,
+                                                 carlie_tcp_server_connection_native_object_t *const native_object)
+{
+  carlie_tcp_server_async_uv_read_data_t *const async_data = native_object->latest_async_uv_read_data;
+  if ((async_data == null_ptr) ||
+      (! async_data->is_streaming)) {
+    return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+  }
+  if (async_data->uses_io_uring &&
+      (! async_data->is_parked)) {
+    carlie_tcp_server_cancel_io_uring_read(environment, async_data);
+    return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+  }
+  native_object->latest_async_uv_read_data = null_ptr;
+  int32_t const uv_result = (int32_t) uv_read_stop((uv_stream_t *) native_object->tcp_handle);
+  if (uv_result < 0) {
+    carlie_tcp_server_connection_emit_uv_error_event(environment, native_object, uv_result);
+  }
+  // NOTE: A zero byte count signals the end of the streaming read to the JVM
+  // side, as opposed to the byte counts of the chunks read while streaming.
+  carlie_tcp_server_connection_complete_io(environment, native_object, async_data->operation_id, 0, 0);
+  carlie_tcp_server_release_async_uv_read_buffer(environment, async_data, (int32_t) JNI_ABORT);
+  carlie_tcp_server_destroy_async_uv_read_data(async_data);
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_connection_emit_uv_error_event(jni_environment_handle_t const environment,
+                                                 carlie_tcp_server_connection_native_object_t *const native_object,
+                                                 int32_t const error_number)
+{
+  jni_object_t exception_object = null_ptr;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_create_uv_exception(environment, native_object->server_native_object, error_number, &exception_object);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    return carlie_result;
+  }
+  environment[0]->CallVoidMethod(environment, native_object->handle_error_occurred_event_function_object, native_object->handle_error_occurred_event_function_handle_method_id, exception_object);
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+// NOTE: Returns whether the connection entered the given state, which it only
+// does as long as it isn’t closing (or closed).
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_connection_enter_state(carlie_tcp_server_connection_native_object_t *const native_object,
+                                         uint32_t const state)
+{
+  uint32_t current_state = __atomic_load_n(&native_object->state, __ATOMIC_RELAXED);
+  do {
+    if ((current_state & (CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSING | CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSED)) != 0u) {
+      return false;
+    }
+  } while (! __atomic_compare_exchange_n(&native_object->state, &current_state, current_state | state, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+  return true;
+}
+
+
+
+// NOTE: Hands a chunk of a streaming read over to the JVM side (wrapped in a
+// direct byte buffer, which is only valid until this returns). This runs on
+// the loop’s thread, so an exception thrown along the way (by the data
+// handler, say) mustn’t be left pending; it’s reported as an error of the
+// connection instead.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_hand_over_read_data(jni_environment_handle_t const environment,
+                                                 carlie_tcp_server_connection_native_object_t *const native_object,
+                                                 int32_t const operation_id,
+                                                 uint8_t *const bytes,
+                                                 size_t const bytes_count)
+{
+  jni_object_t const data_object = environment[0]->NewDirectByteBuffer(environment, (void *) bytes, (jni_long_t) bytes_count);
+  if (data_object != null_ptr) {
+    environment[0]->CallVoidMethod(environment, native_object->io_completion_sink_function_object, native_object->io_completion_sink_function_handle_data_read_method_id, (jni_int_t) operation_id, data_object);
+    environment[0]->DeleteLocalRef(environment, data_object);
+  }
+  jni_throwable_t const exception_object = environment[0]->ExceptionOccurred(environment);
+  if (exception_object == null_ptr) return;
+  environment[0]->ExceptionClear(environment);
+  environment[0]->CallVoidMethod(environment, native_object->handle_error_occurred_event_function_object, native_object->handle_error_occurred_event_function_handle_method_id, exception_object);
+  // NOTE: An error handler that throws as well has its exception dropped.
+  environment[0]->ExceptionClear(environment);
+  environment[0]->DeleteLocalRef(environment, exception_object);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_leave_state(carlie_tcp_server_connection_native_object_t *const native_object,
+                                         uint32_t const state)
+{
+  __atomic_fetch_and(&native_object->state, ~state, __ATOMIC_RELEASE);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_remove_pending_write_bytes(jni_environment_handle_t const environment,
+                                                        carlie_tcp_server_connection_native_object_t *const native_object,
+                                                        size_t const bytes_count)
+{
+  carlie_tcp_server_native_object_t *const server_native_object = native_object->server_native_object;
+  assert(native_object->pending_write_bytes_count >= bytes_count);
+  native_object->pending_write_bytes_count -= bytes_count;
+  __atomic_sub_fetch(&server_native_object->pending_write_bytes_count, (uint64_t) bytes_count, __ATOMIC_RELAXED);
+  uint64_t const low_watermark = __atomic_load_n(&server_native_object->write_low_watermark, __ATOMIC_RELAXED);
+  if ((! native_object->is_writable) &&
+      (((uint64_t) native_object->pending_write_bytes_count) <= low_watermark)) {
+    carlie_tcp_server_connection_set_writability(environment, native_object, true);
+  }
+}
+
+
+
+// NOTE: A connection that is closing doesn’t report becoming writable again
+// (which it does as its pending writes get cancelled), but still gets counted.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_set_writability(jni_environment_handle_t const environment,
+                                             carlie_tcp_server_connection_native_object_t *const native_object,
+                                             bool const is_writable)
+{
+  native_object->is_writable = is_writable;
+  if (is_writable) {
+    __atomic_sub_fetch(&native_object->server_native_object->unwritable_connections_count, UINT64_C(1), __ATOMIC_RELAXED);
+  } else {
+    __atomic_add_fetch(&native_object->server_native_object->unwritable_connections_count, UINT64_C(1), __ATOMIC_RELAXED);
+  }
+  uint32_t const state = __atomic_load_n(&native_object->state, __ATOMIC_RELAXED);
+  if ((state & (CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSING | CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSED)) != 0u) return;
+  carlie_tcp_server_connection_complete_io(environment, native_object, CARLIE_TCP_SERVER_WRITABILITY_CHANGED_OPERATION_ID, (int32_t) is_writable, 0);
+}
+
+
+
+// NOTE: Starts the given write, which has to be the one the connection expects
+// next, followed by whichever of its out-of-order writes are next in line.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_connection_start_writes(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_connection_native_object_t *const native_object,
+                                          carlie_tcp_server_async_uv_write_data_t * data)
+{
+  while (data != null_ptr) {
+    assert(data->operation_id == native_object->next_write_operation_id);
+    int32_t const operation_id = data->operation_id;
+    carlie_tcp_server_start_async_uv_write(environment, data);
+    data = carlie_tcp_server_connection_take_next_write(native_object, operation_id);
+  }
+}
+
+
+
+// NOTE: Moves past the write with the given operation ID, and returns the write
+// after it, if it has already reached the loop (or `null_ptr`, otherwise).
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_async_uv_write_data_t *
+carlie_tcp_server_connection_take_next_write(carlie_tcp_server_connection_native_object_t *const native_object,
+                                             int32_t const operation_id)
+{
+  native_object->next_write_operation_id = (operation_id == INT32_MAX) ?
+    CARLIE_TCP_SERVER_FIRST_WRITE_OPERATION_ID :
+    (operation_id + 1);
+  carlie_tcp_server_async_uv_write_data_t ** data_ptr = &native_object->out_of_order_writes;
+  while ((data_ptr[0] != null_ptr) &&
+         (data_ptr[0]->operation_id != native_object->next_write_operation_id)) {
+    data_ptr = &data_ptr[0]->next_write_data;
+  }
+  carlie_tcp_server_async_uv_write_data_t *const data = data_ptr[0];
+  if (data != null_ptr) {
+    data_ptr[0] = data->next_write_data;
+  }
+  return data;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_create_connection_native_object(jni_environment_handle_t const environment,
+                                                  carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                                  jni_object_t *const connection_native_object_bytes_ptr,
+                                                  carlie_tcp_server_connection_native_object_t **const connection_native_object_ptr)
+{
+  carlie_tcp_server_native_object_t *const server_native_object = loop_data->server_native_object;
+  jni_object_t const connection_native_object_bytes = environment[0]->CallObjectMethod(environment, server_native_object->create_connection_native_object_static_method_function_object, server_native_object->create_connection_native_object_static_method_function_invoke_method_id);
+  carlie_get_native_object(environment, connection_native_object_bytes, (void **) connection_native_object_ptr);
+  carlie_tcp_server_connection_native_object_t *const connection_native_object = connection_native_object_ptr[0];
+  __atomic_store_n(&connection_native_object->state, CARLIE_TCP_SERVER_CONNECTION_STATE_OPENING, __ATOMIC_RELEASE);
+  connection_native_object->io_uring_write_queue_head = null_ptr;
+  connection_native_object->io_uring_write_queue_tail = null_ptr;
+  connection_native_object->is_writable = true;
+  connection_native_object->next_write_operation_id = CARLIE_TCP_SERVER_FIRST_WRITE_OPERATION_ID;
+  connection_native_object->out_of_order_writes = null_ptr;
+  connection_native_object->pending_write_bytes_count = 0u;
+  connection_native_object->reading_is_paused = false;
+  // NOTE: A connection is served, for its whole life, by the loop whose
+  // listener accepted it.
+  connection_native_object->loop_data = loop_data;
+  connection_native_object->tcp_handle = &connection_native_object->tcp_handle_;
+  connection_native_object_bytes_ptr[0] = connection_native_object_bytes;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_create_uv_exception(jni_environment_handle_t const environment,
+                                      carlie_tcp_server_native_object_t *const native_object,
+                                      int32_t const error_number,
+                                      jni_object_t *const exception_object_ptr)
+{
+  jni_object_t exception_object = environment[0]->NewObject(environment, native_object->uv_exception_class, native_object->uv_exception_constructor_method_id, (jni_int_t) error_number);
+  if (exception_object == null_ptr) {
+    exception_object_ptr[0] = null_ptr;
+    return CARLIE_TCP_SERVER_RESULT_CANNOT_CREATE_EXCEPTION;
+  }
+  exception_object_ptr[0] = exception_object;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_async_uv_read_data(carlie_tcp_server_async_uv_read_data_t *const data)
+{
+  if (data->buffers != data->buffers_) {
+    free(data->buffers);
+  }
+  carlie_tcp_server_record_pool_release(&data->native_object->server_native_object->async_uv_read_data_pool, data);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_async_uv_relay_data(carlie_tcp_server_async_uv_relay_data_t *const data)
+{
+  free(data->buffer);
+  free(data);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_async_uv_send_file_data(carlie_tcp_server_async_uv_send_file_data_t *const data)
+{
+#if ! defined(_WIN32)
+  close(data->file_descriptor);
+#endif
+  free(data->chunk);
+  free(data);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_async_uv_write_data(carlie_tcp_server_async_uv_write_data_t *const data)
+{
+  if (data->buffer != data->buffers_) {
+    free(data->buffer);
+  }
+  carlie_tcp_server_record_pool_release(&data->native_object->server_native_object->async_uv_write_data_pool, data);
+}
+
+
+
+// NOTE: Only used when a completion can’t be kept anywhere else, i.e., as a
+// last resort; it then reaches the JVM side right away, through the same calls
+// it would have without rings.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_deliver_io_ring_completion(jni_environment_handle_t const environment,
+                                             carlie_tcp_server_io_ring_completion_entry_t const *const entry)
+{
+  carlie_tcp_server_connection_native_object_t *const native_object = (carlie_tcp_server_connection_native_object_t *) (uintptr_t) entry->connection_native_object_address;
+  assert(native_object != null_ptr);
+  if (entry->operation_id == CARLIE_TCP_SERVER_IO_RING_CLOSED_OPERATION_ID) {
+    environment[0]->CallVoidMethod(environment, native_object->handle_closed_event_function_object, native_object->handle_closed_event_function_handle_method_id);
+    return;
+  }
+  environment[0]->CallVoidMethod(environment, native_object->io_completion_sink_function_object, native_object->io_completion_sink_function_handle_io_completed_method_id, (jni_int_t) entry->operation_id, (jni_int_t) entry->result, (jni_int_t) entry->error_number);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_io_rings(carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_rings_t *const io_rings = &loop_data->io_rings;
+  carlie_tcp_server_io_rings_overflowed_completion_t * completion = io_rings->overflowed_completions;
+  while (completion != null_ptr) {
+    carlie_tcp_server_io_rings_overflowed_completion_t *const next_completion = completion->next_completion;
+    free(completion);
+    completion = next_completion;
+  }
+  io_rings->overflowed_completions = null_ptr;
+  io_rings->overflowed_completions_tail = null_ptr;
+  carlie_tcp_server_io_ring_destroy(&io_rings->completion_ring);
+  carlie_tcp_server_io_ring_destroy(&io_rings->submission_ring);
+  io_rings->is_enabled = false;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_io_uring_transport(carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+  if (! transport->is_enabled) return;
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_io_uring_destroy(&transport->ring);
+#endif
+  transport->is_enabled = false;
+}
+
+
+
+// NOTE: Only meant for loops that never got to run (i.e., when the server
+// fails to initialize); a running loop tears itself down in `uvRun(…)`.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_destroy_loop_data(carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  uv_close((uv_handle_t *) loop_data->command_queue_async_handle, null_ptr);
+  // NOTE: The loop has to run once for the close to complete.
+  uv_run(loop_data->loop_handle, UV_RUN_NOWAIT);
+  int32_t const uv_result = (int32_t) uv_loop_close(loop_data->loop_handle);
+  assert(uv_result != UV_EBUSY);
+  carlie_tcp_server_buffer_pool_drain(&loop_data->read_buffer_pool);
+}
+
+
+
+// NOTE: Runs whatever the JVM side has submitted so far, a ring’s worth at
+// most, so that a busy submitter can’t keep the loop from getting to its
+// other handles. The loop is awake anyway, so the JVM side doesn’t have to
+// ring its doorbell until it gets armed again.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_drain_io_rings(jni_environment_handle_t const environment,
+                                 carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_rings_t *const io_rings = &loop_data->io_rings;
+  __atomic_store_n(&io_rings->submission_ring.header->needs_wake_up, 0u, __ATOMIC_RELAXED);
+  carlie_tcp_server_flush_overflowed_io_ring_completions(environment, loop_data);
+  carlie_tcp_server_io_ring_submission_entry_t entry;
+  for (uint32_t i = 0u; (i < CARLIE_TCP_SERVER_IO_RING_CAPACITY) && carlie_tcp_server_io_ring_take_submission(&io_rings->submission_ring, &entry); i++) {
+    carlie_tcp_server_run_io_ring_submission(environment, loop_data, &entry);
+  }
+}
+
+
+
+// NOTE: The duplicate is close-on-exec, same as the sockets libuv creates.
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_duplicate_socket(uv_tcp_t *const tcp_handle,
+                                   int *const socket_descriptor_ptr)
+{
+#if ! defined(_WIN32)
+  uv_os_fd_t socket_descriptor;
+  int32_t const uv_result = (int32_t) uv_fileno((uv_handle_t *) tcp_handle, &socket_descriptor);
+  if (uv_result < 0) return uv_result;
+  int const duplicate_socket_descriptor = fcntl((int) socket_descriptor, F_DUPFD_CLOEXEC, 0);
+  if (duplicate_socket_descriptor < 0) {
+    return (int32_t) uv_translate_sys_error(errno);
+  }
+  socket_descriptor_ptr[0] = duplicate_socket_descriptor;
+  return 0;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(tcp_handle);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(socket_descriptor_ptr);
+  return UV_ENOTSUP;
+#endif
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_emit_uv_error_event(jni_environment_handle_t const environment,
+                                      carlie_tcp_server_native_object_t *const native_object,
+                                      int32_t const error_number)
+{
+  jni_object_t exception_object = null_ptr;
+  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_create_uv_exception(environment, native_object, error_number, &exception_object);
+  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
+    return carlie_result;
+  }
+  environment[0]->CallVoidMethod(environment, native_object->handle_error_occurred_event_function_object, native_object->handle_error_occurred_event_function_handle_method_id, exception_object);
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+// NOTE: Tears down a loop that has stopped running (i.e., once all of its
+// handles have closed), and lets `waitForUvLoops(…)` know about it.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_finish_loop(carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  // NOTE: Nothing may be left in io_uring’s hands once the loop is gone (its
+  // operations were cancelled when the server closed, so this is only about
+  // the ones that got started in the meantime).
+  carlie_tcp_server_cancel_io_uring_operations(loop_data->environment, loop_data, null_ptr);
+  // NOTE: Same goes for connections that were accepted after the accept
+  // batch’s check handle last ran.
+  carlie_tcp_server_flush_accept_batch(loop_data->environment, loop_data);
+  // NOTE: Completions that come in while handles close (e.g., cancelled writes)
+  // can outlive the check handle, so whatever is left goes out now.
+  carlie_tcp_server_flush_io_completion_batch(loop_data->environment, loop_data);
+  // NOTE: Same goes for completions still waiting for room in the completion
+  // ring; with the loop gone, there’s no one left to move them over later on.
+  carlie_tcp_server_flush_overflowed_io_ring_completions(loop_data->environment, loop_data);
+  carlie_tcp_server_io_rings_overflowed_completion_t * completion = loop_data->io_rings.overflowed_completions;
+  while (completion != null_ptr) {
+    carlie_tcp_server_io_rings_overflowed_completion_t *const next_completion = completion->next_completion;
+    carlie_tcp_server_deliver_io_ring_completion(loop_data->environment, &completion->entry);
+    free(completion);
+    completion = next_completion;
+  }
+  loop_data->io_rings.overflowed_completions = null_ptr;
+  loop_data->io_rings.overflowed_completions_tail = null_ptr;
+  carlie_tcp_server_buffer_pool_drain(&loop_data->read_buffer_pool);
+  uv_loop_set_data(loop_data->loop_handle, null_ptr);
+  int32_t const uv_result = (int32_t) uv_loop_close(loop_data->loop_handle);
+  assert(uv_result != UV_EBUSY);
+  uv_sem_post(&loop_data->server_native_object->loops_stopped_semaphore);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_flush_accept_batch(jni_environment_handle_t const environment,
+                                     carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_accept_batch_t *const batch = &loop_data->accept_batch;
+  size_t const count = batch->count;
+  if (count == 0u) return;
+  // NOTE: Reset beforehand, same as with completion batches.
+  batch->count = 0u;
+  carlie_tcp_server_native_object_t *const server_native_object = loop_data->server_native_object;
+  environment[0]->CallVoidMethod(environment, server_native_object->accept_batch_sink_function_object, server_native_object->accept_batch_sink_function_handle_clients_connected_batch_method_id, batch->connections_array, (jni_int_t) (int32_t) count);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_flush_io_completion_batch(jni_environment_handle_t const environment,
+                                            carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_completion_batch_t *const batch = &loop_data->io_completion_batch;
+  size_t const count = batch->count;
+  if (count == 0u) return;
+  // NOTE: Reset beforehand, so that the batch is ready for more completions
+  // by the time the JVM side gets to handle these ones.
+  batch->count = 0u;
+  carlie_tcp_server_native_object_t *const server_native_object = loop_data->server_native_object;
+  environment[0]->SetIntArrayRegion(environment, (jni_int_array_t) batch->values_array, (jni_size_t) 0, (jni_size_t) (count * 3u), (jni_int_t const *) batch->values);
+  environment[0]->CallVoidMethod(environment, server_native_object->io_completion_batch_sink_function_object, server_native_object->io_completion_batch_sink_function_handle_io_completed_batch_method_id, batch->sinks_array, batch->values_array, (jni_int_t) (int32_t) count);
+}
+
+
+
+// NOTE: Submits whatever got queued during the current round of callbacks,
+// with a single system call. Entries that can’t be submitted right now stay
+// queued, and go out with the next flush.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_flush_io_uring(jni_environment_handle_t const environment,
+                                 carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_io_uring_t *const ring = &loop_data->io_uring_transport.ring;
+  if (! carlie_tcp_server_io_uring_needs_flush(ring)) return;
+  int32_t const uv_result = carlie_tcp_server_io_uring_enter(ring, 0u);
+  if ((uv_result >= 0) ||
+      (uv_result == UV_EAGAIN) ||
+      (uv_result == UV_EBUSY)) {
+    return;
+  }
+  int32_t const jni_result = (int32_t) environment[0]->PushLocalFrame(environment, (jni_int_t) 5);
+  // There’s no point in doing anything extra here.
+  if (jni_result != 0) return;
+  carlie_tcp_server_emit_uv_error_event(environment, loop_data->server_native_object, uv_result);
+  environment[0]->PopLocalFrame(environment, null_ptr);
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(environment);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(loop_data);
+#endif
+}
+
+
+
+// NOTE: Moves as many of the overflowed completions as there’s room for into
+// the completion ring, in order; the JVM side rings the loop’s doorbell when
+// it makes room while `has_overflowed` is set.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_flush_overflowed_io_ring_completions(jni_environment_handle_t const environment,
+                                                       carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_rings_t *const io_rings = &loop_data->io_rings;
+  carlie_tcp_server_io_rings_overflowed_completion_t * completion = io_rings->overflowed_completions;
+  if (completion == null_ptr) return;
+  while ((completion != null_ptr) &&
+         carlie_tcp_server_io_ring_put_completion(&io_rings->completion_ring, &completion->entry)) {
+    carlie_tcp_server_io_rings_overflowed_completion_t *const next_completion = completion->next_completion;
+    free(completion);
+    completion = next_completion;
+  }
+  io_rings->overflowed_completions = completion;
+  if (completion == null_ptr) {
+    io_rings->overflowed_completions_tail = null_ptr;
+    __atomic_store_n(&io_rings->completion_ring.header->has_overflowed, 0u, __ATOMIC_SEQ_CST);
+  }
+  carlie_tcp_server_wake_up_io_ring_consumer(environment, loop_data);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_get_jni_environment_from_server_native_object(carlie_tcp_server_native_object_t *const native_object,
+                                                                jni_environment_handle_t *const environment_ptr)
+{
+  jni_java_vm_t *const java_vm = native_object->java_vm;
+  // NOTE: Due to how `native_object`’s data is managed, it shouldn’t be
+  // possible for it to be non-null and have a null `java_vm` member.
+  assert(java_vm != null_ptr);
+  int32_t jni_result = (int32_t) java_vm[0]->GetEnv(java_vm, (void **) environment_ptr, JNI_VERSION);
+  if (jni_result != JNI_OK) {
+    // TODO: Investigate the ins and outs of how this works, thoroughly.
+    jni_result = (int32_t) java_vm[0]->AttachCurrentThread(java_vm, (void **) environment_ptr, null_ptr);
+    if (jni_result != JNI_OK) {
+      environment_ptr[0] = null_ptr;
+      return CARLIE_TCP_SERVER_RESULT_CANNOT_RETRIEVE_JNI_ENVIRONMENT;
+    }
+  }
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+// NOTE: A full submission queue gets submitted right away (rather than at the
+// end of the current round of callbacks), to make room for the entry.
+CARLIE_C_ALWAYS_INLINE static inline struct io_uring_sqe *
+carlie_tcp_server_get_io_uring_submission_entry(carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_uring_t *const ring = &loop_data->io_uring_transport.ring;
+  struct io_uring_sqe *const entry = carlie_tcp_server_io_uring_get_submission_entry(ring);
+  if (entry != null_ptr) {
+    return entry;
+  }
+  carlie_tcp_server_io_uring_enter(ring, 0u);
+  return carlie_tcp_server_io_uring_get_submission_entry(ring);
+}
+#endif
+
+
+
+// NOTE: `SOMAXCONN` is only what the system headers know of; on Linux, the
+// kernel caps backlogs at `net.core.somaxconn` instead, which is usually set a
+// lot higher on servers.
+CARLIE_C_ALWAYS_INLINE static inline int
+carlie_tcp_server_get_maximum_listen_backlog(void)
+{
+  int maximum_listen_backlog = SOMAXCONN;
+#if defined(__linux__)
+  FILE *const file = fopen("/proc/sys/net/core/somaxconn", "r");
+  if (file != null_ptr) {
+    int value;
+    if ((fscanf(file, "%d", &value) == 1) &&
+        (value > 0)) {
+      maximum_listen_backlog = value;
+    }
+    fclose(file);
+  }
+#endif
+  return maximum_listen_backlog;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_get_socket_option(uv_tcp_t *const tcp_handle,
+                                    int32_t const option_id,
+                                    int32_t *const value_ptr)
+{
+  int32_t uv_result;
+  switch (option_id) {
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_RECEIVE_BUFFER_SIZE:
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_SEND_BUFFER_SIZE: {
+      // NOTE: A size of `0` makes libuv get the size, rather than set it.
+      int buffer_size = 0;
+      uv_result = (option_id == CARLIE_TCP_SERVER_SOCKET_OPTION_RECEIVE_BUFFER_SIZE) ?
+        (int32_t) uv_recv_buffer_size((uv_handle_t *) tcp_handle, &buffer_size) :
+        (int32_t) uv_send_buffer_size((uv_handle_t *) tcp_handle, &buffer_size);
+      if (uv_result < 0) return uv_result;
+      value_ptr[0] = (int32_t) buffer_size;
+      return 0;
+    }
+    default: {
+      break;
+    }
+  }
+#if ! defined(_WIN32)
+  int level;
+  int name;
+  if (! carlie_tcp_server_resolve_socket_option(option_id, &level, &name)) return UV_ENOTSUP;
+  uv_os_fd_t socket_descriptor;
+  uv_result = (int32_t) uv_fileno((uv_handle_t *) tcp_handle, &socket_descriptor);
+  if (uv_result < 0) return uv_result;
+  if (option_id == CARLIE_TCP_SERVER_SOCKET_OPTION_LINGER) {
+    struct linger linger_value;
+    socklen_t linger_value_size = (socklen_t) sizeof(linger_value);
+    if (getsockopt((int) socket_descriptor, level, name, (void *) &linger_value, &linger_value_size) != 0) {
+      return (int32_t) uv_translate_sys_error(errno);
+    }
+    value_ptr[0] = (linger_value.l_onoff != 0) ? (int32_t) linger_value.l_linger : -1;
+    return 0;
+  }
+  int option_value = 0;
+  socklen_t option_value_size = (socklen_t) sizeof(option_value);
+  if (getsockopt((int) socket_descriptor, level, name, (void *) &option_value, &option_value_size) != 0) {
+    return (int32_t) uv_translate_sys_error(errno);
+  }
+  value_ptr[0] = (int32_t) option_value;
+  return 0;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(value_ptr);
+  return UV_ENOTSUP;
+#endif
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_get_uv_address(jni_environment_handle_t const environment,
+                                 carlie_tcp_server_native_object_t *const native_object,
+                                 uv_tcp_t *const tcp_handle,
+                                 int (*const uv_get_address_function)(uv_tcp_t const *const tcp_handle,
+                                                                      struct sockaddr *const socket_address_ptr,
+                                                                      int *const socket_address_size_ptr),
+                                 jni_object_t const create_address_method_function_object,
+                                 jni_class_t const create_address_method_function_class,
+                                 jni_object_t *const address_object_ptr)
+{
+  jni_method_id_t const create_address_method_function_invoke_method_id = environment[0]->GetMethodID(environment, create_address_method_function_class, "invoke", "(Ljava/lang/Object;Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+  if (create_address_method_function_invoke_method_id == null_ptr) {
+    carlie_throw_null_pointer_exception(environment, native_object->null_pointer_exception_class, native_object->null_pointer_exception_constructor_method_id);
+    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
   }
+  struct sockaddr_storage socket_address;
+  size_t socket_address_size = sizeof(socket_address);
   int32_t uv_result;
-  uv_result = (int32_t) uv_async_init(native_object->loop_handle, async_close_handle, carlie_tcp_server_handle_async_uv_close);
+  uv_result = (int32_t) uv_get_address_function(tcp_handle, (struct sockaddr *) &socket_address, (int *) &socket_address_size);
   if (uv_result < 0) {
-    uv_result_ptr[0] = uv_result;
-    free(async_close_handle);
+    carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
     return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
   }
-  carlie_tcp_server_async_uv_close_data_t *const async_close_data = malloc(sizeof(carlie_tcp_server_async_uv_close_data_t));
-  if (async_close_data == null_ptr) {
+  char address_ip[INET6_ADDRSTRLEN];
+  uint16_t address_port;
+  uint8_t address_version;
+  if (socket_address.ss_family == AF_INET) {
+    struct sockaddr_in const *const socket_address_v4_ptr = (struct sockaddr_in *) &socket_address;
+    uv_result = (int32_t) uv_ip4_name(socket_address_v4_ptr, address_ip, (size_t) INET6_ADDRSTRLEN);
+    if (uv_result < 0) {
+      carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+      return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+    }
+    address_port = ntohs(socket_address_v4_ptr->sin_port);
+    address_version = 4u;
+  } else if (socket_address.ss_family == AF_INET6) {
+    struct sockaddr_in6 const *const socket_address_v6_ptr = (struct sockaddr_in6 *) &socket_address;
+    uv_result = (int32_t) uv_ip6_name(socket_address_v6_ptr, address_ip, (size_t) INET6_ADDRSTRLEN);
+    if (uv_result < 0) {
+      carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
+      return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+    }
+    address_port = ntohs(socket_address_v6_ptr->sin6_port);
+    address_version = 6u;
+  } else {
+    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
+    return CARLIE_TCP_SERVER_RESULT_RUNTIME_EXCEPTION_THROWN;
+  }
+  jni_string_t const address_ip_string = environment[0]->NewStringUTF(environment, address_ip);
+  if (address_ip_string == null_ptr) {
+    carlie_throw_null_pointer_exception(environment, native_object->null_pointer_exception_class, native_object->null_pointer_exception_constructor_method_id);
+    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  }
+  jni_object_t const address_port_object = environment[0]->NewObject(environment, native_object->integer_class, native_object->integer_constructor_method_id, (jni_int_t) (int32_t) address_port);
+  jni_object_t const address_version_object = environment[0]->NewObject(environment, native_object->integer_class, native_object->integer_constructor_method_id, (jni_int_t) (int32_t) address_version);
+  if ((address_port_object == null_ptr) ||
+      (address_version_object == null_ptr)) {
+    carlie_throw_null_pointer_exception(environment, native_object->null_pointer_exception_class, native_object->null_pointer_exception_constructor_method_id);
+    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  }
+  address_object_ptr[0] = environment[0]->CallObjectMethod(environment, create_address_method_function_object, create_address_method_function_invoke_method_id, address_ip_string, address_version_object, address_port_object);
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+// NOTE: Called on the accepting loop’s thread. A socket can’t be moved from
+// one loop to another, so the accepted socket gets duplicated, and the
+// accepting loop’s handle closed; the duplicate is handed over once the close
+// completes (see `carlie_tcp_server_handle_uv_connection_handed_off(…)`).
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_hand_off_connection(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                      carlie_tcp_server_native_object_loop_data_t *const serving_loop_data,
+                                      int32_t *const uv_result_ptr)
+{
+  carlie_tcp_server_connection_handoff_data_t *const data = malloc(sizeof(carlie_tcp_server_connection_handoff_data_t));
+  if (data == null_ptr) {
     uv_result_ptr[0] = 0;
-    free(async_close_handle);
     return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
   }
-  async_close_data->handle = handle;
-  async_close_data->callback = callback;
-  uv_handle_set_data((uv_handle_t *) async_close_handle, (void *) async_close_data);
-  uv_result = (int32_t) uv_async_send(async_close_handle);
+  int32_t uv_result;
+  uv_result = (int32_t) uv_tcp_init(loop_data->loop_handle, &data->tcp_handle_);
+  if (uv_result < 0) {
+    free(data);
+    uv_result_ptr[0] = uv_result;
+    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+  }
+  data->loop_data = serving_loop_data;
+  data->socket_descriptor = -1;
+  uv_handle_set_data((uv_handle_t *) &data->tcp_handle_, (void *) data);
+  uv_result = (int32_t) uv_accept((uv_stream_t *) loop_data->tcp_handle, (uv_stream_t *) &data->tcp_handle_);
+#if ! defined(_WIN32)
+  uv_os_fd_t accepted_socket_descriptor;
+  if (uv_result >= 0) {
+    uv_result = (int32_t) uv_fileno((uv_handle_t *) &data->tcp_handle_, &accepted_socket_descriptor);
+  }
+  if (uv_result >= 0) {
+    data->socket_descriptor = fcntl((int) accepted_socket_descriptor, F_DUPFD_CLOEXEC, 0);
+    if (data->socket_descriptor < 0) {
+      uv_result = (int32_t) uv_translate_sys_error(errno);
+    }
+  }
+#else
+  // NOTE: There’s no portable way of duplicating a socket here, so handing
+  // connections off isn’t supported (yet) on this platform.
+  if (uv_result >= 0) {
+    uv_result = (int32_t) UV_ENOTSUP;
+  }
+#endif
   if (uv_result < 0) {
+    uv_close((uv_handle_t *) &data->tcp_handle_, carlie_tcp_server_handle_uv_connection_handed_off);
     uv_result_ptr[0] = uv_result;
-    free(async_close_data);
-    free(async_close_handle);
     return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
   }
+  uv_close((uv_handle_t *) &data->tcp_handle_, carlie_tcp_server_handle_uv_connection_handed_off);
   uv_result_ptr[0] = 0;
   return CARLIE_TCP_SERVER_RESULT_SUCCESS;
 }
@@ -381,363 +2899,1052 @@ carlie_tcp_server_async_uv_close(carlie_tcp_server_native_object_t *const native
 
 
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_async_uv_read(jni_environment_handle_t const environment,
-                                carlie_tcp_server_connection_native_object_t *const native_object,
-                                jni_byte_array_t buffer_bytes,
-                                size_t const buffer_bytes_size,
-                                jni_object_t callback_function_object,
-                                jni_method_id_t const callback_function_invoke_method_id,
-                                int32_t *const uv_result_ptr)
+carlie_tcp_server_initialize_loop_data(carlie_tcp_server_native_object_t *const native_object,
+                                       carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                       int32_t *const uv_result_ptr)
 {
-  uv_async_t *const async_read_handle = calloc(1u, sizeof(uv_async_t));
-  if (async_read_handle == null_ptr) {
-    uv_result_ptr[0] = 0;
-    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
-  }
   int32_t uv_result;
-  uv_result = (int32_t) uv_async_init(native_object->server_native_object->loop_handle, async_read_handle, carlie_tcp_server_handle_async_uv_read);
+  loop_data->loop_handle = &loop_data->loop_handle_;
+  uv_result = (int32_t) uv_loop_init(loop_data->loop_handle);
   if (uv_result < 0) {
     uv_result_ptr[0] = uv_result;
-    free(async_read_handle);
     return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
   }
-  carlie_tcp_server_async_uv_read_data_t *const async_read_data = malloc(sizeof(carlie_tcp_server_async_uv_read_data_t));
-  if (async_read_data == null_ptr) {
-    uv_result_ptr[0] = 0;
-    free(async_read_handle);
-    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  // NOTE: All the commands posted from other threads (reads, writes, closes,
+  // etc.) go through this single handle, which lives as long as the loop.
+  carlie_tcp_server_command_queue_initialize(&loop_data->command_queue);
+  loop_data->command_queue_async_handle = &loop_data->command_queue_async_handle_;
+  uv_result = (int32_t) uv_async_init(loop_data->loop_handle, loop_data->command_queue_async_handle, carlie_tcp_server_handle_command_queue_async);
+  if (uv_result < 0) {
+    uv_loop_close(loop_data->loop_handle);
+    uv_result_ptr[0] = uv_result;
+    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
   }
-  uint8_t * buffer;
-  carlie_get_array_bytes(environment, buffer_bytes, &buffer);
-  buffer_bytes = (jni_byte_array_t) environment[0]->NewGlobalRef(environment, (jni_object_t) buffer_bytes);
-  if (buffer_bytes == null_ptr) {
-    carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    uv_result_ptr[0] = 0;
-    carlie_release_array_bytes(environment, buffer, buffer_bytes, (int32_t) JNI_ABORT);
-    free(async_read_data);
-    free(async_read_handle);
-    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  uv_handle_set_data((uv_handle_t *) loop_data->command_queue_async_handle, (void *) loop_data);
+  carlie_tcp_server_buffer_pool_initialize(&loop_data->read_buffer_pool);
+  loop_data->server_native_object = native_object;
+  loop_data->tcp_handle = &loop_data->tcp_handle_;
+  uv_result_ptr[0] = 0;
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+// NOTE: libuv doesn’t get to listen on the listener of a loop that uses
+// io_uring: its socket is made to listen here, and the loop accepts
+// connections on it with a multishot accept, once it gets the command.
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_listen_on_io_uring(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                     int const backlog)
+{
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+  uv_os_fd_t socket_descriptor;
+  int32_t const uv_result = (int32_t) uv_fileno((uv_handle_t *) loop_data->tcp_handle, &socket_descriptor);
+  if (uv_result < 0) {
+    return uv_result;
   }
-  callback_function_object = environment[0]->NewGlobalRef(environment, callback_function_object);
-  if (callback_function_object == null_ptr) {
-    carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    uv_result_ptr[0] = 0;
-    carlie_release_array_bytes(environment, buffer, buffer_bytes, (int32_t) JNI_ABORT);
-    environment[0]->DeleteGlobalRef(environment, (jni_object_t) buffer_bytes);
-    free(async_read_data);
-    free(async_read_handle);
-    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  if (listen((int) socket_descriptor, backlog) != 0) {
+    return (int32_t) uv_translate_sys_error(errno);
   }
-  async_read_data->async_handle = async_read_handle;
-  async_read_data->buffer = buffer;
-  async_read_data->buffer_array = buffer_bytes;
-  async_read_data->buffer_size = buffer_bytes_size;
-  async_read_data->callback_function_invoke_method_id = callback_function_invoke_method_id;
-  async_read_data->callback_function_object = callback_function_object;
-  async_read_data->native_object = native_object;
-  uv_handle_set_data((uv_handle_t *) async_read_handle, (void *) async_read_data);
-  uv_result = (int32_t) uv_async_send(async_read_handle);
+  transport->listener_socket_descriptor = (int) socket_descriptor;
+  carlie_tcp_server_post_command(loop_data, &transport->accept_command, carlie_tcp_server_handle_async_io_uring_accept);
+  return 0;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(loop_data);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(backlog);
+  return (int32_t) UV_ENOTSUP;
+#endif
+}
+
+
+
+// NOTE: libuv (as of v1.32) has no way of setting `SO_REUSEPORT` on a socket
+// before binding it, so the socket is created here, and handed over to the
+// (initialized, but not yet bound) handle, which takes ownership of it.
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_open_reuse_port_socket(uv_tcp_t *const tcp_handle,
+                                         int const address_family,
+                                         int32_t *const uv_result_ptr)
+{
+#if defined(SO_REUSEPORT)
+  int const socket_descriptor = socket(address_family, SOCK_STREAM, 0);
+  if (socket_descriptor < 0) {
+    uv_result_ptr[0] = (int32_t) uv_translate_sys_error(errno);
+    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+  }
+  int const socket_option_value = 1;
+  int32_t const result = (int32_t) setsockopt(socket_descriptor, SOL_SOCKET, SO_REUSEPORT, &socket_option_value, (socklen_t) sizeof(socket_option_value));
+  if (result != 0) {
+    uv_result_ptr[0] = (int32_t) uv_translate_sys_error(errno);
+    close(socket_descriptor);
+    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+  }
+  int32_t const uv_result = (int32_t) uv_tcp_open(tcp_handle, (uv_os_sock_t) socket_descriptor);
   if (uv_result < 0) {
     uv_result_ptr[0] = uv_result;
-    environment[0]->DeleteGlobalRef(environment, callback_function_object);
-    carlie_release_array_bytes(environment, buffer, buffer_bytes, (int32_t) JNI_ABORT);
-    environment[0]->DeleteGlobalRef(environment, (jni_object_t) buffer_bytes);
-    free(async_read_data);
-    free(async_read_handle);
+    close(socket_descriptor);
     return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
   }
   uv_result_ptr[0] = 0;
   return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(tcp_handle);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(address_family);
+  uv_result_ptr[0] = (int32_t) UV_ENOTSUP;
+  return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+#endif
+}
+
+
+
+// NOTE: Pauses a streaming read that goes through io_uring: its multishot
+// receive gets cancelled (without stopping the read), and the read is put on
+// hold once the receive’s last completion has been handled. If the cancellation
+// can’t be submitted, that happens whenever the receive ends by itself.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_pause_io_uring_read(carlie_tcp_server_async_uv_read_data_t *const data)
+{
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  struct io_uring_sqe *const entry = carlie_tcp_server_get_io_uring_submission_entry(data->native_object->loop_data);
+  if (entry == null_ptr) return;
+  entry->opcode = (uint8_t) IORING_OP_ASYNC_CANCEL;
+  entry->fd = -1;
+  entry->addr = ((uint64_t) (uintptr_t) data) | CARLIE_TCP_SERVER_IO_URING_OPERATION_READ;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(data);
+#endif
+}
+
+
+
+// NOTE: Only the first loop listens when connections get handed off; it deals
+// out the connections it accepts to all the loops (itself included) in turn.
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_native_object_loop_data_t *
+carlie_tcp_server_pick_serving_loop_data(carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_native_object_t *const server_native_object = loop_data->server_native_object;
+  if (! server_native_object->uses_acceptor_handoff) {
+    return loop_data;
+  }
+  carlie_tcp_server_native_object_loop_data_t *const serving_loop_data = &server_native_object->loops_data[server_native_object->next_serving_loop_index];
+  server_native_object->next_serving_loop_index = (server_native_object->next_serving_loop_index + 1u) % server_native_object->loops_count;
+  return serving_loop_data;
+}
+
+
+
+// NOTE: Commands can be posted from any thread; they are dispatched, in the
+// order they were posted, on the loop’s thread. The loop only gets woken up
+// when the queue was empty (`uv_async_send(…)` coalesces wake-ups anyway).
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_post_command(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                               carlie_tcp_server_command_t *const command,
+                               carlie_tcp_server_command_handler_t const handler)
+{
+  command->handler = handler;
+  bool const command_queue_was_empty = carlie_tcp_server_command_queue_push(&loop_data->command_queue, command);
+  if (! command_queue_was_empty) return;
+  // NOTE: This can’t fail for an initialized handle (and there’s no way to
+  // take the command back out of the queue anyway).
+  int32_t const uv_result = (int32_t) uv_async_send(loop_data->command_queue_async_handle);
+  assert(uv_result == 0);
+}
+
+
+
+// NOTE: Completions that don’t fit into the completion ring (and all the ones
+// that come after them, so that none overtakes another) wait in a list, until
+// the JVM side makes room for them.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_post_io_ring_completion(jni_environment_handle_t const environment,
+                                          carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                          carlie_tcp_server_io_ring_completion_entry_t const *const entry)
+{
+  carlie_tcp_server_io_rings_t *const io_rings = &loop_data->io_rings;
+  if ((io_rings->overflowed_completions == null_ptr) &&
+      carlie_tcp_server_io_ring_put_completion(&io_rings->completion_ring, entry)) {
+    carlie_tcp_server_wake_up_io_ring_consumer(environment, loop_data);
+    return;
+  }
+  carlie_tcp_server_io_rings_overflowed_completion_t *const completion = malloc(sizeof(carlie_tcp_server_io_rings_overflowed_completion_t));
+  if (completion == null_ptr) {
+    carlie_tcp_server_deliver_io_ring_completion(environment, entry);
+    return;
+  }
+  completion->entry = entry[0];
+  completion->next_completion = null_ptr;
+  if (io_rings->overflowed_completions_tail != null_ptr) {
+    io_rings->overflowed_completions_tail->next_completion = completion;
+  } else {
+    io_rings->overflowed_completions = completion;
+  }
+  io_rings->overflowed_completions_tail = completion;
+  __atomic_store_n(&io_rings->completion_ring.header->has_overflowed, 1u, __ATOMIC_SEQ_CST);
+  carlie_tcp_server_wake_up_io_ring_consumer(environment, loop_data);
+}
+
+
+
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_reap_io_uring_completions(jni_environment_handle_t const environment,
+                                           carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_uring_t *const ring = &loop_data->io_uring_transport.ring;
+  struct io_uring_cqe * completion_entry;
+  while ((completion_entry = carlie_tcp_server_io_uring_peek_completion(ring)) != null_ptr) {
+    uint64_t const user_data = completion_entry->user_data;
+    int32_t const result = completion_entry->res;
+    uint32_t const flags = completion_entry->flags;
+    // NOTE: The entry goes back to the kernel before it gets handled, since
+    // handling it may well take a while (e.g., calling into the JVM).
+    carlie_tcp_server_io_uring_consume_completion(ring);
+    void *const operation_data = (void *) (uintptr_t) (user_data & ~((uint64_t) CARLIE_TCP_SERVER_IO_URING_OPERATION_KIND_MASK));
+    switch ((uint32_t) (user_data & CARLIE_TCP_SERVER_IO_URING_OPERATION_KIND_MASK)) {
+      case CARLIE_TCP_SERVER_IO_URING_OPERATION_ACCEPT: {
+        carlie_tcp_server_complete_io_uring_accept(environment, (carlie_tcp_server_native_object_loop_data_t *) operation_data, result, flags);
+        break;
+      }
+      case CARLIE_TCP_SERVER_IO_URING_OPERATION_READ: {
+        carlie_tcp_server_complete_io_uring_read(environment, (carlie_tcp_server_async_uv_read_data_t *) operation_data, result, flags);
+        break;
+      }
+      case CARLIE_TCP_SERVER_IO_URING_OPERATION_WRITE: {
+        carlie_tcp_server_complete_io_uring_write(environment, (carlie_tcp_server_async_uv_write_data_t *) operation_data, result);
+        break;
+      }
+      default: {
+        // NOTE: Cancellations, whose outcome shows in the operations they
+        // cancel.
+        break;
+      }
+    }
+  }
+}
+#endif
+
+
+
+// NOTE: Called on the source’s loop, whenever the source is readable or the
+// destination writable (depending on which one the relay waits for). Moves
+// data until the source has nothing more for now, the destination doesn’t take
+// any more, or a turn’s worth has been moved. The source’s end of stream gets
+// passed on to the destination (by shutting down its sending side), and ends
+// the relay.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_relay(jni_environment_handle_t const environment,
+                        carlie_tcp_server_async_uv_relay_data_t *const data)
+{
+#if ! defined(_WIN32)
+  size_t turn_bytes_count = 0u;
+  for (;;) {
+    while (data->buffered_bytes_count > 0u) {
+#if defined(__linux__)
+      long const result = syscall(__NR_splice, data->pipe_descriptors[0], null_ptr, data->destination_socket_descriptor, null_ptr, data->buffered_bytes_count, CARLIE_TCP_SERVER_RELAY_SPLICE_FLAGS);
+#else
+      ssize_t const result = write(data->destination_socket_descriptor, &data->buffer[data->buffered_bytes_offset], data->buffered_bytes_count);
+#endif
+      if (result < 0) {
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN) {
+          carlie_tcp_server_wait_for_relay_peer(environment, data, true);
+          return;
+        }
+        data->error_number = (int32_t) uv_translate_sys_error(errno);
+        carlie_tcp_server_stop_relay(environment, data);
+        return;
+      }
+      data->buffered_bytes_count -= (size_t) result;
+      data->buffered_bytes_offset += (size_t) result;
+    }
+    data->buffered_bytes_offset = 0u;
+    if (turn_bytes_count >= CARLIE_TCP_SERVER_RELAY_BYTES_PER_TURN_COUNT) break;
+#if defined(__linux__)
+    long const result = syscall(__NR_splice, data->source_socket_descriptor, null_ptr, data->pipe_descriptors[1], null_ptr, (size_t) CARLIE_TCP_SERVER_RELAY_CHUNK_SIZE, CARLIE_TCP_SERVER_RELAY_SPLICE_FLAGS);
+#else
+    ssize_t const result = read(data->source_socket_descriptor, data->buffer, CARLIE_TCP_SERVER_RELAY_CHUNK_SIZE);
+#endif
+    if (result < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN) break;
+      data->error_number = (int32_t) uv_translate_sys_error(errno);
+      carlie_tcp_server_stop_relay(environment, data);
+      return;
+    }
+    if (result == 0) {
+      shutdown(data->destination_socket_descriptor, SHUT_WR);
+      carlie_tcp_server_stop_relay(environment, data);
+      return;
+    }
+    data->buffered_bytes_count = (size_t) result;
+    turn_bytes_count += (size_t) result;
+  }
+  carlie_tcp_server_wait_for_relay_peer(environment, data, false);
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(environment);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(data);
+#endif
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
+carlie_tcp_server_release_async_uv_read_buffer(jni_environment_handle_t const environment,
+                                               carlie_tcp_server_async_uv_read_data_t *const data,
+                                               int32_t const mode)
+{
+  if (data->buffer_array != null_ptr) {
+    carlie_release_array_bytes(environment, data->buffer, data->buffer_array, mode);
+    environment[0]->DeleteGlobalRef(environment, (jni_object_t) data->buffer_array);
+  }
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
 }
 
 
 
 CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_async_uv_server_close(carlie_tcp_server_native_object_t *const native_object,
-                                        int32_t *const uv_result_ptr)
+carlie_tcp_server_release_async_uv_write_buffer(jni_environment_handle_t const environment,
+                                                carlie_tcp_server_async_uv_write_data_t *const data)
 {
-  uv_async_t *const async_server_close_handle = calloc(1u, sizeof(uv_async_t));
-  if (async_server_close_handle == null_ptr) {
-    uv_result_ptr[0] = 0;
-    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  if (data->buffer_array != null_ptr) {
+    carlie_release_array_bytes(environment, (uint8_t *) data->buffer->base, data->buffer_array, (int32_t) JNI_ABORT);
+    environment[0]->DeleteGlobalRef(environment, (jni_object_t) data->buffer_array);
+  }
+  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+}
+
+
+
+// NOTE: Only covers the options that are set with `setsockopt(…)` directly;
+// libuv has its own functions for the others.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_resolve_socket_option(int32_t const option_id,
+                                        int *const level_ptr,
+                                        int *const name_ptr)
+{
+#if ! defined(_WIN32)
+  switch (option_id) {
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_LINGER: {
+      level_ptr[0] = SOL_SOCKET;
+      name_ptr[0] = SO_LINGER;
+      return true;
+    }
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_NO_DELAY: {
+      level_ptr[0] = IPPROTO_TCP;
+      name_ptr[0] = TCP_NODELAY;
+      return true;
+    }
+#if defined(TCP_NOTSENT_LOWAT)
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_NOT_SENT_LOW_WATERMARK: {
+      level_ptr[0] = IPPROTO_TCP;
+      name_ptr[0] = TCP_NOTSENT_LOWAT;
+      return true;
+    }
+#endif
+#if defined(TCP_QUICKACK)
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_QUICK_ACK: {
+      level_ptr[0] = IPPROTO_TCP;
+      name_ptr[0] = TCP_QUICKACK;
+      return true;
+    }
+#endif
+#if defined(TCP_USER_TIMEOUT)
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_USER_TIMEOUT: {
+      level_ptr[0] = IPPROTO_TCP;
+      name_ptr[0] = TCP_USER_TIMEOUT;
+      return true;
+    }
+#endif
+    default: {
+      return false;
+    }
+  }
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(option_id);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(level_ptr);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(name_ptr);
+  return false;
+#endif
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline char const *
+carlie_tcp_server_result_get_value(carlie_tcp_server_result_t const status)
+{
+  switch (status) {
+    case CARLIE_TCP_SERVER_RESULT_CANNOT_CREATE_EXCEPTION:
+    case CARLIE_TCP_SERVER_RESULT_CANNOT_THROW_EXCEPTION:
+    case CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN:
+    case CARLIE_TCP_SERVER_RESULT_RUNTIME_EXCEPTION_THROWN:
+    case CARLIE_TCP_SERVER_RESULT_SUCCESS: {
+      return carlie_result_get_value((carlie_result_t) (unsigned int) status);
+    }
+    case CARLIE_TCP_SERVER_RESULT_CANNOT_RETRIEVE_JNI_ENVIRONMENT: {
+      return "JNI environment retrieval failed.";
+    }
+    case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
+      return "Memory allocation failed.";
+    }
+    case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
+      return "libuv failure.";
+    }
+    default: {
+      return carlie_result_get_value((carlie_result_t) (unsigned int) status);
+    }
+  }
+}
+
+
+
+// NOTE: Runs the server’s loop for as long as it has anything to do right away
+// (closing handles, pending callbacks, etc.), without ever blocking the group’s
+// loop; anything else gets picked up by the poll handle later on. Once the
+// server’s loop has nothing left to run, it gets detached from the group.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_run_attached_loop(carlie_tcp_server_event_loop_group_attachment_t *const attachment)
+{
+  uv_loop_t *const loop_handle = attachment->loop_data->loop_handle;
+  do {
+    uv_run(loop_handle, UV_RUN_NOWAIT);
+  } while ((uv_loop_alive(loop_handle) != 0) &&
+           (uv_backend_timeout(loop_handle) == 0));
+  if (uv_loop_alive(loop_handle) != 0) {
+    // NOTE: It’s the group’s loop that blocks from here on, not the server’s
+    // loop, so its rings have to be armed here too.
+    carlie_tcp_server_arm_io_rings(attachment->loop_data);
+    return;
+  }
+  uv_close((uv_handle_t *) attachment->poll_handle, carlie_tcp_server_handle_uv_event_loop_group_attachment_closed);
+}
+
+
+
+// NOTE: Runs a submission the same way as the command it stands for, right
+// away, since this is already the loop’s thread. The JVM side keeps the
+// buffers reachable until their operations complete, and only ever submits
+// direct buffers (see `IoSubmissionRing.kt`).
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_run_io_ring_submission(jni_environment_handle_t const environment,
+                                         carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                         carlie_tcp_server_io_ring_submission_entry_t const *const entry)
+{
+  carlie_tcp_server_connection_native_object_t *const native_object = (carlie_tcp_server_connection_native_object_t *) (uintptr_t) entry->connection_native_object_address;
+  assert(native_object != null_ptr);
+  assert(native_object->loop_data == loop_data);
+  carlie_tcp_server_native_object_t *const server_native_object = loop_data->server_native_object;
+  switch (entry->opcode) {
+    case CARLIE_TCP_SERVER_IO_RING_OPCODE_READ: {
+      carlie_tcp_server_async_uv_read_data_t *const async_read_data = carlie_tcp_server_record_pool_acquire(&server_native_object->async_uv_read_data_pool);
+      if (async_read_data == null_ptr) {
+        carlie_tcp_server_connection_complete_io(environment, native_object, entry->operation_id, 0, (int32_t) UV_ENOMEM);
+        return;
+      }
+      uint8_t *const buffer = (uint8_t *) (uintptr_t) entry->buffer_address;
+      async_read_data->buffer = buffer;
+      async_read_data->buffer_array = null_ptr;
+      async_read_data->buffer_count = 1u;
+      async_read_data->buffer_index = 0u;
+      async_read_data->buffers = async_read_data->buffers_;
+      async_read_data->buffers_[0].base = (char *) buffer;
+      async_read_data->buffers_[0].len = (size_t) entry->buffer_size;
+      async_read_data->bytes_read_count = 0u;
+      async_read_data->is_streaming = false;
+      async_read_data->read_buffer_pool_size_class_index = 0u;
+      async_read_data->operation_id = entry->operation_id;
+      async_read_data->native_object = native_object;
+      carlie_tcp_server_handle_async_uv_read(&async_read_data->command, loop_data->loop_handle);
+      return;
+    }
+    case CARLIE_TCP_SERVER_IO_RING_OPCODE_WRITE: {
+      carlie_tcp_server_async_uv_write_data_t *const async_write_data = carlie_tcp_server_record_pool_acquire(&server_native_object->async_uv_write_data_pool);
+      if (async_write_data == null_ptr) {
+        carlie_tcp_server_connection_complete_io(environment, native_object, entry->operation_id, 0, (int32_t) UV_ENOMEM);
+        // NOTE: The JVM side only submits a write through the ring while none
+        // of the connection’s other writes are pending, so this is the write
+        // the connection expects next; the ones after it mustn’t wait for it.
+        carlie_tcp_server_connection_start_writes(environment, native_object, carlie_tcp_server_connection_take_next_write(native_object, entry->operation_id));
+        return;
+      }
+      uv_buf_t *const buffer = async_write_data->buffers_;
+      buffer->base = (char *) (uintptr_t) entry->buffer_address;
+      buffer->len = (size_t) entry->buffer_size;
+      async_write_data->buffer = buffer;
+      async_write_data->buffer_array = null_ptr;
+      async_write_data->buffer_count = 1u;
+      async_write_data->native_object = native_object;
+      async_write_data->operation_id = entry->operation_id;
+      carlie_tcp_server_handle_async_uv_write(&async_write_data->command, loop_data->loop_handle);
+      return;
+    }
+    case CARLIE_TCP_SERVER_IO_RING_OPCODE_CLOSE: {
+      uv_handle_t *const handle = (uv_handle_t *) native_object->tcp_handle;
+      int32_t const uv_result = (int32_t) uv_is_closing(handle);
+      if (uv_result == 0) {
+        __atomic_fetch_or(&native_object->state, CARLIE_TCP_SERVER_CONNECTION_STATE_CLOSING, __ATOMIC_RELEASE);
+        carlie_tcp_server_cancel_io_uring_operations(environment, loop_data, native_object);
+        carlie_tcp_server_stop_relays(environment, loop_data, native_object);
+        uv_close(handle, carlie_tcp_server_handle_uv_connection_closed);
+      }
+      return;
+    }
+    default: {
+      // Unreachable in this case.
+      return;
+    }
   }
+}
+
+
+
+// NOTE: Called on the loop’s thread. Sends as much of the file as the socket
+// takes right away with `sendfile(…)`, i.e., straight from the page cache. Once
+// the socket doesn’t take any more (or a turn’s worth has been sent), the next
+// chunk is copied and written with `uv_write(…)` instead, which takes care of
+// waiting for the socket to become writable again; the transfer then carries on
+// from the write’s callback. Its completion is only reported once it’s done.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_send_file(jni_environment_handle_t const environment,
+                            carlie_tcp_server_async_uv_send_file_data_t *const data)
+{
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
   int32_t uv_result;
-  uv_result = (int32_t) uv_async_init(native_object->loop_handle, async_server_close_handle, carlie_tcp_server_handle_async_uv_server_close);
-  if (uv_result < 0) {
-    uv_result_ptr[0] = uv_result;
-    free(async_server_close_handle);
-    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+#if ! defined(_WIN32)
+  uv_os_fd_t socket_descriptor;
+  uv_result = (int32_t) uv_fileno((uv_handle_t *) native_object->tcp_handle, &socket_descriptor);
+  size_t turn_bytes_sent_count = 0u;
+  while ((uv_result == 0) &&
+         (data->bytes_sent_count < data->bytes_count)) {
+    size_t const remaining_bytes_count = data->bytes_count - data->bytes_sent_count;
+#if defined(__linux__)
+    if ((! data->sendfile_is_unsupported) &&
+        (turn_bytes_sent_count < CARLIE_TCP_SERVER_SEND_FILE_BYTES_PER_TURN_COUNT)) {
+      off_t file_offset = (off_t) data->file_offset;
+      ssize_t const result = sendfile(socket_descriptor, data->file_descriptor, &file_offset, remaining_bytes_count);
+      if (result > 0) {
+        data->bytes_sent_count += (size_t) result;
+        data->file_offset += (int64_t) result;
+        turn_bytes_sent_count += (size_t) result;
+        continue;
+      }
+      // NOTE: The end of the file has been reached.
+      if (result == 0) break;
+      if (errno == EINTR) continue;
+      if ((errno == EINVAL) ||
+          (errno == ENOSYS)) {
+        // NOTE: E.g., a file that can’t be mapped; it’s written with
+        // `uv_write(…)` only, from here on.
+        data->sendfile_is_unsupported = true;
+      } else if (errno != EAGAIN) {
+        uv_result = (int32_t) uv_translate_sys_error(errno);
+        break;
+      }
+    }
+#else
+    CARLIE_INTERNAL_UNUSED_SYMBOL(socket_descriptor);
+#endif
+    if (data->chunk == null_ptr) {
+      data->chunk = malloc(CARLIE_TCP_SERVER_SEND_FILE_CHUNK_SIZE);
+      if (data->chunk == null_ptr) {
+        uv_result = UV_ENOMEM;
+        break;
+      }
+    }
+    size_t const chunk_size = (remaining_bytes_count < CARLIE_TCP_SERVER_SEND_FILE_CHUNK_SIZE) ?
+      remaining_bytes_count :
+      CARLIE_TCP_SERVER_SEND_FILE_CHUNK_SIZE;
+    ssize_t const result = pread(data->file_descriptor, data->chunk, chunk_size, (off_t) data->file_offset);
+    if (result < 0) {
+      if (errno == EINTR) continue;
+      uv_result = (int32_t) uv_translate_sys_error(errno);
+      break;
+    }
+    if (result == 0) break;
+    data->chunk_buffer = uv_buf_init((char *) data->chunk, (unsigned int) result);
+    uv_req_set_data((uv_req_t *) &data->write_request, (void *) data);
+    if (! carlie_tcp_server_connection_enter_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_WRITING)) {
+      uv_result = UV_ECANCELED;
+      break;
+    }
+    carlie_tcp_server_connection_add_pending_write_bytes(environment, native_object, data->chunk_buffer.len);
+    uv_result = (int32_t) uv_write(&data->write_request, (uv_stream_t *) native_object->tcp_handle, &data->chunk_buffer, 1u, carlie_tcp_server_handle_async_uv_send_file_data_written);
+    carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_WRITING);
+    if (uv_result == 0) return;
+    carlie_tcp_server_connection_remove_pending_write_bytes(environment, native_object, data->chunk_buffer.len);
   }
-  uv_result = (int32_t) uv_async_send(async_server_close_handle);
+#else
+  uv_result = UV_ENOTSUP;
+#endif
   if (uv_result < 0) {
-    uv_result_ptr[0] = uv_result;
-    free(async_server_close_handle);
-    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, uv_result);
+  } else {
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, (int32_t) data->bytes_sent_count, 0);
   }
-  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+  carlie_tcp_server_destroy_async_uv_send_file_data(data);
 }
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_async_uv_write(jni_environment_handle_t const environment,
-                                 carlie_tcp_server_connection_native_object_t *const native_object,
-                                 jni_byte_array_t buffer_bytes,
-                                 size_t const buffer_bytes_size,
-                                 jni_object_t callback_function_object,
-                                 jni_method_id_t const callback_function_invoke_method_id,
-                                 int32_t *const uv_result_ptr)
+// NOTE: Called on the serving loop’s thread. The connection either gets
+// accepted from the loop’s own listener (when `socket_descriptor` is negative),
+// or takes over a socket that another loop accepted and handed off; in the
+// latter case, the socket is closed if the connection can’t take it over.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_serve_connection(jni_environment_handle_t const environment,
+                                   carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                                   int const socket_descriptor)
 {
-  uv_async_t *const async_write_handle = calloc(1u, sizeof(uv_async_t));
-  if (async_write_handle == null_ptr) {
-    uv_result_ptr[0] = 0;
-    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  carlie_tcp_server_native_object_t *const server_native_object = loop_data->server_native_object;
+  int32_t const jni_result = (int32_t) environment[0]->PushLocalFrame(environment, (jni_int_t) 3);
+  // There’s no point in doing anything extra here.
+  if (jni_result != 0) {
+    carlie_tcp_server_close_socket(socket_descriptor);
+    return;
   }
+  // NOTE: This object is a local reference that must be manually released.
+  jni_object_t connection_native_object_bytes = null_ptr;
+  carlie_tcp_server_connection_native_object_t * connection_native_object = null_ptr;
+  carlie_tcp_server_create_connection_native_object(environment, loop_data, &connection_native_object_bytes, &connection_native_object);
   int32_t uv_result;
-  uv_result = (int32_t) uv_async_init(native_object->server_native_object->loop_handle, async_write_handle, carlie_tcp_server_handle_async_uv_write);
-  if (uv_result < 0) {
-    uv_result_ptr[0] = uv_result;
-    free(async_write_handle);
-    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+  // NOTE: The connection stays in the opening state (hence not closeable) until
+  // its socket has been accepted.
+  jni_object_t const connection_object = environment[0]->CallObjectMethod(environment, server_native_object->create_connection_method_function_object, server_native_object->create_connection_method_function_invoke_method_id, connection_native_object_bytes);
+  if (! connection_native_object->tcp_handle_is_initialized) {
+    carlie_tcp_server_connection_leave_state(connection_native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_OPENING);
+    carlie_tcp_server_close_socket(socket_descriptor);
+    environment[0]->PopLocalFrame(environment, null_ptr);
+    return;
   }
-  carlie_tcp_server_async_uv_write_data_t *const async_write_data = malloc(sizeof(carlie_tcp_server_async_uv_write_data_t));
-  if (async_write_data == null_ptr) {
-    uv_result_ptr[0] = 0;
-    free(async_write_handle);
-    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  if (socket_descriptor < 0) {
+    uv_result = (int32_t) uv_accept((uv_stream_t *) loop_data->tcp_handle, (uv_stream_t *) connection_native_object->tcp_handle);
+  } else {
+    uv_result = (int32_t) uv_tcp_open(connection_native_object->tcp_handle, (uv_os_sock_t) socket_descriptor);
+    if (uv_result < 0) {
+      carlie_tcp_server_close_socket(socket_descriptor);
+    }
   }
-  uv_buf_t *const buffer = malloc(sizeof(uv_buf_t));
-  if (buffer == null_ptr) {
-    uv_result_ptr[0] = 0;
-    free(async_write_data);
-    free(async_write_handle);
-    return CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED;
+  // TODO: When can this happen?
+  if (uv_result < 0) {
+    carlie_tcp_server_connection_leave_state(connection_native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_OPENING);
+    environment[0]->PopLocalFrame(environment, null_ptr);
+    return;
   }
-  carlie_get_array_bytes(environment, buffer_bytes, (uint8_t **) &buffer->base);
-  buffer->len = buffer_bytes_size;
-  buffer_bytes = (jni_byte_array_t) environment[0]->NewGlobalRef(environment, (jni_object_t) buffer_bytes);
-  if (buffer_bytes == null_ptr) {
-    carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    uv_result_ptr[0] = 0;
-    carlie_release_array_bytes(environment, (uint8_t *) buffer->base, buffer_bytes, (int32_t) JNI_ABORT);
-    free(buffer);
-    free(async_write_data);
-    free(async_write_handle);
-    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  carlie_tcp_server_apply_default_socket_options(server_native_object, connection_native_object);
+  carlie_tcp_server_connection_leave_state(connection_native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_OPENING);
+  carlie_tcp_server_accept_batch_t *const accept_batch = &loop_data->accept_batch;
+  if (accept_batch->is_enabled) {
+    environment[0]->SetObjectArrayElement(environment, (jni_object_array_t) accept_batch->connections_array, (jni_size_t) accept_batch->count, connection_object);
+    accept_batch->count += 1u;
+    if (accept_batch->count == accept_batch->capacity) {
+      carlie_tcp_server_flush_accept_batch(environment, loop_data);
+    }
+  } else {
+    environment[0]->CallVoidMethod(environment, server_native_object->handle_client_connected_event_function_object, server_native_object->handle_client_connected_event_function_handle_method_id, connection_object);
   }
-  callback_function_object = environment[0]->NewGlobalRef(environment, callback_function_object);
-  if (callback_function_object == null_ptr) {
-    carlie_throw_null_pointer_exception(environment, native_object->server_native_object->null_pointer_exception_class, native_object->server_native_object->null_pointer_exception_constructor_method_id);
-    uv_result_ptr[0] = 0;
-    carlie_release_array_bytes(environment, (uint8_t *) buffer->base, buffer_bytes, (int32_t) JNI_ABORT);
-    environment[0]->DeleteGlobalRef(environment, (jni_object_t) buffer_bytes);
-    free(buffer);
-    free(async_write_data);
-    free(async_write_handle);
-    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  environment[0]->PopLocalFrame(environment, null_ptr);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_set_socket_option(uv_tcp_t *const tcp_handle,
+                                    int32_t const option_id,
+                                    int32_t const value)
+{
+  int32_t uv_result;
+  switch (option_id) {
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_NO_DELAY: {
+      return (int32_t) uv_tcp_nodelay(tcp_handle, (int) (value != 0));
+    }
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_RECEIVE_BUFFER_SIZE: {
+      int buffer_size = (int) value;
+      return (int32_t) uv_recv_buffer_size((uv_handle_t *) tcp_handle, &buffer_size);
+    }
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_SEND_BUFFER_SIZE: {
+      int buffer_size = (int) value;
+      return (int32_t) uv_send_buffer_size((uv_handle_t *) tcp_handle, &buffer_size);
+    }
+    default: {
+      break;
+    }
   }
-  async_write_data->buffer = buffer;
-  async_write_data->buffer_array = buffer_bytes;
-  async_write_data->callback_function_invoke_method_id = callback_function_invoke_method_id;
-  async_write_data->callback_function_object = callback_function_object;
-  async_write_data->native_object = native_object;
-  uv_handle_set_data((uv_handle_t *) async_write_handle, (void *) async_write_data);
-  uv_result = (int32_t) uv_async_send(async_write_handle);
-  if (uv_result < 0) {
-    uv_result_ptr[0] = uv_result;
-    environment[0]->DeleteGlobalRef(environment, callback_function_object);
-    carlie_release_array_bytes(environment, (uint8_t *) buffer->base, buffer_bytes, (int32_t) JNI_ABORT);
-    environment[0]->DeleteGlobalRef(environment, (jni_object_t) buffer_bytes);
-    free(buffer);
-    free(async_write_data);
-    free(async_write_handle);
-    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+#if ! defined(_WIN32)
+  int level;
+  int name;
+  if (! carlie_tcp_server_resolve_socket_option(option_id, &level, &name)) return UV_ENOTSUP;
+  uv_os_fd_t socket_descriptor;
+  uv_result = (int32_t) uv_fileno((uv_handle_t *) tcp_handle, &socket_descriptor);
+  if (uv_result < 0) return uv_result;
+  // NOTE: A negative lingering time turns lingering off.
+  struct linger const linger_value = {
+    .l_onoff = (value >= 0) ? 1 : 0,
+    .l_linger = (value >= 0) ? (int) value : 0,
+  };
+  int const option_value = (int) value;
+  int32_t const socket_result = (option_id == CARLIE_TCP_SERVER_SOCKET_OPTION_LINGER) ?
+    (int32_t) setsockopt((int) socket_descriptor, level, name, (void const *) &linger_value, (socklen_t) sizeof(linger_value)) :
+    (int32_t) setsockopt((int) socket_descriptor, level, name, (void const *) &option_value, (socklen_t) sizeof(option_value));
+  if (socket_result != 0) {
+    return (int32_t) uv_translate_sys_error(errno);
   }
-  uv_result_ptr[0] = 0;
-  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+  return 0;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(uv_result);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(value);
+  return UV_ENOTSUP;
+#endif
 }
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_connection_emit_uv_error_event(jni_environment_handle_t const environment,
-                                                 carlie_tcp_server_connection_native_object_t *const native_object,
-                                                 int32_t const error_number)
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_socket_option_is_supported(int32_t const option_id)
 {
-  jni_object_t exception_object = null_ptr;
-  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_create_uv_exception(environment, native_object->server_native_object, error_number, &exception_object);
-  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
-    return carlie_result;
+  switch (option_id) {
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_NO_DELAY:
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_RECEIVE_BUFFER_SIZE:
+    case CARLIE_TCP_SERVER_SOCKET_OPTION_SEND_BUFFER_SIZE: {
+      return true;
+    }
+    default: {
+      int level;
+      int name;
+      return carlie_tcp_server_resolve_socket_option(option_id, &level, &name);
+    }
   }
-  environment[0]->CallVoidMethod(environment, native_object->handle_error_occurred_event_function_object, native_object->handle_error_occurred_event_function_handle_method_id, exception_object);
-  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
 }
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_create_connection_native_object(jni_environment_handle_t const environment,
-                                                  carlie_tcp_server_native_object_t *const server_native_object,
-                                                  jni_object_t *const connection_native_object_bytes_ptr,
-                                                  carlie_tcp_server_connection_native_object_t **const connection_native_object_ptr)
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_start_async_uv_write(jni_environment_handle_t const environment,
+                                       carlie_tcp_server_async_uv_write_data_t *const data)
 {
-  jni_object_t const connection_native_object_bytes = environment[0]->CallObjectMethod(environment, server_native_object->create_connection_native_object_static_method_function_object, server_native_object->create_connection_native_object_static_method_function_invoke_method_id);
-  carlie_get_native_object(environment, connection_native_object_bytes, (void **) connection_native_object_ptr);
-  carlie_tcp_server_connection_native_object_t *const connection_native_object = connection_native_object_ptr[0];
-  connection_native_object->close_flag_mutex = &connection_native_object->close_flag_mutex_;
-  connection_native_object->tcp_handle = &connection_native_object->tcp_handle_;
-  connection_native_object_bytes_ptr[0] = connection_native_object_bytes;
-  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  int32_t const uv_result = (int32_t) uv_is_closing((uv_handle_t *) native_object->tcp_handle);
+  if (uv_result != 0) {
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, 0);
+    carlie_tcp_server_release_async_uv_write_buffer(environment, data);
+    carlie_tcp_server_destroy_async_uv_write_data(data);
+    return;
+  }
+  data->bytes_count = 0u;
+  for (size_t buffer_index = 0u; buffer_index < data->buffer_count; buffer_index += 1u) {
+    data->bytes_count += data->buffer[buffer_index].len;
+  }
+  data->bytes_written_count = 0u;
+  data->next_write_data = null_ptr;
+  carlie_tcp_server_connection_add_pending_write_bytes(environment, native_object, data->bytes_count);
+  carlie_tcp_server_submit_async_uv_write(environment, data);
 }
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_create_uv_exception(jni_environment_handle_t const environment,
-                                      carlie_tcp_server_native_object_t *const native_object,
-                                      int32_t const error_number,
-                                      jni_object_t *const exception_object_ptr)
+// NOTE: Called on the source’s loop, once the destination’s socket has been
+// duplicated. Whatever gets set up here is let go of by
+// `carlie_tcp_server_stop_relay(…)`, including when this fails halfway.
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_start_relay(carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                              carlie_tcp_server_async_uv_relay_data_t *const data)
 {
-  jni_object_t exception_object = environment[0]->NewObject(environment, native_object->uv_exception_class, native_object->uv_exception_constructor_method_id, (jni_int_t) error_number);
-  if (exception_object == null_ptr) {
-    exception_object_ptr[0] = null_ptr;
-    return CARLIE_TCP_SERVER_RESULT_CANNOT_CREATE_EXCEPTION;
+#if ! defined(_WIN32)
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  int32_t uv_result;
+  uv_result = carlie_tcp_server_duplicate_socket(native_object->tcp_handle, &data->source_socket_descriptor);
+  if (uv_result < 0) return uv_result;
+#if defined(__linux__)
+  if (pipe(data->pipe_descriptors) != 0) {
+    data->pipe_descriptors[0] = -1;
+    data->pipe_descriptors[1] = -1;
+    return (int32_t) uv_translate_sys_error(errno);
   }
-  exception_object_ptr[0] = exception_object;
-  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+  fcntl(data->pipe_descriptors[0], F_SETFD, FD_CLOEXEC);
+  fcntl(data->pipe_descriptors[1], F_SETFD, FD_CLOEXEC);
+#else
+  data->buffer = malloc(CARLIE_TCP_SERVER_RELAY_CHUNK_SIZE);
+  if (data->buffer == null_ptr) return UV_ENOMEM;
+#endif
+  uv_result = (int32_t) uv_poll_init(loop_data->loop_handle, &data->source_poll_handle_, data->source_socket_descriptor);
+  if (uv_result < 0) return uv_result;
+  data->source_poll_handle = &data->source_poll_handle_;
+  data->handles_count += 1u;
+  uv_handle_set_data((uv_handle_t *) data->source_poll_handle, (void *) data);
+  uv_result = (int32_t) uv_poll_init(loop_data->loop_handle, &data->destination_poll_handle_, data->destination_socket_descriptor);
+  if (uv_result < 0) return uv_result;
+  data->destination_poll_handle = &data->destination_poll_handle_;
+  data->handles_count += 1u;
+  uv_handle_set_data((uv_handle_t *) data->destination_poll_handle, (void *) data);
+  data->loop_data = loop_data;
+  data->next_relay = loop_data->relays;
+  if (data->next_relay != null_ptr) {
+    data->next_relay->previous_relay = data;
+  }
+  loop_data->relays = data;
+  native_object->relay = data;
+  return (int32_t) uv_poll_start(data->source_poll_handle, UV_READABLE, carlie_tcp_server_handle_uv_relay_polled);
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(loop_data);
+  CARLIE_INTERNAL_UNUSED_SYMBOL(data);
+  return UV_ENOTSUP;
+#endif
 }
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_emit_uv_error_event(jni_environment_handle_t const environment,
-                                      carlie_tcp_server_native_object_t *const native_object,
-                                      int32_t const error_number)
+// NOTE: Called on the source’s loop. Reports the relay’s completion (through
+// the source), and lets go of everything the relay holds.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_stop_relay(jni_environment_handle_t const environment,
+                             carlie_tcp_server_async_uv_relay_data_t *const data)
 {
-  jni_object_t exception_object = null_ptr;
-  carlie_tcp_server_result_t const carlie_result = carlie_tcp_server_create_uv_exception(environment, native_object, error_number, &exception_object);
-  if (carlie_result != CARLIE_TCP_SERVER_RESULT_SUCCESS) {
-    return carlie_result;
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  if (data->loop_data != null_ptr) {
+    if (data->previous_relay != null_ptr) {
+      data->previous_relay->next_relay = data->next_relay;
+    } else {
+      data->loop_data->relays = data->next_relay;
+    }
+    if (data->next_relay != null_ptr) {
+      data->next_relay->previous_relay = data->previous_relay;
+    }
+    data->loop_data = null_ptr;
+    native_object->relay = null_ptr;
+  }
+  if (data->source_poll_handle != null_ptr) {
+    uv_close((uv_handle_t *) data->source_poll_handle, carlie_tcp_server_handle_uv_relay_closed);
+  }
+  if (data->destination_poll_handle != null_ptr) {
+    uv_close((uv_handle_t *) data->destination_poll_handle, carlie_tcp_server_handle_uv_relay_closed);
+  }
+#if ! defined(_WIN32)
+  int const descriptors[] = {
+    data->destination_socket_descriptor,
+    data->pipe_descriptors[0],
+    data->pipe_descriptors[1],
+    data->source_socket_descriptor,
+  };
+  size_t const descriptors_count = sizeof(descriptors) / sizeof(descriptors[0]);
+  for (size_t i = 0u; i < descriptors_count; i++) {
+    if (descriptors[i] < 0) continue;
+    close(descriptors[i]);
+  }
+#endif
+  if (data->destination_socket_descriptor >= 0) {
+    __atomic_sub_fetch(&data->destination_native_object->relays_count, 1u, __ATOMIC_RELEASE);
+  }
+  carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, data->error_number);
+  if (data->handles_count == 0u) {
+    carlie_tcp_server_destroy_async_uv_relay_data(data);
   }
-  environment[0]->CallVoidMethod(environment, native_object->handle_error_occurred_event_function_object, native_object->handle_error_occurred_event_function_handle_method_id, exception_object);
-  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
 }
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_get_jni_environment_from_server_native_object(carlie_tcp_server_native_object_t *const native_object,
-                                                                jni_environment_handle_t *const environment_ptr)
+// NOTE: Same as with io_uring, a connection’s socket may only go once no relay
+// uses it anymore: the relays of the loop that involve the connection are
+// stopped right away, whereas the relays into it that run on other loops (and
+// hold duplicates of its socket) only notice once the socket has been shut
+// down. Without a connection, all of the loop’s relays are stopped.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_stop_relays(jni_environment_handle_t const environment,
+                              carlie_tcp_server_native_object_loop_data_t *const loop_data,
+                              carlie_tcp_server_connection_native_object_t *const native_object)
 {
-  jni_java_vm_t *const java_vm = native_object->java_vm;
-  // NOTE: Due to how `native_object`’s data is managed, it shouldn’t be
-  // possible for it to be non-null and have a null `java_vm` member.
-  assert(java_vm != null_ptr);
-  int32_t jni_result = (int32_t) java_vm[0]->GetEnv(java_vm, (void **) environment_ptr, JNI_VERSION);
-  if (jni_result != JNI_OK) {
-    // TODO: Investigate the ins and outs of how this works, thoroughly.
-    jni_result = (int32_t) java_vm[0]->AttachCurrentThread(java_vm, (void **) environment_ptr, null_ptr);
-    if (jni_result != JNI_OK) {
-      environment_ptr[0] = null_ptr;
-      return CARLIE_TCP_SERVER_RESULT_CANNOT_RETRIEVE_JNI_ENVIRONMENT;
+  carlie_tcp_server_async_uv_relay_data_t * relay = loop_data->relays;
+  while (relay != null_ptr) {
+    carlie_tcp_server_async_uv_relay_data_t *const next_relay = relay->next_relay;
+    if ((native_object == null_ptr) ||
+        (relay->native_object == native_object) ||
+        (relay->destination_native_object == native_object)) {
+      carlie_tcp_server_stop_relay(environment, relay);
     }
+    relay = next_relay;
   }
-  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+  if (native_object == null_ptr) return;
+#if ! defined(_WIN32)
+  size_t const relays_count = __atomic_load_n(&native_object->relays_count, __ATOMIC_ACQUIRE);
+  uv_os_fd_t socket_descriptor;
+  if ((relays_count > 0u) &&
+      (uv_fileno((uv_handle_t *) native_object->tcp_handle, &socket_descriptor) == 0)) {
+    shutdown((int) socket_descriptor, SHUT_RDWR);
+  }
+#endif
 }
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_result_t
-carlie_tcp_server_get_uv_address(jni_environment_handle_t const environment,
-                                 carlie_tcp_server_native_object_t *const native_object,
-                                 uv_tcp_t *const tcp_handle,
-                                 int (*const uv_get_address_function)(uv_tcp_t const *const tcp_handle,
-                                                                      struct sockaddr *const socket_address_ptr,
-                                                                      int *const socket_address_size_ptr),
-                                 jni_object_t const create_address_method_function_object,
-                                 jni_class_t const create_address_method_function_class,
-                                 jni_object_t *const address_object_ptr)
+// NOTE: A write goes through io_uring only if nothing else is waiting to be
+// written on the connection, neither by libuv nor by io_uring; while an
+// io_uring send is in flight, the writes after it queue up behind it, and once
+// libuv has queued something, the writes after it go to libuv too.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_submit_async_uv_write(jni_environment_handle_t const environment,
+                                        carlie_tcp_server_async_uv_write_data_t *const data)
 {
-  jni_method_id_t const create_address_method_function_invoke_method_id = environment[0]->GetMethodID(environment, create_address_method_function_class, "invoke", "(Ljava/lang/Object;Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
-  if (create_address_method_function_invoke_method_id == null_ptr) {
-    carlie_throw_null_pointer_exception(environment, native_object->null_pointer_exception_class, native_object->null_pointer_exception_constructor_method_id);
-    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  if (native_object->io_uring_write_queue_head != null_ptr) {
+    native_object->io_uring_write_queue_tail->next_write_data = data;
+    native_object->io_uring_write_queue_tail = data;
+    return;
   }
-  struct sockaddr_storage socket_address;
-  size_t socket_address_size = sizeof(socket_address);
-  int32_t uv_result;
-  uv_result = (int32_t) uv_get_address_function(tcp_handle, (struct sockaddr *) &socket_address, (int *) &socket_address_size);
+  if ((uv_stream_get_write_queue_size((uv_stream_t const *) native_object->tcp_handle) == 0u) &&
+      carlie_tcp_server_submit_io_uring_write(data)) {
+    native_object->io_uring_write_queue_head = data;
+    native_object->io_uring_write_queue_tail = data;
+    return;
+  }
+  // NOTE: From here on, the write data is owned by the write request, which
+  // libuv queues on the connection’s stream; it is released once the request
+  // completes (i.e., once the whole buffer has been written, the write failed,
+  // or the connection got closed while the request was still pending).
+  uv_req_set_data((uv_req_t *) &data->write_request, (void *) data);
+  if (! carlie_tcp_server_connection_enter_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_WRITING)) {
+    carlie_tcp_server_connection_remove_pending_write_bytes(environment, native_object, data->bytes_count);
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, 0);
+    carlie_tcp_server_release_async_uv_write_buffer(environment, data);
+    carlie_tcp_server_destroy_async_uv_write_data(data);
+    return;
+  }
+  int32_t const uv_result = (int32_t) uv_write(&data->write_request, (uv_stream_t *) native_object->tcp_handle, data->buffer, (unsigned int) data->buffer_count, carlie_tcp_server_handle_async_uv_write_data_written);
+  carlie_tcp_server_connection_leave_state(native_object, CARLIE_TCP_SERVER_CONNECTION_STATE_WRITING);
   if (uv_result < 0) {
-    carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
-    return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
+    carlie_tcp_server_connection_remove_pending_write_bytes(environment, native_object, data->bytes_count);
+    carlie_tcp_server_connection_complete_io(environment, native_object, data->operation_id, 0, uv_result);
+    carlie_tcp_server_release_async_uv_write_buffer(environment, data);
+    carlie_tcp_server_destroy_async_uv_write_data(data);
   }
-  char address_ip[INET6_ADDRSTRLEN];
-  uint16_t address_port;
-  uint8_t address_version;
-  if (socket_address.ss_family == AF_INET) {
-    struct sockaddr_in const *const socket_address_v4_ptr = (struct sockaddr_in *) &socket_address;
-    uv_result = (int32_t) uv_ip4_name(socket_address_v4_ptr, address_ip, (size_t) INET6_ADDRSTRLEN);
-    if (uv_result < 0) {
-      carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
-      return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
-    }
-    address_port = ntohs(socket_address_v4_ptr->sin_port);
-    address_version = 4u;
-  } else if (socket_address.ss_family == AF_INET6) {
-    struct sockaddr_in6 const *const socket_address_v6_ptr = (struct sockaddr_in6 *) &socket_address;
-    uv_result = (int32_t) uv_ip6_name(socket_address_v6_ptr, address_ip, (size_t) INET6_ADDRSTRLEN);
-    if (uv_result < 0) {
-      carlie_tcp_server_throw_uv_exception(environment, native_object, uv_result);
-      return CARLIE_TCP_SERVER_RESULT_UV_FAILURE;
-    }
-    address_port = ntohs(socket_address_v6_ptr->sin6_port);
-    address_version = 6u;
-  } else {
-    carlie_throw_runtime_exception(environment, native_object->runtime_exception_class, native_object->runtime_exception_constructor_method_id);
-    return CARLIE_TCP_SERVER_RESULT_RUNTIME_EXCEPTION_THROWN;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_submit_io_uring_accept(carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+  assert((((uintptr_t) loop_data) & CARLIE_TCP_SERVER_IO_URING_OPERATION_KIND_MASK) == 0u);
+  struct io_uring_sqe *const entry = carlie_tcp_server_get_io_uring_submission_entry(loop_data);
+  if (entry == null_ptr) {
+    return false;
   }
-  jni_string_t const address_ip_string = environment[0]->NewStringUTF(environment, address_ip);
-  if (address_ip_string == null_ptr) {
-    carlie_throw_null_pointer_exception(environment, native_object->null_pointer_exception_class, native_object->null_pointer_exception_constructor_method_id);
-    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  entry->opcode = (uint8_t) IORING_OP_ACCEPT;
+  entry->fd = (int32_t) transport->listener_socket_descriptor;
+  entry->ioprio = (uint16_t) IORING_ACCEPT_MULTISHOT;
+  entry->accept_flags = (uint32_t) (SOCK_CLOEXEC | SOCK_NONBLOCK);
+  entry->user_data = ((uint64_t) (uintptr_t) loop_data) | CARLIE_TCP_SERVER_IO_URING_OPERATION_ACCEPT;
+  transport->operations_count += 1u;
+  return true;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(loop_data);
+  return false;
+#endif
+}
+
+
+
+// NOTE: Returns whether the read goes through io_uring; if it doesn’t (i.e.,
+// the loop doesn’t use io_uring, or the submission queue is out of room), it’s
+// up to libuv. A streaming read becomes a multishot receive into the ring’s
+// read buffers; any other read receives right into its own buffers.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_submit_io_uring_read(carlie_tcp_server_async_uv_read_data_t *const data)
+{
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = native_object->loop_data;
+  carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+  if (! transport->is_enabled) {
+    return false;
   }
-  jni_object_t const address_port_object = environment[0]->NewObject(environment, native_object->integer_class, native_object->integer_constructor_method_id, (jni_int_t) (int32_t) address_port);
-  jni_object_t const address_version_object = environment[0]->NewObject(environment, native_object->integer_class, native_object->integer_constructor_method_id, (jni_int_t) (int32_t) address_version);
-  if ((address_port_object == null_ptr) ||
-      (address_version_object == null_ptr)) {
-    carlie_throw_null_pointer_exception(environment, native_object->null_pointer_exception_class, native_object->null_pointer_exception_constructor_method_id);
-    return CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN;
+  assert((((uintptr_t) data) & CARLIE_TCP_SERVER_IO_URING_OPERATION_KIND_MASK) == 0u);
+  uv_os_fd_t socket_descriptor;
+  int32_t const uv_result = (int32_t) uv_fileno((uv_handle_t *) native_object->tcp_handle, &socket_descriptor);
+  if (uv_result < 0) {
+    return false;
   }
-  address_object_ptr[0] = environment[0]->CallObjectMethod(environment, create_address_method_function_object, create_address_method_function_invoke_method_id, address_ip_string, address_version_object, address_port_object);
-  return CARLIE_TCP_SERVER_RESULT_SUCCESS;
+  struct io_uring_sqe *const entry = carlie_tcp_server_get_io_uring_submission_entry(loop_data);
+  if (entry == null_ptr) {
+    return false;
+  }
+  entry->fd = (int32_t) socket_descriptor;
+  if (data->is_streaming) {
+    entry->opcode = (uint8_t) IORING_OP_RECV;
+    entry->ioprio = (uint16_t) IORING_RECV_MULTISHOT;
+    entry->flags = (uint8_t) IOSQE_BUFFER_SELECT;
+    entry->buf_group = (uint16_t) CARLIE_TCP_SERVER_IO_URING_READ_BUFFER_GROUP_ID;
+  } else {
+    // NOTE: A `uv_buf_t` is laid out like a `struct iovec` on this platform.
+    struct msghdr *const message = &data->io_uring_message;
+    memset(message, 0, sizeof(struct msghdr));
+    message->msg_iov = (struct iovec *) (void *) &data->buffers[data->buffer_index];
+    message->msg_iovlen = data->buffer_count - data->buffer_index;
+    entry->opcode = (uint8_t) IORING_OP_RECVMSG;
+    entry->addr = (uint64_t) (uintptr_t) message;
+    entry->len = 1u;
+  }
+  entry->user_data = ((uint64_t) (uintptr_t) data) | CARLIE_TCP_SERVER_IO_URING_OPERATION_READ;
+  data->uses_io_uring = true;
+  native_object->io_uring_operations_count += 1u;
+  transport->operations_count += 1u;
+  return true;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(data);
+  return false;
+#endif
 }
 
 
 
-CARLIE_C_ALWAYS_INLINE static inline char const *
-carlie_tcp_server_result_get_value(carlie_tcp_server_result_t const status)
+// NOTE: Same as for reads, returns whether the write goes through io_uring.
+// Short sends get advanced in place, except for a lone buffer (which may be a
+// pinned array, to be released from where it starts), which is copied first;
+// gathered writes only ever have direct buffers.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_submit_io_uring_write(carlie_tcp_server_async_uv_write_data_t *const data)
 {
-  switch (status) {
-    case CARLIE_TCP_SERVER_RESULT_CANNOT_CREATE_EXCEPTION:
-    case CARLIE_TCP_SERVER_RESULT_CANNOT_THROW_EXCEPTION:
-    case CARLIE_TCP_SERVER_RESULT_NULL_POINTER_EXCEPTION_THROWN:
-    case CARLIE_TCP_SERVER_RESULT_RUNTIME_EXCEPTION_THROWN:
-    case CARLIE_TCP_SERVER_RESULT_SUCCESS: {
-      return carlie_result_get_value((carlie_result_t) (unsigned int) status);
-    }
-    case CARLIE_TCP_SERVER_RESULT_CANNOT_RETRIEVE_JNI_ENVIRONMENT: {
-      return "JNI environment retrieval failed.";
-    }
-    case CARLIE_TCP_SERVER_RESULT_MEMORY_ALLOCATION_FAILED: {
-      return "Memory allocation failed.";
-    }
-    case CARLIE_TCP_SERVER_RESULT_UV_FAILURE: {
-      return "libuv failure.";
-    }
-    default: {
-      return carlie_result_get_value((carlie_result_t) (unsigned int) status);
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+  carlie_tcp_server_connection_native_object_t *const native_object = data->native_object;
+  carlie_tcp_server_native_object_loop_data_t *const loop_data = native_object->loop_data;
+  carlie_tcp_server_io_uring_transport_t *const transport = &loop_data->io_uring_transport;
+  if (! transport->is_enabled) {
+    return false;
+  }
+  assert((((uintptr_t) data) & CARLIE_TCP_SERVER_IO_URING_OPERATION_KIND_MASK) == 0u);
+  uv_os_fd_t socket_descriptor;
+  int32_t const uv_result = (int32_t) uv_fileno((uv_handle_t *) native_object->tcp_handle, &socket_descriptor);
+  if (uv_result < 0) {
+    return false;
+  }
+  struct io_uring_sqe *const entry = carlie_tcp_server_get_io_uring_submission_entry(loop_data);
+  if (entry == null_ptr) {
+    return false;
+  }
+  struct msghdr *const message = &data->io_uring_message;
+  if (data->bytes_written_count == 0u) {
+    memset(message, 0, sizeof(struct msghdr));
+    if (data->buffer_count == 1u) {
+      data->io_uring_buffer.iov_base = (void *) data->buffer->base;
+      data->io_uring_buffer.iov_len = data->buffer->len;
+      message->msg_iov = &data->io_uring_buffer;
+    } else {
+      message->msg_iov = (struct iovec *) (void *) data->buffer;
     }
+    message->msg_iovlen = data->buffer_count;
   }
+  entry->opcode = (uint8_t) IORING_OP_SENDMSG;
+  entry->fd = (int32_t) socket_descriptor;
+  entry->addr = (uint64_t) (uintptr_t) message;
+  entry->len = 1u;
+  entry->msg_flags = (uint32_t) MSG_NOSIGNAL;
+  entry->user_data = ((uint64_t) (uintptr_t) data) | CARLIE_TCP_SERVER_IO_URING_OPERATION_WRITE;
+  native_object->io_uring_operations_count += 1u;
+  transport->operations_count += 1u;
+  return true;
+#else
+  CARLIE_INTERNAL_UNUSED_SYMBOL(data);
+  return false;
+#endif
 }
 
 
@@ -764,6 +3971,74 @@ carlie_tcp_server_throw_uv_exception(jni_environment_handle_t const environment,
 
 
 
+// NOTE: Wakes up the JVM thread that consumes the loop’s completion ring, if
+// (and only if) it said it’s about to park; only one of the loop and that
+// thread gets to clear the flag, so there’s at most one wake-up per park.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_wake_up_io_ring_consumer(jni_environment_handle_t const environment,
+                                           carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  carlie_tcp_server_io_ring_header_t *const header = loop_data->io_rings.completion_ring.header;
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&header->needs_wake_up, __ATOMIC_RELAXED) == 0u) return;
+  if (__atomic_exchange_n(&header->needs_wake_up, 0u, __ATOMIC_ACQ_REL) == 0u) return;
+  carlie_tcp_server_native_object_t *const server_native_object = loop_data->server_native_object;
+  size_t const loop_index = (size_t) (loop_data - server_native_object->loops_data);
+  environment[0]->CallVoidMethod(environment, server_native_object->io_ring_wake_up_function_object, server_native_object->io_ring_wake_up_function_handle_completions_available_method_id, (jni_int_t) (int32_t) loop_index);
+}
+
+
+
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+// NOTE: Blocks the loop until io_uring has completions for it, and handles
+// them; only meant for waiting on cancellations, which complete promptly.
+// Returns whether the ring could be waited on at all.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_wait_for_io_uring_completions(jni_environment_handle_t const environment,
+                                                carlie_tcp_server_native_object_loop_data_t *const loop_data)
+{
+  int32_t const uv_result = carlie_tcp_server_io_uring_enter(&loop_data->io_uring_transport.ring, 1u);
+  if ((uv_result < 0) &&
+      (uv_result != UV_EAGAIN) &&
+      (uv_result != UV_EBUSY)) {
+    return false;
+  }
+  carlie_tcp_server_reap_io_uring_completions(environment, loop_data);
+  return true;
+}
+#endif
+
+
+
+// NOTE: A relay only ever polls one of its sockets: the source, for more data
+// to move, or the destination, for room for the data it couldn’t move yet.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_wait_for_relay_peer(jni_environment_handle_t const environment,
+                                      carlie_tcp_server_async_uv_relay_data_t *const data,
+                                      bool const waits_for_destination)
+{
+  if (data->waits_for_destination == waits_for_destination) return;
+  uv_poll_t *const stopped_poll_handle = (waits_for_destination) ?
+    data->source_poll_handle :
+    data->destination_poll_handle;
+  uv_poll_t *const started_poll_handle = (waits_for_destination) ?
+    data->destination_poll_handle :
+    data->source_poll_handle;
+  int const events = (waits_for_destination) ?
+    (int) UV_WRITABLE :
+    (int) UV_READABLE;
+  uv_poll_stop(stopped_poll_handle);
+  int32_t const uv_result = (int32_t) uv_poll_start(started_poll_handle, events, carlie_tcp_server_handle_uv_relay_polled);
+  if (uv_result < 0) {
+    data->error_number = uv_result;
+    carlie_tcp_server_stop_relay(environment, data);
+    return;
+  }
+  data->waits_for_destination = waits_for_destination;
+}
+
+
+
 /*
  *******************************************************************************
  * Class:     io_seventeenninetyone_carlie_TcpServer                           *
@@ -793,6 +4068,8 @@ JNI_DEFINE_METHOD(jni_int_t, getNativeObjectSize)(jni_environment_handle_t envir
  * Class:     io_seventeenninetyone_carlie_TcpServer                           *
  * Method:    initializeNative                                                 *
  * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             I                                                               *
+ *             Z                                                               *
  *             Lkotlin/jvm/functions/Function0;                                *
  *             Ljava/lang/Class;                                               *
  *             Lkotlin/jvm/functions/Function1;                                *
@@ -812,6 +4089,8 @@ JNI_DEFINE_METHOD(jni_int_t, getNativeObjectSize)(jni_environment_handle_t envir
 JNI_DEFINE_METHOD(jni_boolean_t, initializeNative)(jni_environment_handle_t environment,
                                                    jni_object_t server_object,
                                                    jni_object_t native_object_bytes,
+                                                   jni_int_t loops_count,
+                                                   jni_boolean_t uses_acceptor_handoff,
                                                    jni_object_t create_connection_native_object_static_method_function_object,
                                                    jni_class_t create_connection_native_object_static_method_function_class,
                                                    jni_object_t create_connection_method_function_object,
@@ -842,6 +4121,21 @@ JNI_DEFINE_METHOD(void, closeNative)(jni_environment_handle_t environment,
 
 
 
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    attachToEventLoopGroup                                           *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             Ljava/nio/ByteBuffer;)V                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, attachToEventLoopGroup)(jni_environment_handle_t environment,
+                                                jni_object_t server_object,
+                                                jni_object_t native_object_bytes,
+                                                jni_object_t group_native_object_bytes);
+
+
+
 /*
  *******************************************************************************
  * Class:     io_seventeenninetyone_carlie_TcpServer                           *
@@ -874,6 +4168,35 @@ JNI_DEFINE_METHOD(void, closeUvTcpHandle)(jni_environment_handle_t environment,
 
 
 
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    getIoRing                                                        *
+ * Signature: (Ljava/nio/ByteBuffer;IZ)Ljava/nio/ByteBuffer;                   *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(jni_object_t, getIoRing)(jni_environment_handle_t environment,
+                                           jni_object_t server_object,
+                                           jni_object_t native_object_bytes,
+                                           jni_int_t loop_index,
+                                           jni_boolean_t is_completion_ring);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    getRecordPoolCounts                                              *
+ * Signature: (Ljava/nio/ByteBuffer;[J)V                                       *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, getRecordPoolCounts)(jni_environment_handle_t environment,
+                                             jni_object_t server_object,
+                                             jni_object_t native_object_bytes,
+                                             jni_long_array_t counts);
+
+
+
 /*
  *******************************************************************************
  * Class:     io_seventeenninetyone_carlie_TcpServer                           *
@@ -891,6 +4214,86 @@ JNI_DEFINE_METHOD(jni_object_t, getUvTcpBoundAddress)(jni_environment_handle_t e
 
 
 
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    getWriteCounts                                                   *
+ * Signature: (Ljava/nio/ByteBuffer;[J)V                                       *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, getWriteCounts)(jni_environment_handle_t environment,
+                                        jni_object_t server_object,
+                                        jni_object_t native_object_bytes,
+                                        jni_long_array_t counts);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    initializeAcceptBatches                                          *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             I                                                               *
+ *             Lio/seventeenninetyone/carlie/tcp_server/ClientConnectedBatchSinkFunction; *
+ *             Ljava/lang/Class;)V                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, initializeAcceptBatches)(jni_environment_handle_t environment,
+                                                 jni_object_t server_object,
+                                                 jni_object_t native_object_bytes,
+                                                 jni_int_t accept_batch_capacity,
+                                                 jni_object_t accept_batch_sink_function_object,
+                                                 jni_class_t accept_batch_sink_function_class);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    initializeIoCompletionBatches                                    *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             Lio/seventeenninetyone/carlie/tcp_server/IoCompletionBatchSinkFunction; *
+ *             Ljava/lang/Class;)V                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, initializeIoCompletionBatches)(jni_environment_handle_t environment,
+                                                       jni_object_t server_object,
+                                                       jni_object_t native_object_bytes,
+                                                       jni_object_t io_completion_batch_sink_function_object,
+                                                       jni_class_t io_completion_batch_sink_function_class);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    initializeIoRings                                                *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             Lio/seventeenninetyone/carlie/tcp_server/IoRingWakeUpFunction;  *
+ *             Ljava/lang/Class;)V                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, initializeIoRings)(jni_environment_handle_t environment,
+                                           jni_object_t server_object,
+                                           jni_object_t native_object_bytes,
+                                           jni_object_t io_ring_wake_up_function_object,
+                                           jni_class_t io_ring_wake_up_function_class);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    initializeIoUring                                                *
+ * Signature: (Ljava/nio/ByteBuffer;)Z                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(jni_boolean_t, initializeIoUring)(jni_environment_handle_t environment,
+                                                    jni_object_t server_object,
+                                                    jni_object_t native_object_bytes);
+
+
+
 /*
  *******************************************************************************
  * Class:     io_seventeenninetyone_carlie_TcpServer                           *
@@ -904,16 +4307,51 @@ JNI_DEFINE_METHOD(void, initializeUvTcpHandle)(jni_environment_handle_t environm
 
 
 
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    setDefaultSocketOption                                           *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             I                                                               *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, setDefaultSocketOption)(jni_environment_handle_t environment,
+                                                jni_object_t server_object,
+                                                jni_object_t native_object_bytes,
+                                                jni_int_t option_id,
+                                                jni_int_t value);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    setWriteWatermarks                                               *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             J                                                               *
+ *             J)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, setWriteWatermarks)(jni_environment_handle_t environment,
+                                            jni_object_t server_object,
+                                            jni_object_t native_object_bytes,
+                                            jni_long_t low_watermark,
+                                            jni_long_t high_watermark);
+
+
+
 /*
  *******************************************************************************
  * Class:     io_seventeenninetyone_carlie_TcpServer                           *
  * Method:    uvRun                                                            *
- * Signature: (Ljava/nio/ByteBuffer;)V                                         *
+ * Signature: (Ljava/nio/ByteBuffer;I)V                                        *
  *******************************************************************************
  */
 JNI_DEFINE_METHOD(void, uvRun)(jni_environment_handle_t environment,
                                jni_object_t server_object,
-                               jni_object_t native_object_bytes);
+                               jni_object_t native_object_bytes,
+                               jni_int_t loop_index);
 
 
 
@@ -921,12 +4359,41 @@ JNI_DEFINE_METHOD(void, uvRun)(jni_environment_handle_t environment,
  *******************************************************************************
  * Class:     io_seventeenninetyone_carlie_TcpServer                           *
  * Method:    uvTcpListen                                                      *
- * Signature: (Ljava/nio/ByteBuffer;)V                                         *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             I)V                                                             *
  *******************************************************************************
  */
 JNI_DEFINE_METHOD(void, uvTcpListen)(jni_environment_handle_t environment,
                                      jni_object_t server_object,
-                                     jni_object_t native_object_bytes);
+                                     jni_object_t native_object_bytes,
+                                     jni_int_t listen_backlog);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    waitForUvLoops                                                   *
+ * Signature: (Ljava/nio/ByteBuffer;)V                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, waitForUvLoops)(jni_environment_handle_t environment,
+                                        jni_object_t server_object,
+                                        jni_object_t native_object_bytes);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer                           *
+ * Method:    wakeUpUvLoop                                                     *
+ * Signature: (Ljava/nio/ByteBuffer;I)V                                        *
+ *******************************************************************************
+ */
+JNI_DEFINE_METHOD(void, wakeUpUvLoop)(jni_environment_handle_t environment,
+                                      jni_object_t server_object,
+                                      jni_object_t native_object_bytes,
+                                      jni_int_t loop_index);
 
 
 
@@ -941,6 +4408,8 @@ JNI_DEFINE_METHOD(void, uvTcpListen)(jni_environment_handle_t environment,
  *             Lio/seventeenninetyone/carlie/tcp_server/ClosedEventHandlerFunction; *
  *             Ljava/lang/Class;                                               *
  *             Lio/seventeenninetyone/carlie/tcp_server/ErrorOccurredEventHandlerFunction; *
+ *             Ljava/lang/Class;                                               *
+ *             Lio/seventeenninetyone/carlie/tcp_server/IoCompletionSinkFunction; *
  *             Ljava/lang/Class;)Z                                             *
  *******************************************************************************
  */
@@ -953,7 +4422,9 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_boolean_t, initializeNative)(jni_envir
                                                                        jni_object_t handle_closed_event_function_object,
                                                                        jni_class_t handle_closed_event_function_class,
                                                                        jni_object_t handle_error_occurred_event_function_object,
-                                                                       jni_class_t handle_error_occurred_event_function_class);
+                                                                       jni_class_t handle_error_occurred_event_function_class,
+                                                                       jni_object_t io_completion_sink_function_object,
+                                                                       jni_class_t io_completion_sink_function_class);
 
 
 
@@ -996,6 +4467,19 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, closeUvTcpHandle)(jni_environment_ha
 
 
 
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    getLoopIndex                                                     *
+ * Signature: (Ljava/nio/ByteBuffer;)I                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_int_t, getLoopIndex)(jni_environment_handle_t environment,
+                                                               jni_object_t connection_object,
+                                                               jni_object_t native_object_bytes);
+
+
+
 /*
  *******************************************************************************
  * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
@@ -1084,6 +4568,34 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpEnableKeepAlive)(jni_environmen
 
 
 
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpGetSocketOption                                             *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             I)I                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(jni_int_t, uvTcpGetSocketOption)(jni_environment_handle_t environment,
+                                                                       jni_object_t connection_object,
+                                                                       jni_object_t native_object_bytes,
+                                                                       jni_int_t option_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpPauseReading                                                *
+ * Signature: (Ljava/nio/ByteBuffer;)V                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpPauseReading)(jni_environment_handle_t environment,
+                                                               jni_object_t connection_object,
+                                                               jni_object_t native_object_bytes);
+
+
+
 /*
  *******************************************************************************
  * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
@@ -1091,8 +4603,7 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpEnableKeepAlive)(jni_environmen
  * Signature: (Ljava/nio/ByteBuffer;                                           *
  *             [B                                                              *
  *             I                                                               *
- *             Lkotlin/jvm/functions/Function2;                                *
- *             Ljava/lang/Class;)V                                             *
+ *             I)V                                                             *
  *******************************************************************************
  */
 JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpRead)(jni_environment_handle_t environment,
@@ -1100,8 +4611,147 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpRead)(jni_environment_handle_t
                                                        jni_object_t native_object_bytes,
                                                        jni_byte_array_t buffer_bytes,
                                                        jni_int_t buffer_bytes_size,
-                                                       jni_object_t callback_function_object,
-                                                       jni_class_t callback_function_class);
+                                                       jni_int_t operation_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpReadDirect                                                  *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             Ljava/nio/ByteBuffer;                                           *
+ *             I                                                               *
+ *             I                                                               *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpReadDirect)(jni_environment_handle_t environment,
+                                                             jni_object_t connection_object,
+                                                             jni_object_t native_object_bytes,
+                                                             jni_object_t buffer_object,
+                                                             jni_int_t buffer_offset,
+                                                             jni_int_t buffer_size,
+                                                             jni_int_t operation_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpReadScattered                                               *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             [Ljava/nio/ByteBuffer;                                          *
+ *             [I                                                              *
+ *             [I                                                              *
+ *             I                                                               *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpReadScattered)(jni_environment_handle_t environment,
+                                                                jni_object_t connection_object,
+                                                                jni_object_t native_object_bytes,
+                                                                jni_object_array_t buffer_objects,
+                                                                jni_int_array_t buffer_offsets,
+                                                                jni_int_array_t buffer_sizes,
+                                                                jni_int_t buffer_count,
+                                                                jni_int_t operation_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpRelay                                                       *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             Ljava/nio/ByteBuffer;                                           *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpRelay)(jni_environment_handle_t environment,
+                                                        jni_object_t connection_object,
+                                                        jni_object_t native_object_bytes,
+                                                        jni_object_t destination_native_object_bytes,
+                                                        jni_int_t operation_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpResumeReading                                               *
+ * Signature: (Ljava/nio/ByteBuffer;)V                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpResumeReading)(jni_environment_handle_t environment,
+                                                                jni_object_t connection_object,
+                                                                jni_object_t native_object_bytes);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpSendFile                                                    *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             Ljava/nio/channels/FileChannel;                                 *
+ *             J                                                               *
+ *             I                                                               *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpSendFile)(jni_environment_handle_t environment,
+                                                           jni_object_t connection_object,
+                                                           jni_object_t native_object_bytes,
+                                                           jni_object_t file_channel_object,
+                                                           jni_long_t position,
+                                                           jni_int_t count,
+                                                           jni_int_t operation_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpSetSocketOption                                             *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             I                                                               *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpSetSocketOption)(jni_environment_handle_t environment,
+                                                                  jni_object_t connection_object,
+                                                                  jni_object_t native_object_bytes,
+                                                                  jni_int_t option_id,
+                                                                  jni_int_t value);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpStartReading                                                *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpStartReading)(jni_environment_handle_t environment,
+                                                               jni_object_t connection_object,
+                                                               jni_object_t native_object_bytes,
+                                                               jni_int_t operation_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpStopReading                                                 *
+ * Signature: (Ljava/nio/ByteBuffer;)V                                         *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpStopReading)(jni_environment_handle_t environment,
+                                                              jni_object_t connection_object,
+                                                              jni_object_t native_object_bytes);
 
 
 
@@ -1112,8 +4762,7 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpRead)(jni_environment_handle_t
  * Signature: (Ljava/nio/ByteBuffer;                                           *
  *             [B                                                              *
  *             I                                                               *
- *             Lkotlin/jvm/functions/Function2;                                *
- *             Ljava/lang/Class;)V                                             *
+ *             I)V                                                             *
  *******************************************************************************
  */
 JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpWrite)(jni_environment_handle_t environment,
@@ -1121,8 +4770,51 @@ JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpWrite)(jni_environment_handle_t
                                                         jni_object_t native_object_bytes,
                                                         jni_byte_array_t buffer_bytes,
                                                         jni_int_t buffer_bytes_size,
-                                                        jni_object_t callback_function_object,
-                                                        jni_class_t callback_function_class);
+                                                        jni_int_t operation_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpWriteDirect                                                 *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             Ljava/nio/ByteBuffer;                                           *
+ *             I                                                               *
+ *             I                                                               *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpWriteDirect)(jni_environment_handle_t environment,
+                                                              jni_object_t connection_object,
+                                                              jni_object_t native_object_bytes,
+                                                              jni_object_t buffer_object,
+                                                              jni_int_t buffer_offset,
+                                                              jni_int_t buffer_size,
+                                                              jni_int_t operation_id);
+
+
+
+/*
+ *******************************************************************************
+ * Class:     io_seventeenninetyone_carlie_TcpServer_ConnectionInternal        *
+ * Method:    uvTcpWriteGathered                                               *
+ * Signature: (Ljava/nio/ByteBuffer;                                           *
+ *             [Ljava/nio/ByteBuffer;                                          *
+ *             [I                                                              *
+ *             [I                                                              *
+ *             I                                                               *
+ *             I)V                                                             *
+ *******************************************************************************
+ */
+JNI_DEFINE_CONNECTION_INTERNAL_METHOD(void, uvTcpWriteGathered)(jni_environment_handle_t environment,
+                                                                jni_object_t connection_object,
+                                                                jni_object_t native_object_bytes,
+                                                                jni_object_array_t buffer_objects,
+                                                                jni_int_array_t buffer_offsets,
+                                                                jni_int_array_t buffer_sizes,
+                                                                jni_int_t buffer_count,
+                                                                jni_int_t operation_id);
 
 
 
@@ -0,0 +1,227 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+
+
+#ifndef IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_BUFFER_POOL_H
+#define IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_BUFFER_POOL_H 1
+
+
+
+#include <carlie/common.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+
+
+/*
+ *******************************************************************************
+ * Some useful macros.                                                         *
+ *******************************************************************************
+ */
+#define CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT 4u
+// NOTE: The number of free blocks kept around per size class, so that the
+// memory held by the pool stays proportional to the number of active reads.
+#define CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASS_MAXIMUM_FREE_BLOCKS_COUNT 64u
+
+
+
+/*
+ *******************************************************************************
+ * Internal API type definitions.                                              *
+ *******************************************************************************
+ */
+typedef struct _carlie_tcp_server_buffer_pool carlie_tcp_server_buffer_pool_t;
+typedef struct _carlie_tcp_server_buffer_pool_block carlie_tcp_server_buffer_pool_block_t;
+typedef struct _carlie_tcp_server_buffer_pool_size_class carlie_tcp_server_buffer_pool_size_class_t;
+
+
+
+struct _carlie_tcp_server_buffer_pool_block {
+  carlie_tcp_server_buffer_pool_block_t * next_block;
+  size_t size_class_index;
+  uint8_t bytes[];
+};
+
+
+
+struct _carlie_tcp_server_buffer_pool_size_class {
+  size_t block_size;
+  carlie_tcp_server_buffer_pool_block_t * free_blocks;
+  size_t free_blocks_count;
+};
+
+
+
+// NOTE: A pool belongs to a single loop and is only ever used from that loop’s
+// thread, so it doesn’t need any locking.
+struct _carlie_tcp_server_buffer_pool {
+  carlie_tcp_server_buffer_pool_size_class_t size_classes[CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT];
+};
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline uint8_t *
+carlie_tcp_server_buffer_pool_acquire(carlie_tcp_server_buffer_pool_t *const pool,
+                                      size_t const size_class_index);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_buffer_pool_drain(carlie_tcp_server_buffer_pool_t *const pool);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline size_t
+carlie_tcp_server_buffer_pool_get_block_size(carlie_tcp_server_buffer_pool_t const *const pool,
+                                             size_t const size_class_index);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline size_t
+carlie_tcp_server_buffer_pool_get_next_size_class_index(carlie_tcp_server_buffer_pool_t const *const pool,
+                                                        size_t const size_class_index,
+                                                        size_t const bytes_count);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_buffer_pool_initialize(carlie_tcp_server_buffer_pool_t *const pool);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_buffer_pool_release(carlie_tcp_server_buffer_pool_t *const pool,
+                                      uint8_t *const bytes);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline uint8_t *
+carlie_tcp_server_buffer_pool_acquire(carlie_tcp_server_buffer_pool_t *const pool,
+                                      size_t const size_class_index)
+{
+  assert(size_class_index < CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT);
+  carlie_tcp_server_buffer_pool_size_class_t *const size_class = &pool->size_classes[size_class_index];
+  carlie_tcp_server_buffer_pool_block_t * block = size_class->free_blocks;
+  if (block != null_ptr) {
+    size_class->free_blocks = block->next_block;
+    size_class->free_blocks_count -= 1u;
+  } else {
+    block = malloc(sizeof(carlie_tcp_server_buffer_pool_block_t) + size_class->block_size);
+    if (block == null_ptr) {
+      return null_ptr;
+    }
+    block->size_class_index = size_class_index;
+  }
+  block->next_block = null_ptr;
+  return block->bytes;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_buffer_pool_drain(carlie_tcp_server_buffer_pool_t *const pool)
+{
+  for (size_t i = 0u; i < CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT; i++) {
+    carlie_tcp_server_buffer_pool_size_class_t *const size_class = &pool->size_classes[i];
+    carlie_tcp_server_buffer_pool_block_t * block = size_class->free_blocks;
+    while (block != null_ptr) {
+      carlie_tcp_server_buffer_pool_block_t *const next_block = block->next_block;
+      free(block);
+      block = next_block;
+    }
+    size_class->free_blocks = null_ptr;
+    size_class->free_blocks_count = 0u;
+  }
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline size_t
+carlie_tcp_server_buffer_pool_get_block_size(carlie_tcp_server_buffer_pool_t const *const pool,
+                                             size_t const size_class_index)
+{
+  assert(size_class_index < CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT);
+  return pool->size_classes[size_class_index].block_size;
+}
+
+
+
+// NOTE: Picks the size class for the next read, based on how many bytes the
+// previous read (from a block of the given size class) got: a read that filled
+// up its block moves up one size class, and a read that would’ve fit into the
+// next smaller size class moves down one.
+CARLIE_C_ALWAYS_INLINE static inline size_t
+carlie_tcp_server_buffer_pool_get_next_size_class_index(carlie_tcp_server_buffer_pool_t const *const pool,
+                                                        size_t const size_class_index,
+                                                        size_t const bytes_count)
+{
+  assert(size_class_index < CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT);
+  if ((bytes_count >= pool->size_classes[size_class_index].block_size) &&
+      ((size_class_index + 1u) < CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT)) {
+    return size_class_index + 1u;
+  }
+  if ((size_class_index > 0u) &&
+      (bytes_count <= pool->size_classes[size_class_index - 1u].block_size)) {
+    return size_class_index - 1u;
+  }
+  return size_class_index;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_buffer_pool_initialize(carlie_tcp_server_buffer_pool_t *const pool)
+{
+  size_t const block_sizes[CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT] = {
+    2048u,
+    8192u,
+    32768u,
+    65536u,
+  };
+  for (size_t i = 0u; i < CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT; i++) {
+    carlie_tcp_server_buffer_pool_size_class_t *const size_class = &pool->size_classes[i];
+    size_class->block_size = block_sizes[i];
+    size_class->free_blocks = null_ptr;
+    size_class->free_blocks_count = 0u;
+  }
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_buffer_pool_release(carlie_tcp_server_buffer_pool_t *const pool,
+                                      uint8_t *const bytes)
+{
+  assert(bytes != null_ptr);
+  carlie_tcp_server_buffer_pool_block_t *const block = (carlie_tcp_server_buffer_pool_block_t *) (void *) (bytes - offsetof(carlie_tcp_server_buffer_pool_block_t, bytes));
+  assert(block->size_class_index < CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASSES_COUNT);
+  carlie_tcp_server_buffer_pool_size_class_t *const size_class = &pool->size_classes[block->size_class_index];
+  if (size_class->free_blocks_count >= CARLIE_TCP_SERVER_BUFFER_POOL_SIZE_CLASS_MAXIMUM_FREE_BLOCKS_COUNT) {
+    free(block);
+    return;
+  }
+  block->next_block = size_class->free_blocks;
+  size_class->free_blocks = block;
+  size_class->free_blocks_count += 1u;
+}
+
+
+
+#endif
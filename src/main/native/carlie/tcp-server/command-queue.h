@@ -0,0 +1,121 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+
+
+#ifndef IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_COMMAND_QUEUE_H
+#define IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_COMMAND_QUEUE_H 1
+
+
+
+#include <carlie/common.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <uv.h>
+
+
+
+/*
+ *******************************************************************************
+ * Internal API type definitions.                                              *
+ *******************************************************************************
+ */
+typedef struct _carlie_tcp_server_command carlie_tcp_server_command_t;
+typedef struct _carlie_tcp_server_command_queue carlie_tcp_server_command_queue_t;
+typedef void (*carlie_tcp_server_command_handler_t)(carlie_tcp_server_command_t * command,
+                                                    uv_loop_t * loop_handle);
+
+
+
+// NOTE: Commands are intrusive: each command record (read, write, close, etc.)
+// embeds one of these as its first member, so that queueing a command doesn’t
+// allocate anything by itself. A command may be freed by its handler.
+struct _carlie_tcp_server_command {
+  carlie_tcp_server_command_handler_t handler;
+  carlie_tcp_server_command_t * next_command;
+};
+
+
+
+// NOTE: A multiple-producer, single-consumer queue: any thread may push
+// commands (lock-free), but only the loop’s thread may take them, and it always
+// takes all of them at once, so there’s no ABA problem to worry about.
+struct _carlie_tcp_server_command_queue {
+  carlie_tcp_server_command_t * head;
+};
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_command_queue_initialize(carlie_tcp_server_command_queue_t *const queue);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_command_queue_push(carlie_tcp_server_command_queue_t *const queue,
+                                     carlie_tcp_server_command_t *const command);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_command_t *
+carlie_tcp_server_command_queue_take_all(carlie_tcp_server_command_queue_t *const queue);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_command_queue_initialize(carlie_tcp_server_command_queue_t *const queue)
+{
+  __atomic_store_n(&queue->head, null_ptr, __ATOMIC_RELAXED);
+}
+
+
+
+// NOTE: Returns whether the queue was empty before the command got pushed; only
+// then does the consumer have to be woken up, since otherwise a wake-up is
+// already on its way for the commands pushed earlier.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_command_queue_push(carlie_tcp_server_command_queue_t *const queue,
+                                     carlie_tcp_server_command_t *const command)
+{
+  carlie_tcp_server_command_t * head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+  do {
+    command->next_command = head;
+  } while (! __atomic_compare_exchange_n(&queue->head, &head, command, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+  return (head == null_ptr);
+}
+
+
+
+// NOTE: Returns the commands in the order they were pushed.
+CARLIE_C_ALWAYS_INLINE static inline carlie_tcp_server_command_t *
+carlie_tcp_server_command_queue_take_all(carlie_tcp_server_command_queue_t *const queue)
+{
+  carlie_tcp_server_command_t * command = __atomic_exchange_n(&queue->head, null_ptr, __ATOMIC_ACQUIRE);
+  carlie_tcp_server_command_t * commands = null_ptr;
+  while (command != null_ptr) {
+    carlie_tcp_server_command_t *const next_command = command->next_command;
+    command->next_command = commands;
+    commands = command;
+    command = next_command;
+  }
+  return commands;
+}
+
+
+
+#endif
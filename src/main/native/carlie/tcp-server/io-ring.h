@@ -0,0 +1,226 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+
+
+#ifndef IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_IO_RING_H
+#define IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_IO_RING_H 1
+
+
+
+#include <carlie/common.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/*
+ *******************************************************************************
+ * Some useful macros.                                                         *
+ *******************************************************************************
+ */
+// NOTE: The layout of a ring is shared with the JVM side (see `IoRing.kt`), so
+// none of these can change on one side only. The capacity has to be a power of
+// two.
+#define CARLIE_TCP_SERVER_IO_RING_CAPACITY 1024u
+#define CARLIE_TCP_SERVER_IO_RING_ENTRY_SIZE 32u
+#define CARLIE_TCP_SERVER_IO_RING_HEADER_SIZE 128u
+#define CARLIE_TCP_SERVER_IO_RING_OPCODE_CLOSE 3
+#define CARLIE_TCP_SERVER_IO_RING_OPCODE_READ 1
+#define CARLIE_TCP_SERVER_IO_RING_OPCODE_WRITE 2
+// NOTE: The operation ID a connection’s closed event is reported with, so that
+// it stays in order with the connection’s completions.
+#define CARLIE_TCP_SERVER_IO_RING_CLOSED_OPERATION_ID (-1)
+
+
+
+/*
+ *******************************************************************************
+ * Internal API type definitions.                                              *
+ *******************************************************************************
+ */
+typedef struct _carlie_tcp_server_io_ring carlie_tcp_server_io_ring_t;
+typedef struct _carlie_tcp_server_io_ring_completion_entry carlie_tcp_server_io_ring_completion_entry_t;
+typedef struct _carlie_tcp_server_io_ring_header carlie_tcp_server_io_ring_header_t;
+typedef struct _carlie_tcp_server_io_ring_submission_entry carlie_tcp_server_io_ring_submission_entry_t;
+
+
+
+struct _carlie_tcp_server_io_ring_completion_entry {
+  uint64_t connection_native_object_address;
+  int32_t operation_id;
+  int32_t result;
+  int32_t error_number;
+  uint8_t padding[12];
+};
+
+
+
+// NOTE: The producers’ and the consumer’s indices live on separate cache lines,
+// so that the two sides don’t keep stealing the line from one another. Indices
+// only ever grow (wrapping around), and are masked into the entries.
+struct _carlie_tcp_server_io_ring_header {
+  uint32_t tail;
+  uint8_t padding_0[60];
+  uint32_t head;
+  uint32_t needs_wake_up;
+  uint32_t has_overflowed;
+  uint8_t padding_1[52];
+};
+
+
+
+// NOTE: Submissions can come from any number of JVM threads at once, so every
+// entry carries a sequence number (à la Vyukov’s bounded queue): a producer
+// claims an entry by advancing the tail, fills it in, and only then publishes
+// it by bumping its sequence number; the consumer hands the entry back to the
+// producers by moving its sequence number one lap ahead.
+struct _carlie_tcp_server_io_ring_submission_entry {
+  uint64_t connection_native_object_address;
+  uint64_t buffer_address;
+  uint32_t buffer_size;
+  int32_t opcode;
+  int32_t operation_id;
+  uint32_t sequence;
+};
+
+
+
+struct _carlie_tcp_server_io_ring {
+  uint8_t * entries;
+  carlie_tcp_server_io_ring_header_t * header;
+  uint8_t * memory;
+};
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_io_ring_destroy(carlie_tcp_server_io_ring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_ring_has_submission(carlie_tcp_server_io_ring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_ring_initialize(carlie_tcp_server_io_ring_t *const ring,
+                                     bool const is_submission_ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_ring_put_completion(carlie_tcp_server_io_ring_t *const ring,
+                                         carlie_tcp_server_io_ring_completion_entry_t const *const entry);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_ring_take_submission(carlie_tcp_server_io_ring_t *const ring,
+                                          carlie_tcp_server_io_ring_submission_entry_t *const entry);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_io_ring_destroy(carlie_tcp_server_io_ring_t *const ring)
+{
+  free(ring->memory);
+  ring->entries = null_ptr;
+  ring->header = null_ptr;
+  ring->memory = null_ptr;
+}
+
+
+
+// NOTE: Only ever called on the loop’s thread (the one consumer).
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_ring_has_submission(carlie_tcp_server_io_ring_t *const ring)
+{
+  uint32_t const head = ring->header->head;
+  carlie_tcp_server_io_ring_submission_entry_t *const ring_entry = (carlie_tcp_server_io_ring_submission_entry_t *) (void *) (ring->entries + ((head & (CARLIE_TCP_SERVER_IO_RING_CAPACITY - 1u)) * CARLIE_TCP_SERVER_IO_RING_ENTRY_SIZE));
+  return (__atomic_load_n(&ring_entry->sequence, __ATOMIC_ACQUIRE) == (head + 1u));
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_ring_initialize(carlie_tcp_server_io_ring_t *const ring,
+                                     bool const is_submission_ring)
+{
+  uint8_t *const memory = calloc(1u, CARLIE_TCP_SERVER_IO_RING_HEADER_SIZE + (CARLIE_TCP_SERVER_IO_RING_CAPACITY * CARLIE_TCP_SERVER_IO_RING_ENTRY_SIZE));
+  if (memory == null_ptr) {
+    return false;
+  }
+  ring->entries = memory + CARLIE_TCP_SERVER_IO_RING_HEADER_SIZE;
+  ring->header = (carlie_tcp_server_io_ring_header_t *) (void *) memory;
+  ring->memory = memory;
+  if (is_submission_ring) {
+    for (uint32_t i = 0u; i < CARLIE_TCP_SERVER_IO_RING_CAPACITY; i++) {
+      carlie_tcp_server_io_ring_submission_entry_t *const entry = (carlie_tcp_server_io_ring_submission_entry_t *) (void *) (ring->entries + (i * CARLIE_TCP_SERVER_IO_RING_ENTRY_SIZE));
+      entry->sequence = i;
+    }
+  }
+  return true;
+}
+
+
+
+// NOTE: Only ever called on the loop’s thread (the one producer). Returns
+// whether there was room for the entry.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_ring_put_completion(carlie_tcp_server_io_ring_t *const ring,
+                                         carlie_tcp_server_io_ring_completion_entry_t const *const entry)
+{
+  uint32_t const tail = ring->header->tail;
+  uint32_t const head = __atomic_load_n(&ring->header->head, __ATOMIC_ACQUIRE);
+  if ((tail - head) == CARLIE_TCP_SERVER_IO_RING_CAPACITY) {
+    return false;
+  }
+  uint8_t *const bytes = ring->entries + ((tail & (CARLIE_TCP_SERVER_IO_RING_CAPACITY - 1u)) * CARLIE_TCP_SERVER_IO_RING_ENTRY_SIZE);
+  memcpy(bytes, entry, sizeof(carlie_tcp_server_io_ring_completion_entry_t));
+  __atomic_store_n(&ring->header->tail, tail + 1u, __ATOMIC_RELEASE);
+  return true;
+}
+
+
+
+// NOTE: Only ever called on the loop’s thread (the one consumer). Returns
+// whether there was a published entry to take.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_ring_take_submission(carlie_tcp_server_io_ring_t *const ring,
+                                          carlie_tcp_server_io_ring_submission_entry_t *const entry)
+{
+  uint32_t const head = ring->header->head;
+  carlie_tcp_server_io_ring_submission_entry_t *const ring_entry = (carlie_tcp_server_io_ring_submission_entry_t *) (void *) (ring->entries + ((head & (CARLIE_TCP_SERVER_IO_RING_CAPACITY - 1u)) * CARLIE_TCP_SERVER_IO_RING_ENTRY_SIZE));
+  uint32_t const sequence = __atomic_load_n(&ring_entry->sequence, __ATOMIC_ACQUIRE);
+  if (sequence != (head + 1u)) {
+    return false;
+  }
+  entry[0] = ring_entry[0];
+  __atomic_store_n(&ring_entry->sequence, head + CARLIE_TCP_SERVER_IO_RING_CAPACITY, __ATOMIC_RELEASE);
+  __atomic_store_n(&ring->header->head, head + 1u, __ATOMIC_RELEASE);
+  return true;
+}
+
+
+
+#endif
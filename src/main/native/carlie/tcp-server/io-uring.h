@@ -0,0 +1,490 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+
+
+#ifndef IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_IO_URING_H
+#define IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_IO_URING_H 1
+
+
+
+#include <carlie/common.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+// NOTE: The io_uring transport needs multishot receives and provided buffer
+// rings, i.e., Linux 6.0 headers (or newer); without them, only libuv is
+// available. Whether the running kernel supports them is only known once a
+// ring gets set up (see `carlie_tcp_server_io_uring_initialize(…)`).
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(IORING_RECV_MULTISHOT) &&     \
+    defined(IORING_ACCEPT_MULTISHOT) &&   \
+    defined(IORING_ASYNC_CANCEL_FD) &&    \
+    defined(__NR_io_uring_setup)
+#define CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE 1
+#endif
+#endif
+#endif
+
+
+
+#if defined(CARLIE_TCP_SERVER_IO_URING_IS_AVAILABLE)
+
+
+
+/*
+ *******************************************************************************
+ * Some useful macros.                                                         *
+ *******************************************************************************
+ */
+// NOTE: The completion queue is a lot bigger than the submission queue, since
+// a single multishot accept or receive can post any number of completions.
+#define CARLIE_TCP_SERVER_IO_URING_COMPLETION_ENTRIES_COUNT 2048u
+#define CARLIE_TCP_SERVER_IO_URING_SUBMISSION_ENTRIES_COUNT 256u
+// NOTE: The buffers the kernel picks from for multishot receives; the count
+// has to be a power of two.
+#define CARLIE_TCP_SERVER_IO_URING_READ_BUFFER_GROUP_ID 0u
+#define CARLIE_TCP_SERVER_IO_URING_READ_BUFFER_SIZE 16384u
+#define CARLIE_TCP_SERVER_IO_URING_READ_BUFFERS_COUNT 128u
+// NOTE: What an operation is, is kept in the low bits of its user data (the
+// rest being the address of whatever it belongs to, which is always aligned
+// well enough for that). Operations with no user data at all (e.g.,
+// cancellations) don’t get handled.
+#define CARLIE_TCP_SERVER_IO_URING_OPERATION_ACCEPT 1u
+#define CARLIE_TCP_SERVER_IO_URING_OPERATION_KIND_MASK 7u
+#define CARLIE_TCP_SERVER_IO_URING_OPERATION_READ 2u
+#define CARLIE_TCP_SERVER_IO_URING_OPERATION_WRITE 3u
+
+
+
+/*
+ *******************************************************************************
+ * Internal API type definitions.                                              *
+ *******************************************************************************
+ */
+typedef struct _carlie_tcp_server_io_uring carlie_tcp_server_io_uring_t;
+
+
+
+// NOTE: A bare-bones io_uring instance (there’s no liburing to lean on), only
+// ever used by its loop’s thread: entries get queued as the loop goes, and
+// are all submitted at once, with a single `io_uring_enter(…)` call, whenever
+// the loop is done with a round of callbacks.
+struct _carlie_tcp_server_io_uring {
+  struct io_uring_cqe * completion_queue_entries;
+  uint32_t * completion_queue_head;
+  uint32_t completion_queue_mask;
+  uint32_t * completion_queue_tail;
+  uint8_t * completion_queue_memory;
+  size_t completion_queue_memory_size;
+  int descriptor;
+  struct io_uring_buf_ring * read_buffer_ring;
+  size_t read_buffer_ring_memory_size;
+  uint8_t * read_buffers;
+  uint32_t * submission_queue_array;
+  struct io_uring_sqe * submission_queue_entries;
+  size_t submission_queue_entries_memory_size;
+  uint32_t submission_queue_entries_count;
+  uint32_t * submission_queue_flags;
+  uint32_t * submission_queue_head;
+  uint32_t submission_queue_mask;
+  uint8_t * submission_queue_memory;
+  size_t submission_queue_memory_size;
+  uint32_t * submission_queue_tail;
+  uint32_t submission_queue_unpublished_tail;
+};
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_io_uring_consume_completion(carlie_tcp_server_io_uring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_io_uring_destroy(carlie_tcp_server_io_uring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_io_uring_enter(carlie_tcp_server_io_uring_t *const ring,
+                                 uint32_t const minimum_completions_count);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline uint8_t *
+carlie_tcp_server_io_uring_get_read_buffer(carlie_tcp_server_io_uring_t *const ring,
+                                           uint16_t const buffer_id);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline struct io_uring_sqe *
+carlie_tcp_server_io_uring_get_submission_entry(carlie_tcp_server_io_uring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_uring_has_unsubmitted_entries(carlie_tcp_server_io_uring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_uring_initialize(carlie_tcp_server_io_uring_t *const ring,
+                                      int32_t *const error_number_ptr);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_uring_is_supported(carlie_tcp_server_io_uring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_uring_needs_flush(carlie_tcp_server_io_uring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline struct io_uring_cqe *
+carlie_tcp_server_io_uring_peek_completion(carlie_tcp_server_io_uring_t *const ring);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_io_uring_provide_read_buffer(carlie_tcp_server_io_uring_t *const ring,
+                                               uint16_t const buffer_id);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_io_uring_consume_completion(carlie_tcp_server_io_uring_t *const ring)
+{
+  uint32_t const head = ring->completion_queue_head[0];
+  __atomic_store_n(ring->completion_queue_head, head + 1u, __ATOMIC_RELEASE);
+}
+
+
+
+// NOTE: Closing the ring’s descriptor cancels whatever is still in flight, so
+// anything that has to know about those operations must have been dealt with
+// beforehand.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_io_uring_destroy(carlie_tcp_server_io_uring_t *const ring)
+{
+  if (ring->descriptor >= 0) {
+    close(ring->descriptor);
+  }
+  if (ring->read_buffer_ring != null_ptr) {
+    munmap((void *) ring->read_buffer_ring, ring->read_buffer_ring_memory_size);
+  }
+  free(ring->read_buffers);
+  if (ring->submission_queue_entries != null_ptr) {
+    munmap((void *) ring->submission_queue_entries, ring->submission_queue_entries_memory_size);
+  }
+  if ((ring->completion_queue_memory != null_ptr) &&
+      (ring->completion_queue_memory != ring->submission_queue_memory)) {
+    munmap((void *) ring->completion_queue_memory, ring->completion_queue_memory_size);
+  }
+  if (ring->submission_queue_memory != null_ptr) {
+    munmap((void *) ring->submission_queue_memory, ring->submission_queue_memory_size);
+  }
+  memset(ring, 0, sizeof(carlie_tcp_server_io_uring_t));
+  ring->descriptor = -1;
+}
+
+
+
+// NOTE: Submits every entry queued so far (that the kernel hasn’t consumed
+// yet), and waits for the given number of completions, if any. Returns the
+// number of entries submitted, or a (negative) libuv error number.
+CARLIE_C_ALWAYS_INLINE static inline int32_t
+carlie_tcp_server_io_uring_enter(carlie_tcp_server_io_uring_t *const ring,
+                                 uint32_t const minimum_completions_count)
+{
+  uint32_t const tail = ring->submission_queue_unpublished_tail;
+  __atomic_store_n(ring->submission_queue_tail, tail, __ATOMIC_RELEASE);
+  uint32_t const entries_count = tail - __atomic_load_n(ring->submission_queue_head, __ATOMIC_ACQUIRE);
+  // NOTE: An overflowed completion queue only gets flushed by the kernel when
+  // it’s asked for completions.
+  bool const gets_completions = (minimum_completions_count > 0u) ||
+    ((__atomic_load_n(ring->submission_queue_flags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) != 0u);
+  if ((entries_count == 0u) && (! gets_completions)) {
+    return 0;
+  }
+  unsigned int const flags = (gets_completions) ?
+    IORING_ENTER_GETEVENTS :
+    0u;
+  long result;
+  do {
+    result = syscall(__NR_io_uring_enter, ring->descriptor, entries_count, minimum_completions_count, flags, null_ptr, (size_t) 0u);
+  } while ((result < 0) &&
+           (errno == EINTR));
+  if (result < 0) {
+    // NOTE: libuv’s error numbers are negated `errno` values on this platform.
+    return (int32_t) -errno;
+  }
+  return (int32_t) result;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline uint8_t *
+carlie_tcp_server_io_uring_get_read_buffer(carlie_tcp_server_io_uring_t *const ring,
+                                           uint16_t const buffer_id)
+{
+  assert(buffer_id < CARLIE_TCP_SERVER_IO_URING_READ_BUFFERS_COUNT);
+  return ring->read_buffers + (((size_t) buffer_id) * CARLIE_TCP_SERVER_IO_URING_READ_BUFFER_SIZE);
+}
+
+
+
+// NOTE: Returns a zeroed-out entry, queued right away (but not submitted until
+// the next `carlie_tcp_server_io_uring_enter(…)`), or null when the
+// submission queue is full, in which case entering the ring makes room.
+CARLIE_C_ALWAYS_INLINE static inline struct io_uring_sqe *
+carlie_tcp_server_io_uring_get_submission_entry(carlie_tcp_server_io_uring_t *const ring)
+{
+  uint32_t const tail = ring->submission_queue_unpublished_tail;
+  uint32_t const head = __atomic_load_n(ring->submission_queue_head, __ATOMIC_ACQUIRE);
+  if ((tail - head) >= ring->submission_queue_entries_count) {
+    return null_ptr;
+  }
+  struct io_uring_sqe *const entry = &ring->submission_queue_entries[tail & ring->submission_queue_mask];
+  memset(entry, 0, sizeof(struct io_uring_sqe));
+  ring->submission_queue_unpublished_tail = tail + 1u;
+  return entry;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_uring_has_unsubmitted_entries(carlie_tcp_server_io_uring_t *const ring)
+{
+  return (ring->submission_queue_unpublished_tail != __atomic_load_n(ring->submission_queue_head, __ATOMIC_ACQUIRE));
+}
+
+
+
+// NOTE: Sets up the ring and its read buffers, and makes sure that the kernel
+// supports everything the transport relies on; any failure leaves the ring
+// destroyed, with the reason in `error_number_ptr` (a libuv error number).
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_uring_initialize(carlie_tcp_server_io_uring_t *const ring,
+                                      int32_t *const error_number_ptr)
+{
+  memset(ring, 0, sizeof(carlie_tcp_server_io_uring_t));
+  ring->descriptor = -1;
+  struct io_uring_params parameters;
+  memset(&parameters, 0, sizeof(parameters));
+  parameters.flags = IORING_SETUP_CQSIZE;
+  parameters.cq_entries = CARLIE_TCP_SERVER_IO_URING_COMPLETION_ENTRIES_COUNT;
+  long const descriptor = syscall(__NR_io_uring_setup, CARLIE_TCP_SERVER_IO_URING_SUBMISSION_ENTRIES_COUNT, &parameters);
+  if (descriptor < 0) {
+    error_number_ptr[0] = (int32_t) -errno;
+    return false;
+  }
+  ring->descriptor = (int) descriptor;
+  // NOTE: Without `IORING_FEAT_NODROP`, completions that don’t fit get
+  // dropped, which multishot operations can’t afford.
+  if ((parameters.features & IORING_FEAT_NODROP) == 0u) {
+    carlie_tcp_server_io_uring_destroy(ring);
+    error_number_ptr[0] = (int32_t) -ENOSYS;
+    return false;
+  }
+  ring->submission_queue_memory_size = parameters.sq_off.array + (parameters.sq_entries * sizeof(uint32_t));
+  ring->completion_queue_memory_size = parameters.cq_off.cqes + (parameters.cq_entries * sizeof(struct io_uring_cqe));
+  bool const uses_single_mapping = ((parameters.features & IORING_FEAT_SINGLE_MMAP) != 0u);
+  if (uses_single_mapping) {
+    if (ring->completion_queue_memory_size > ring->submission_queue_memory_size) {
+      ring->submission_queue_memory_size = ring->completion_queue_memory_size;
+    }
+    ring->completion_queue_memory_size = ring->submission_queue_memory_size;
+  }
+  void * memory;
+  memory = mmap(null_ptr, ring->submission_queue_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->descriptor, (off_t) IORING_OFF_SQ_RING);
+  if (memory == MAP_FAILED) {
+    error_number_ptr[0] = (int32_t) -errno;
+    carlie_tcp_server_io_uring_destroy(ring);
+    return false;
+  }
+  ring->submission_queue_memory = (uint8_t *) memory;
+  if (uses_single_mapping) {
+    ring->completion_queue_memory = ring->submission_queue_memory;
+  } else {
+    memory = mmap(null_ptr, ring->completion_queue_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->descriptor, (off_t) IORING_OFF_CQ_RING);
+    if (memory == MAP_FAILED) {
+      error_number_ptr[0] = (int32_t) -errno;
+      carlie_tcp_server_io_uring_destroy(ring);
+      return false;
+    }
+    ring->completion_queue_memory = (uint8_t *) memory;
+  }
+  ring->submission_queue_entries_memory_size = parameters.sq_entries * sizeof(struct io_uring_sqe);
+  memory = mmap(null_ptr, ring->submission_queue_entries_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->descriptor, (off_t) IORING_OFF_SQES);
+  if (memory == MAP_FAILED) {
+    error_number_ptr[0] = (int32_t) -errno;
+    carlie_tcp_server_io_uring_destroy(ring);
+    return false;
+  }
+  ring->submission_queue_entries = (struct io_uring_sqe *) memory;
+  ring->submission_queue_array = (uint32_t *) (void *) (ring->submission_queue_memory + parameters.sq_off.array);
+  ring->submission_queue_entries_count = parameters.sq_entries;
+  ring->submission_queue_flags = (uint32_t *) (void *) (ring->submission_queue_memory + parameters.sq_off.flags);
+  ring->submission_queue_head = (uint32_t *) (void *) (ring->submission_queue_memory + parameters.sq_off.head);
+  ring->submission_queue_mask = ((uint32_t *) (void *) (ring->submission_queue_memory + parameters.sq_off.ring_mask))[0];
+  ring->submission_queue_tail = (uint32_t *) (void *) (ring->submission_queue_memory + parameters.sq_off.tail);
+  ring->submission_queue_unpublished_tail = ring->submission_queue_tail[0];
+  ring->completion_queue_entries = (struct io_uring_cqe *) (void *) (ring->completion_queue_memory + parameters.cq_off.cqes);
+  ring->completion_queue_head = (uint32_t *) (void *) (ring->completion_queue_memory + parameters.cq_off.head);
+  ring->completion_queue_mask = ((uint32_t *) (void *) (ring->completion_queue_memory + parameters.cq_off.ring_mask))[0];
+  ring->completion_queue_tail = (uint32_t *) (void *) (ring->completion_queue_memory + parameters.cq_off.tail);
+  // NOTE: Entries are always used in the order they are queued in.
+  for (uint32_t i = 0u; i < ring->submission_queue_entries_count; i++) {
+    ring->submission_queue_array[i] = i;
+  }
+  if (! carlie_tcp_server_io_uring_is_supported(ring)) {
+    carlie_tcp_server_io_uring_destroy(ring);
+    error_number_ptr[0] = (int32_t) -ENOSYS;
+    return false;
+  }
+  ring->read_buffer_ring_memory_size = CARLIE_TCP_SERVER_IO_URING_READ_BUFFERS_COUNT * sizeof(struct io_uring_buf);
+  memory = mmap(null_ptr, ring->read_buffer_ring_memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, (off_t) 0);
+  if (memory == MAP_FAILED) {
+    error_number_ptr[0] = (int32_t) -errno;
+    carlie_tcp_server_io_uring_destroy(ring);
+    return false;
+  }
+  ring->read_buffer_ring = (struct io_uring_buf_ring *) memory;
+  ring->read_buffers = malloc(CARLIE_TCP_SERVER_IO_URING_READ_BUFFERS_COUNT * CARLIE_TCP_SERVER_IO_URING_READ_BUFFER_SIZE);
+  if (ring->read_buffers == null_ptr) {
+    error_number_ptr[0] = (int32_t) -ENOMEM;
+    carlie_tcp_server_io_uring_destroy(ring);
+    return false;
+  }
+  struct io_uring_buf_reg read_buffer_ring_registration;
+  memset(&read_buffer_ring_registration, 0, sizeof(read_buffer_ring_registration));
+  read_buffer_ring_registration.ring_addr = (uint64_t) (uintptr_t) ring->read_buffer_ring;
+  read_buffer_ring_registration.ring_entries = CARLIE_TCP_SERVER_IO_URING_READ_BUFFERS_COUNT;
+  read_buffer_ring_registration.bgid = CARLIE_TCP_SERVER_IO_URING_READ_BUFFER_GROUP_ID;
+  long const result = syscall(__NR_io_uring_register, ring->descriptor, IORING_REGISTER_PBUF_RING, &read_buffer_ring_registration, 1u);
+  if (result < 0) {
+    error_number_ptr[0] = (int32_t) -errno;
+    carlie_tcp_server_io_uring_destroy(ring);
+    return false;
+  }
+  for (uint16_t buffer_id = 0u; buffer_id < CARLIE_TCP_SERVER_IO_URING_READ_BUFFERS_COUNT; buffer_id++) {
+    carlie_tcp_server_io_uring_provide_read_buffer(ring, buffer_id);
+  }
+  error_number_ptr[0] = 0;
+  return true;
+}
+
+
+
+// NOTE: Multishot accepts came with Linux 5.19, and multishot receives with
+// 6.0; neither can be probed for directly, so the opcodes that came with the
+// same releases (`IORING_OP_SOCKET` and `IORING_OP_SEND_ZC`) stand in for them.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_uring_is_supported(carlie_tcp_server_io_uring_t *const ring)
+{
+  size_t const probe_size = sizeof(struct io_uring_probe) + (256u * sizeof(struct io_uring_probe_op));
+  struct io_uring_probe *const probe = calloc(1u, probe_size);
+  if (probe == null_ptr) {
+    return false;
+  }
+  long const result = syscall(__NR_io_uring_register, ring->descriptor, IORING_REGISTER_PROBE, probe, 256u);
+  if (result < 0) {
+    free(probe);
+    return false;
+  }
+  uint8_t const operation_codes[] = {
+    (uint8_t) IORING_OP_ACCEPT,
+    (uint8_t) IORING_OP_ASYNC_CANCEL,
+    (uint8_t) IORING_OP_RECV,
+    (uint8_t) IORING_OP_RECVMSG,
+    (uint8_t) IORING_OP_SENDMSG,
+    (uint8_t) IORING_OP_SEND_ZC,
+    (uint8_t) IORING_OP_SOCKET,
+  };
+  size_t const operation_codes_count = sizeof(operation_codes) / sizeof(operation_codes[0]);
+  bool is_supported = true;
+  for (size_t i = 0u; (i < operation_codes_count) && is_supported; i++) {
+    uint8_t const operation_code = operation_codes[i];
+    is_supported = (operation_code < probe->ops_len) &&
+      ((probe->ops[operation_code].flags & IO_URING_OP_SUPPORTED) != 0u);
+  }
+  free(probe);
+  return is_supported;
+}
+
+
+
+// NOTE: Whether the ring has to be entered before the loop goes on: either
+// there are queued entries, or the kernel is holding on to completions that
+// didn’t fit into the completion queue.
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_io_uring_needs_flush(carlie_tcp_server_io_uring_t *const ring)
+{
+  return carlie_tcp_server_io_uring_has_unsubmitted_entries(ring) ||
+    ((__atomic_load_n(ring->submission_queue_flags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) != 0u);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline struct io_uring_cqe *
+carlie_tcp_server_io_uring_peek_completion(carlie_tcp_server_io_uring_t *const ring)
+{
+  uint32_t const head = ring->completion_queue_head[0];
+  uint32_t const tail = __atomic_load_n(ring->completion_queue_tail, __ATOMIC_ACQUIRE);
+  if (head == tail) {
+    return null_ptr;
+  }
+  return &ring->completion_queue_entries[head & ring->completion_queue_mask];
+}
+
+
+
+// NOTE: Hands a read buffer (back) to the kernel, for a multishot receive to
+// pick; its data must have been consumed by then.
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_io_uring_provide_read_buffer(carlie_tcp_server_io_uring_t *const ring,
+                                               uint16_t const buffer_id)
+{
+  struct io_uring_buf_ring *const buffer_ring = ring->read_buffer_ring;
+  uint16_t const tail = buffer_ring->tail;
+  struct io_uring_buf *const buffer = &buffer_ring->bufs[tail & (CARLIE_TCP_SERVER_IO_URING_READ_BUFFERS_COUNT - 1u)];
+  buffer->addr = (uint64_t) (uintptr_t) carlie_tcp_server_io_uring_get_read_buffer(ring, buffer_id);
+  buffer->len = CARLIE_TCP_SERVER_IO_URING_READ_BUFFER_SIZE;
+  buffer->bid = buffer_id;
+  __atomic_store_n(&buffer_ring->tail, (uint16_t) (tail + 1u), __ATOMIC_RELEASE);
+}
+
+
+
+#endif
+
+
+
+#endif
@@ -0,0 +1,196 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+
+
+#ifndef IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_RECORD_POOL_H
+#define IO_SEVENTEENNINETYONE_CARLIE_TCP_SERVER_RECORD_POOL_H 1
+
+
+
+#include <carlie/common.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <uv.h>
+
+
+
+/*
+ *******************************************************************************
+ * Some useful macros.                                                         *
+ *******************************************************************************
+ */
+// NOTE: The number of free records kept around per pool; anything beyond that
+// goes back to `malloc(…)`, so that a burst of operations doesn’t pin memory.
+#define CARLIE_TCP_SERVER_RECORD_POOL_MAXIMUM_FREE_RECORDS_COUNT 256u
+
+
+
+/*
+ *******************************************************************************
+ * Internal API type definitions.                                              *
+ *******************************************************************************
+ */
+typedef struct _carlie_tcp_server_record_pool carlie_tcp_server_record_pool_t;
+typedef struct _carlie_tcp_server_record_pool_record carlie_tcp_server_record_pool_record_t;
+
+
+
+struct _carlie_tcp_server_record_pool_record {
+  carlie_tcp_server_record_pool_record_t * next_record;
+};
+
+
+
+// NOTE: Records are typically acquired on JVM threads and released on the
+// loop’s thread, so a pool is guarded by its own mutex, which is only ever held
+// for a couple of pointer updates; that’s a lot cheaper than going through
+// `malloc(…)`/`free(…)` across threads. The hit/miss counters are only updated
+// while holding the mutex.
+struct _carlie_tcp_server_record_pool {
+  carlie_tcp_server_record_pool_record_t * free_records;
+  size_t free_records_count;
+  uint64_t hits_count;
+  uint64_t misses_count;
+  uv_mutex_t mutex;
+  size_t record_size;
+};
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void *
+carlie_tcp_server_record_pool_acquire(carlie_tcp_server_record_pool_t *const pool);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_record_pool_destroy(carlie_tcp_server_record_pool_t *const pool);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_record_pool_get_counts(carlie_tcp_server_record_pool_t *const pool,
+                                         uint64_t *const hits_count_ptr,
+                                         uint64_t *const misses_count_ptr);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_record_pool_initialize(carlie_tcp_server_record_pool_t *const pool,
+                                         size_t const record_size);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_record_pool_release(carlie_tcp_server_record_pool_t *const pool,
+                                      void *const record);
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void *
+carlie_tcp_server_record_pool_acquire(carlie_tcp_server_record_pool_t *const pool)
+{
+  uv_mutex_lock(&pool->mutex);
+  carlie_tcp_server_record_pool_record_t *const record = pool->free_records;
+  if (record != null_ptr) {
+    pool->free_records = record->next_record;
+    pool->free_records_count -= 1u;
+    pool->hits_count += 1u;
+  } else {
+    pool->misses_count += 1u;
+  }
+  uv_mutex_unlock(&pool->mutex);
+  if (record != null_ptr) {
+    return (void *) record;
+  }
+  return malloc(pool->record_size);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_record_pool_destroy(carlie_tcp_server_record_pool_t *const pool)
+{
+  carlie_tcp_server_record_pool_record_t * record = pool->free_records;
+  while (record != null_ptr) {
+    carlie_tcp_server_record_pool_record_t *const next_record = record->next_record;
+    free(record);
+    record = next_record;
+  }
+  pool->free_records = null_ptr;
+  pool->free_records_count = 0u;
+  uv_mutex_destroy(&pool->mutex);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_record_pool_get_counts(carlie_tcp_server_record_pool_t *const pool,
+                                         uint64_t *const hits_count_ptr,
+                                         uint64_t *const misses_count_ptr)
+{
+  uv_mutex_lock(&pool->mutex);
+  hits_count_ptr[0] = pool->hits_count;
+  misses_count_ptr[0] = pool->misses_count;
+  uv_mutex_unlock(&pool->mutex);
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline bool
+carlie_tcp_server_record_pool_initialize(carlie_tcp_server_record_pool_t *const pool,
+                                         size_t const record_size)
+{
+  assert(record_size >= sizeof(carlie_tcp_server_record_pool_record_t));
+  int32_t const uv_result = (int32_t) uv_mutex_init(&pool->mutex);
+  if (uv_result != 0) {
+    return false;
+  }
+  pool->free_records = null_ptr;
+  pool->free_records_count = 0u;
+  pool->hits_count = 0u;
+  pool->misses_count = 0u;
+  pool->record_size = record_size;
+  return true;
+}
+
+
+
+CARLIE_C_ALWAYS_INLINE static inline void
+carlie_tcp_server_record_pool_release(carlie_tcp_server_record_pool_t *const pool,
+                                      void *const record)
+{
+  assert(record != null_ptr);
+  uv_mutex_lock(&pool->mutex);
+  if (pool->free_records_count >= CARLIE_TCP_SERVER_RECORD_POOL_MAXIMUM_FREE_RECORDS_COUNT) {
+    uv_mutex_unlock(&pool->mutex);
+    free(record);
+    return;
+  }
+  carlie_tcp_server_record_pool_record_t *const free_record = (carlie_tcp_server_record_pool_record_t *) record;
+  free_record->next_record = pool->free_records;
+  pool->free_records = free_record;
+  pool->free_records_count += 1u;
+  uv_mutex_unlock(&pool->mutex);
+}
+
+
+
+#endif
@@ -0,0 +1,1000 @@
+/**
+ *******************************************************************************
+ * Copyright 2019-present Jay B. <j@1791.io>                                   *
+ *                                                                             *
+ * Licensed under the Apache License, Version 2.0 (the "License");             *
+ * you may not use this file except in compliance with the License.            *
+ * You may obtain a copy of the License at                                     *
+ *                                                                             *
+ *     http://www.apache.org/licenses/LICENSE-2.0                              *
+ *                                                                             *
+ * Unless required by applicable law or agreed to in writing, software         *
+ * distributed under the License is distributed on an "AS IS" BASIS,           *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.    *
+ * See the License for the specific language governing permissions and         *
+ * limitations under the License.                                              *
+ *******************************************************************************
+ */
+
+package io.seventeenninetyone.carlie;
+
+import io.seventeenninetyone.carlie.tcp_server.ConnectionDistribution;
+import io.seventeenninetyone.carlie.tcp_server.ServerAlreadyListeningException;
+import io.seventeenninetyone.carlie.tcp_server.ServerClosedException;
+import io.seventeenninetyone.carlie.tcp_server.SocketOption;
+import io.seventeenninetyone.carlie.tcp_server.Transport;
+import io.seventeenninetyone.carlie.tcp_server.UvException;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+import java.io.ByteArrayOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.io.UncheckedIOException;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.Socket;
+import java.net.SocketException;
+import java.net.SocketTimeoutException;
+import java.nio.ByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.CompletionHandler;
+import java.nio.channels.FileChannel;
+import java.nio.channels.ReadPendingException;
+import java.nio.channels.WritePendingException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Future;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+// NOTE: These go through real sockets: the server listens on the loopback
+// interface, and a plain blocking socket plays the client.
+@DisplayName("TcpServer Round-Trip Tests")
+class TcpServerTests
+{
+  private final static long timeoutSeconds = 10L;
+
+  private static void assertPattern(final byte[] bytes,
+                                    final int patternOffset)
+  {
+    for (int index = 0; index < bytes.length; index++) {
+      assertEquals(TcpServerTests.getPatternByte(patternOffset + index), bytes[index]);
+    }
+  }
+
+  // NOTE: Starts the server, connects the given number of clients to it, and has
+  // every connection answer its client (whichever loop it’s served by), so that
+  // it’s known that all of them work. Each client sends its index, and gets a
+  // part of the pattern that depends on it back.
+  private static void assertServesClients(final TcpServer server,
+                                          final int clientsCount)
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int answerSize = 64;
+    final BlockingQueue<TcpServer.Connection> connections = new LinkedBlockingQueue<>();
+    server.onClientConnected(connections::add);
+    server.listen("127.0.0.1", 0);
+    server.start();
+    final TcpServer.Address address = server.getAddress();
+    final List<Socket> clients = new ArrayList<>();
+    try {
+      for (int clientIndex = 0; clientIndex < clientsCount; clientIndex++) {
+        final Socket client = new Socket();
+        clients.add(client);
+        client.setSoTimeout((int) TimeUnit.SECONDS.toMillis(TcpServerTests.timeoutSeconds));
+        client.connect(new InetSocketAddress(InetAddress.getLoopbackAddress(), address.getPort()));
+        final DataOutputStream clientOutputStream = new DataOutputStream(client.getOutputStream());
+        clientOutputStream.writeInt(clientIndex);
+        clientOutputStream.flush();
+      }
+      for (int connectionIndex = 0; connectionIndex < clientsCount; connectionIndex++) {
+        final TcpServer.Connection connection = connections.poll(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+        assertNotNull(connection);
+        final ByteBuffer indexBuffer = ByteBuffer.allocateDirect(4);
+        while (indexBuffer.hasRemaining()) {
+          assertTrue(connection.read(indexBuffer).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue() > 0);
+        }
+        final int clientIndex = indexBuffer.getInt(0);
+        connection.write(TcpServerTests.createPatternBuffer(clientIndex * answerSize, answerSize, false));
+      }
+      assertEquals(clientsCount, server.getConnectionsCount());
+      for (int clientIndex = 0; clientIndex < clientsCount; clientIndex++) {
+        final byte[] receivedBytes = new byte[answerSize];
+        final DataInputStream clientInputStream = new DataInputStream(clients.get(clientIndex).getInputStream());
+        clientInputStream.readFully(receivedBytes);
+        TcpServerTests.assertPattern(receivedBytes, clientIndex * answerSize);
+      }
+    } finally {
+      for (final Socket client : clients) {
+        client.close();
+      }
+    }
+  }
+
+  // NOTE: Issues the given number of writes back to back, without waiting for
+  // any of them to complete, and checks that the client gets all of them, in
+  // order. Their sizes vary, so that some are small enough to be copied into
+  // their records, and they alternate between direct and heap buffers (which
+  // reach the event loop through different paths).
+  private static void assertWritesBackToBack(final TcpServer.Connection connection,
+                                             final Socket client,
+                                             final int writesCount)
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           TimeoutException
+  {
+    final List<Future<Integer>> writeResults = new ArrayList<>();
+    final List<Integer> writeSizes = new ArrayList<>();
+    int bytesCount = 0;
+    for (int writeIndex = 0; writeIndex < writesCount; writeIndex++) {
+      final int writeSize = 1 + ((writeIndex * 37) % 300);
+      final ByteBuffer buffer = TcpServerTests.createPatternBuffer(bytesCount, writeSize, ((writeIndex % 2) == 0));
+      writeResults.add(connection.write(buffer));
+      writeSizes.add(writeSize);
+      bytesCount += writeSize;
+    }
+    final byte[] receivedBytes = new byte[bytesCount];
+    final DataInputStream clientInputStream = new DataInputStream(client.getInputStream());
+    clientInputStream.readFully(receivedBytes);
+    for (int writeIndex = 0; writeIndex < writesCount; writeIndex++) {
+      assertEquals(writeSizes.get(writeIndex).intValue(), writeResults.get(writeIndex).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue());
+    }
+    TcpServerTests.assertPattern(receivedBytes, 0);
+  }
+
+  private static TcpServer.Connection connect(final TcpServer server,
+                                              final Socket client)
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final CompletableFuture<TcpServer.Connection> connectionFuture = new CompletableFuture<>();
+    server.onClientConnected(connectionFuture::complete);
+    server.listen("127.0.0.1", 0);
+    server.start();
+    final TcpServer.Address address = server.getAddress();
+    client.connect(new InetSocketAddress(InetAddress.getLoopbackAddress(), address.getPort()));
+    return connectionFuture.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+  }
+
+  // NOTE: Every byte of what gets written depends on its offset within the
+  // whole stream, so that bytes written out of order don’t go unnoticed.
+  private static ByteBuffer createPatternBuffer(final int patternOffset,
+                                                final int size,
+                                                final boolean isDirect)
+  {
+    final ByteBuffer buffer = isDirect ?
+      ByteBuffer.allocateDirect(size) :
+      ByteBuffer.allocate(size);
+    for (int index = 0; index < size; index++) {
+      buffer.put(TcpServerTests.getPatternByte(patternOffset + index));
+    }
+    buffer.flip();
+    return buffer;
+  }
+
+  private static byte getPatternByte(final int offset)
+  {
+    return (byte) (offset % 251);
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#close()")
+  void testClose()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final CountDownLatch closedLatch = new CountDownLatch(1);
+      connection.onceClosed(closedLatch::countDown);
+      assertTrue(connection.isOpen());
+      // NOTE: The connection gets closed while a read is still pending on it
+      // (the client never sends anything).
+      connection.read(ByteBuffer.allocate(16));
+      connection.close();
+      assertTrue(closedLatch.await(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS));
+      client.setSoTimeout((int) TimeUnit.SECONDS.toMillis(TcpServerTests.timeoutSeconds));
+      assertEquals(-1, client.getInputStream().read());
+      assertFalse(connection.isOpen());
+      assertThrows(ClosedChannelException.class, () -> connection.write(ByteBuffer.allocate(1)));
+      assertThrows(ClosedChannelException.class, () -> connection.read(ByteBuffer.allocate(1)));
+      // NOTE: Closing it again is a no-op.
+      connection.close();
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#pauseReading() and #resumeReading()")
+  void testPauseReading()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int sentBytesCount = 100;
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final ByteArrayOutputStream receivedBytesStream = new ByteArrayOutputStream();
+      final CompletableFuture<Void> allReceivedFuture = new CompletableFuture<>();
+      connection.startReading((data) -> {
+        final byte[] dataBytes = new byte[data.remaining()];
+        data.get(dataBytes);
+        receivedBytesStream.write(dataBytes, 0, dataBytes.length);
+        if (receivedBytesStream.size() >= sentBytesCount) {
+          allReceivedFuture.complete(null);
+        }
+      });
+      assertFalse(connection.isReadingPaused());
+      connection.pauseReading();
+      assertTrue(connection.isReadingPaused());
+      // NOTE: Pausing takes effect on the event loop; a write from a heap
+      // buffer is queued behind it (through the same command queue), so once
+      // the client has received it, reading is known to have been paused.
+      assertEquals(1, connection.write(ByteBuffer.wrap(new byte[] { 42 })).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue());
+      client.setSoTimeout((int) TimeUnit.SECONDS.toMillis(TcpServerTests.timeoutSeconds));
+      assertEquals(42, client.getInputStream().read());
+      final OutputStream clientOutputStream = client.getOutputStream();
+      clientOutputStream.write(TcpServerTests.createPatternBuffer(0, sentBytesCount, false).array());
+      clientOutputStream.flush();
+      Thread.sleep(200L);
+      assertEquals(0, receivedBytesStream.size());
+      connection.resumeReading();
+      assertFalse(connection.isReadingPaused());
+      allReceivedFuture.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+      final byte[] receivedBytes = receivedBytesStream.toByteArray();
+      assertEquals(sentBytesCount, receivedBytes.length);
+      TcpServerTests.assertPattern(receivedBytes, 0);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#read(…) (scattering)")
+  void testScatteringRead()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final ByteBuffer sentBuffer = TcpServerTests.createPatternBuffer(0, 10, false);
+      final OutputStream clientOutputStream = client.getOutputStream();
+      clientOutputStream.write(sentBuffer.array());
+      clientOutputStream.flush();
+      // NOTE: The first buffer is left out (through the offset), and the other
+      // two are a heap buffer and a direct one.
+      final ByteBuffer[] destinationBuffers = new ByteBuffer[] {
+        ByteBuffer.allocate(1),
+        ByteBuffer.allocate(4),
+        ByteBuffer.allocateDirect(6),
+      };
+      long bytesReadCount = 0L;
+      while (bytesReadCount < 10L) {
+        final long result = connection.read(destinationBuffers, 1, 2).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).longValue();
+        assertTrue(result > 0L);
+        bytesReadCount += result;
+      }
+      assertEquals(10L, bytesReadCount);
+      assertEquals(0, destinationBuffers[0].position());
+      assertEquals(0, destinationBuffers[1].remaining());
+      assertEquals(0, destinationBuffers[2].remaining());
+      final byte[] receivedBytes = new byte[10];
+      destinationBuffers[1].flip();
+      destinationBuffers[1].get(receivedBytes, 0, 4);
+      destinationBuffers[2].flip();
+      destinationBuffers[2].get(receivedBytes, 4, 6);
+      TcpServerTests.assertPattern(receivedBytes, 0);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#write(…) (gathering)")
+  void testGatheringWrite()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final ByteBuffer directBuffer = ByteBuffer.allocateDirect(7);
+      directBuffer.put("Hello, ".getBytes(StandardCharsets.US_ASCII));
+      directBuffer.flip();
+      final ByteBuffer[] sourceBuffers = new ByteBuffer[] {
+        directBuffer,
+        ByteBuffer.wrap("world".getBytes(StandardCharsets.US_ASCII)),
+        ByteBuffer.wrap("!".getBytes(StandardCharsets.US_ASCII)),
+      };
+      final long result = connection.write(sourceBuffers, 0, 3).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).longValue();
+      assertEquals(13L, result);
+      for (final ByteBuffer sourceBuffer : sourceBuffers) {
+        assertEquals(0, sourceBuffer.remaining());
+      }
+      final byte[] receivedBytes = new byte[13];
+      final DataInputStream clientInputStream = new DataInputStream(client.getInputStream());
+      clientInputStream.readFully(receivedBytes);
+      assertEquals("Hello, world!", new String(receivedBytes, StandardCharsets.US_ASCII));
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#startReading(…) and #stopReading()")
+  void testStreamingReads()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int sentBytesCount = 1024 * 1024;
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final ByteArrayOutputStream receivedBytesStream = new ByteArrayOutputStream();
+      final CompletableFuture<Void> allReceivedFuture = new CompletableFuture<>();
+      // NOTE: The buffer handed to the handler is only valid until it returns,
+      // so its contents get copied.
+      connection.startReading((data) -> {
+        final byte[] dataBytes = new byte[data.remaining()];
+        data.get(dataBytes);
+        receivedBytesStream.write(dataBytes, 0, dataBytes.length);
+        if (receivedBytesStream.size() >= sentBytesCount) {
+          allReceivedFuture.complete(null);
+        }
+      });
+      final ByteBuffer sentBuffer = TcpServerTests.createPatternBuffer(0, sentBytesCount, false);
+      final OutputStream clientOutputStream = client.getOutputStream();
+      clientOutputStream.write(sentBuffer.array());
+      clientOutputStream.flush();
+      allReceivedFuture.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+      final byte[] receivedBytes = receivedBytesStream.toByteArray();
+      assertEquals(sentBytesCount, receivedBytes.length);
+      TcpServerTests.assertPattern(receivedBytes, 0);
+      // NOTE: Stopping completes on the event loop, so a plain read may be
+      // refused (as pending) for a little while.
+      connection.stopReading();
+      final long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(TcpServerTests.timeoutSeconds);
+      final ByteBuffer destinationBuffer = ByteBuffer.allocate(16);
+      Future<Integer> readResult = null;
+      while (readResult == null) {
+        try {
+          readResult = connection.read(destinationBuffer);
+        } catch (final ReadPendingException exception) {
+          assertTrue(System.nanoTime() < deadline);
+          Thread.sleep(10L);
+        }
+      }
+      clientOutputStream.write(TcpServerTests.createPatternBuffer(sentBytesCount, 16, false).array());
+      clientOutputStream.flush();
+      int bytesReadCount = readResult.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue();
+      while (bytesReadCount < 16) {
+        bytesReadCount += connection.read(destinationBuffer).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue();
+      }
+      assertEquals(sentBytesCount, receivedBytesStream.size());
+      TcpServerTests.assertPattern(destinationBuffer.array(), sentBytesCount);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#isWritable (write watermarks)")
+  void testWriteWatermarks()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int writeSize = 32 * 1024;
+    final int writesCount = 32;
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      server.setWriteWatermarks(16L * 1024L, 64L * 1024L);
+      // NOTE: The client doesn’t read until all the writes have been issued,
+      // and both ends’ socket buffers are small, so that most of what gets
+      // written has to wait on the server’s side.
+      client.setReceiveBufferSize(4 * 1024);
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      connection.setSocketOption(SocketOption.SEND_BUFFER_SIZE, 4 * 1024);
+      final List<Boolean> writabilityChanges = new CopyOnWriteArrayList<>();
+      final CountDownLatch unwritableLatch = new CountDownLatch(1);
+      final CountDownLatch writableLatch = new CountDownLatch(1);
+      connection.onWritabilityChanged((isWritable) -> {
+        writabilityChanges.add(isWritable);
+        if (isWritable) {
+          writableLatch.countDown();
+        } else {
+          unwritableLatch.countDown();
+        }
+      });
+      assertTrue(connection.isWritable());
+      // NOTE: The writes are issued back to back, without waiting for any of
+      // them to complete, alternating between direct and heap buffers (which
+      // reach the event loop through different paths).
+      final List<Future<Integer>> writeResults = new ArrayList<>();
+      for (int writeIndex = 0; writeIndex < writesCount; writeIndex++) {
+        final ByteBuffer buffer = TcpServerTests.createPatternBuffer(writeIndex * writeSize, writeSize, ((writeIndex % 2) == 0));
+        writeResults.add(connection.write(buffer));
+      }
+      assertTrue(unwritableLatch.await(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS));
+      assertFalse(connection.isWritable());
+      assertEquals(1L, server.getUnwritableConnectionsCount());
+      assertTrue(server.getPendingWriteBytesCount() > server.getWriteHighWatermark());
+      final byte[] receivedBytes = new byte[writeSize * writesCount];
+      final DataInputStream clientInputStream = new DataInputStream(client.getInputStream());
+      clientInputStream.readFully(receivedBytes);
+      for (final Future<Integer> writeResult : writeResults) {
+        assertEquals(writeSize, writeResult.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue());
+      }
+      assertTrue(writableLatch.await(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS));
+      assertEquals(Arrays.asList(false, true), writabilityChanges);
+      assertTrue(connection.isWritable());
+      assertEquals(0L, server.getPendingWriteBytesCount());
+      assertEquals(0L, server.getUnwritableConnectionsCount());
+      TcpServerTests.assertPattern(receivedBytes, 0);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#read(…) (direct buffers)")
+  void testDirectRead()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int sentBytesCount = 64 * 1024;
+    final int destinationOffset = 100;
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final OutputStream clientOutputStream = client.getOutputStream();
+      clientOutputStream.write(TcpServerTests.createPatternBuffer(0, sentBytesCount, false).array());
+      clientOutputStream.flush();
+      // NOTE: Only the remaining part of the buffer (between its position and
+      // its limit) may be read into, straight from the native layer.
+      final ByteBuffer destinationBuffer = ByteBuffer.allocateDirect(destinationOffset + sentBytesCount + destinationOffset);
+      destinationBuffer.position(destinationOffset);
+      destinationBuffer.limit(destinationOffset + sentBytesCount);
+      while (destinationBuffer.hasRemaining()) {
+        final int result = connection.read(destinationBuffer).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue();
+        assertTrue(result > 0);
+      }
+      assertEquals(destinationOffset + sentBytesCount, destinationBuffer.position());
+      destinationBuffer.clear();
+      for (int index = 0; index < destinationOffset; index++) {
+        assertEquals(0, destinationBuffer.get(index));
+        assertEquals(0, destinationBuffer.get(destinationOffset + sentBytesCount + index));
+      }
+      final byte[] receivedBytes = new byte[sentBytesCount];
+      destinationBuffer.position(destinationOffset);
+      destinationBuffer.get(receivedBytes);
+      TcpServerTests.assertPattern(receivedBytes, 0);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#write(…) (direct buffers)")
+  void testDirectWrite()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int sentBytesCount = 64 * 1024;
+    final int sourceOffset = 100;
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      // NOTE: Only the remaining part of the buffer (between its position and
+      // its limit) gets written, straight from the native layer.
+      final ByteBuffer sourceBuffer = TcpServerTests.createPatternBuffer(0, sourceOffset + sentBytesCount + sourceOffset, true);
+      sourceBuffer.position(sourceOffset);
+      sourceBuffer.limit(sourceOffset + sentBytesCount);
+      final Future<Integer> writeResult = connection.write(sourceBuffer);
+      final byte[] receivedBytes = new byte[sentBytesCount];
+      final DataInputStream clientInputStream = new DataInputStream(client.getInputStream());
+      clientInputStream.readFully(receivedBytes);
+      assertEquals(sentBytesCount, writeResult.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue());
+      assertEquals(sourceOffset + sentBytesCount, sourceBuffer.position());
+      TcpServerTests.assertPattern(receivedBytes, sourceOffset);
+      // NOTE: Nothing past the limit was written.
+      client.setSoTimeout(200);
+      assertThrows(SocketTimeoutException.class, () -> clientInputStream.read());
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#write(…) (queued writes)")
+  void testQueuedWrites()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      TcpServerTests.assertWritesBackToBack(connection, client, 2000);
+      // NOTE: By the second round, the records of the first one’s writes have
+      // gone back to their pools, to be reused.
+      TcpServerTests.assertWritesBackToBack(connection, client, 2000);
+      final TcpServer.RecordPoolStatistics recordPoolStatistics = server.getRecordPoolStatistics();
+      assertNotNull(recordPoolStatistics);
+      assertTrue(recordPoolStatistics.getHitsCount() > 0L);
+      assertEquals(0L, server.getPendingWriteBytesCount());
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer(loopsCount) (SO_REUSEPORT listeners)")
+  void testReusePortLoops()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    try (final TcpServer server = new TcpServer(4, ConnectionDistribution.REUSE_PORT))
+    {
+      assertEquals(4, server.getLoopsCount());
+      TcpServerTests.assertServesClients(server, 32);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer(loopsCount, ConnectionDistribution.ACCEPTOR_HANDOFF)")
+  void testAcceptorHandoff()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    // NOTE: The first loop accepts every connection, and hands them out to all
+    // four loops in turn.
+    try (final TcpServer server = new TcpServer(4, ConnectionDistribution.ACCEPTOR_HANDOFF))
+    {
+      assertEquals(ConnectionDistribution.ACCEPTOR_HANDOFF, server.getConnectionDistribution());
+      TcpServerTests.assertServesClients(server, 32);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer(EventLoopGroup) (shared event loops)")
+  void testSharedEventLoopGroup()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    // NOTE: The group is closed last, once both servers have been.
+    final EventLoopGroup eventLoopGroup = new EventLoopGroup(2);
+    try (final EventLoopGroup closedEventLoopGroup = eventLoopGroup;
+         final TcpServer firstServer = new TcpServer(eventLoopGroup);
+         final TcpServer secondServer = new TcpServer(eventLoopGroup))
+    {
+      assertEquals(eventLoopGroup.getLoopsCount(), firstServer.getLoopsCount());
+      assertEquals(eventLoopGroup.getLoopsCount(), secondServer.getLoopsCount());
+      TcpServerTests.assertServesClients(firstServer, 16);
+      TcpServerTests.assertServesClients(secondServer, 16);
+    }
+    assertTrue(eventLoopGroup.isClosed());
+  }
+
+  @Test
+  @DisplayName("TcpServer#batchesIoCompletions")
+  void testBatchedIoCompletions()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int sentBytesCount = 4096;
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      server.setBatchesIoCompletions(true);
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      // NOTE: Many writes complete during the same loop iterations, and get
+      // handed over together.
+      TcpServerTests.assertWritesBackToBack(connection, client, 2000);
+      final OutputStream clientOutputStream = client.getOutputStream();
+      clientOutputStream.write(TcpServerTests.createPatternBuffer(0, sentBytesCount, false).array());
+      clientOutputStream.flush();
+      final ByteBuffer destinationBuffer = ByteBuffer.allocateDirect(sentBytesCount);
+      while (destinationBuffer.hasRemaining()) {
+        final ByteBuffer chunkBuffer = destinationBuffer.slice();
+        chunkBuffer.limit(Math.min(16, chunkBuffer.remaining()));
+        final int result = connection.read(chunkBuffer).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue();
+        assertTrue(result > 0);
+        destinationBuffer.position(destinationBuffer.position() + result);
+      }
+      final byte[] receivedBytes = new byte[sentBytesCount];
+      destinationBuffer.flip();
+      destinationBuffer.get(receivedBytes);
+      TcpServerTests.assertPattern(receivedBytes, 0);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer#usesIoRings")
+  void testIoRings()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    // NOTE: Several times as many as the rings hold.
+    final int writesCount = 4 * 1024;
+    final int writeSize = 16;
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      server.setUsesIoRings(true);
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final DataInputStream clientInputStream = new DataInputStream(client.getInputStream());
+      // NOTE: The first write’s completion handler holds up the thread that
+      // completions get dispatched on, so that the completions of the writes
+      // after it pile up past the completion ring’s capacity (and overflow).
+      final CountDownLatch stalledLatch = new CountDownLatch(1);
+      final CountDownLatch releasedLatch = new CountDownLatch(1);
+      connection.write(TcpServerTests.createPatternBuffer(0, writeSize, true), null, new CompletionHandler<Integer, Void>() {
+        @Override
+        public void completed(final Integer result,
+                              final Void attachment)
+        {
+          stalledLatch.countDown();
+          try {
+            releasedLatch.await(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+          } catch (final InterruptedException exception) {
+            Thread.currentThread().interrupt();
+          }
+        }
+
+        @Override
+        public void failed(final Throwable exception,
+                           final Void attachment) {}
+      });
+      assertTrue(stalledLatch.await(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS));
+      final List<Future<Integer>> writeResults = new ArrayList<>();
+      for (int writeIndex = 1; writeIndex <= writesCount; writeIndex++) {
+        writeResults.add(connection.write(TcpServerTests.createPatternBuffer(writeIndex * writeSize, writeSize, true)));
+      }
+      final byte[] receivedBytes = new byte[(1 + writesCount) * writeSize];
+      clientInputStream.readFully(receivedBytes);
+      TcpServerTests.assertPattern(receivedBytes, 0);
+      releasedLatch.countDown();
+      for (final Future<Integer> writeResult : writeResults) {
+        assertEquals(writeSize, writeResult.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue());
+      }
+      // NOTE: Once both sides have been idle for a while, the loop and the
+      // dispatching thread have parked, and have to be woken up by the other
+      // side.
+      Thread.sleep(200L);
+      final ByteBuffer destinationBuffer = ByteBuffer.allocateDirect(writeSize);
+      final Future<Integer> readResult = connection.read(destinationBuffer);
+      final OutputStream clientOutputStream = client.getOutputStream();
+      clientOutputStream.write(TcpServerTests.createPatternBuffer(0, writeSize, false).array());
+      clientOutputStream.flush();
+      int bytesReadCount = readResult.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue();
+      while (bytesReadCount < writeSize) {
+        bytesReadCount += connection.read(destinationBuffer).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue();
+      }
+      destinationBuffer.flip();
+      final byte[] readBytes = new byte[writeSize];
+      destinationBuffer.get(readBytes);
+      TcpServerTests.assertPattern(readBytes, 0);
+      Thread.sleep(200L);
+      assertEquals(writeSize, connection.write(TcpServerTests.createPatternBuffer(0, writeSize, true)).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue());
+      final byte[] lastReceivedBytes = new byte[writeSize];
+      clientInputStream.readFully(lastReceivedBytes);
+      TcpServerTests.assertPattern(lastReceivedBytes, 0);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer(…, Transport.IO_URING)")
+  void testIoUringTransport()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int readBytesCount = 4096;
+    final int streamedBytesCount = 1024 * 1024;
+    try (final TcpServer server = new TcpServer(1, ConnectionDistribution.REUSE_PORT, Transport.IO_URING);
+         final Socket client = new Socket())
+    {
+      // NOTE: The server falls back to libuv where io_uring isn’t supported.
+      assumeTrue(server.getTransport() == Transport.IO_URING);
+      // NOTE: Accepted through a multishot accept.
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final OutputStream clientOutputStream = client.getOutputStream();
+      // NOTE: Read with a receive straight into a direct buffer.
+      clientOutputStream.write(TcpServerTests.createPatternBuffer(0, readBytesCount, false).array());
+      clientOutputStream.flush();
+      final ByteBuffer destinationBuffer = ByteBuffer.allocateDirect(readBytesCount);
+      while (destinationBuffer.hasRemaining()) {
+        assertTrue(connection.read(destinationBuffer).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue() > 0);
+      }
+      destinationBuffer.flip();
+      final byte[] readBytes = new byte[readBytesCount];
+      destinationBuffer.get(readBytes);
+      TcpServerTests.assertPattern(readBytes, 0);
+      // NOTE: Sends on a socket aren’t ordered by io_uring, so only one is in
+      // flight at a time, and the others queue up behind it.
+      TcpServerTests.assertWritesBackToBack(connection, client, 2000);
+      // NOTE: Streamed with a multishot receive, into the ring of buffers shared
+      // with the kernel.
+      final ByteArrayOutputStream receivedBytesStream = new ByteArrayOutputStream();
+      final CompletableFuture<Void> allReceivedFuture = new CompletableFuture<>();
+      connection.startReading((data) -> {
+        final byte[] dataBytes = new byte[data.remaining()];
+        data.get(dataBytes);
+        receivedBytesStream.write(dataBytes, 0, dataBytes.length);
+        if (receivedBytesStream.size() >= streamedBytesCount) {
+          allReceivedFuture.complete(null);
+        }
+      });
+      clientOutputStream.write(TcpServerTests.createPatternBuffer(0, streamedBytesCount, false).array());
+      clientOutputStream.flush();
+      allReceivedFuture.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+      final byte[] receivedBytes = receivedBytesStream.toByteArray();
+      assertEquals(streamedBytesCount, receivedBytes.length);
+      TcpServerTests.assertPattern(receivedBytes, 0);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#transferFrom(…)")
+  void testTransferFrom()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int fileSize = 3 * 1024 * 1024;
+    final int fileOffset = 1000;
+    final Path path = Files.createTempFile("carlie-", ".bin");
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      Files.write(path, TcpServerTests.createPatternBuffer(0, fileSize, false).array());
+      // NOTE: The client’s receive buffer is small, so that the socket keeps
+      // filling up; the rest of each turn is then read from the file and
+      // written with a plain write instead.
+      client.setReceiveBufferSize(4 * 1024);
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      final DataInputStream clientInputStream = new DataInputStream(client.getInputStream());
+      // NOTE: Asks for more than there is, and stops at the end of the file.
+      final Future<Long> transferResult = connection.transferFrom(path, fileOffset, fileSize);
+      final byte[] receivedBytes = new byte[fileSize - fileOffset];
+      clientInputStream.readFully(receivedBytes);
+      assertEquals(fileSize - fileOffset, transferResult.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).longValue());
+      TcpServerTests.assertPattern(receivedBytes, fileOffset);
+      // NOTE: The channel can be closed as soon as the transfer has started.
+      final Future<Long> lastTransferResult;
+      try (final FileChannel fileChannel = FileChannel.open(path, StandardOpenOption.READ)) {
+        lastTransferResult = connection.transferFrom(fileChannel, fileSize - 10, 100L);
+      }
+      final byte[] lastReceivedBytes = new byte[10];
+      clientInputStream.readFully(lastReceivedBytes);
+      assertEquals(10L, lastTransferResult.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).longValue());
+      TcpServerTests.assertPattern(lastReceivedBytes, fileSize - 10);
+      assertEquals(0L, server.getPendingWriteBytesCount());
+    } finally {
+      Files.delete(path);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer.Connection#relayTo(…)")
+  void testRelayTo()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    final int sentBytesCount = 4 * 1024 * 1024;
+    try (final TcpServer server = new TcpServer();
+         final Socket sourceClient = new Socket();
+         final Socket destinationClient = new Socket())
+    {
+      final BlockingQueue<TcpServer.Connection> connections = new LinkedBlockingQueue<>();
+      server.onClientConnected(connections::add);
+      server.listen("127.0.0.1", 0);
+      server.start();
+      final TcpServer.Address address = server.getAddress();
+      sourceClient.connect(new InetSocketAddress(InetAddress.getLoopbackAddress(), address.getPort()));
+      final TcpServer.Connection sourceConnection = connections.poll(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+      assertNotNull(sourceConnection);
+      destinationClient.connect(new InetSocketAddress(InetAddress.getLoopbackAddress(), address.getPort()));
+      final TcpServer.Connection destinationConnection = connections.poll(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+      assertNotNull(destinationConnection);
+      final Future<?> relayResult = sourceConnection.relayTo(destinationConnection);
+      // NOTE: Nothing else may be written to the destination while the relay
+      // runs.
+      assertThrows(WritePendingException.class, () -> destinationConnection.write(ByteBuffer.allocate(1)));
+      // NOTE: The client sends from a thread of its own, since it only gets to
+      // send it all as the other client receives it (through the relay).
+      final CompletableFuture<Void> sentFuture = CompletableFuture.runAsync(() -> {
+        try {
+          final OutputStream sourceClientOutputStream = sourceClient.getOutputStream();
+          sourceClientOutputStream.write(TcpServerTests.createPatternBuffer(0, sentBytesCount, false).array());
+          sourceClientOutputStream.flush();
+          sourceClient.shutdownOutput();
+        } catch (final IOException exception) {
+          throw new UncheckedIOException(exception);
+        }
+      });
+      destinationClient.setSoTimeout((int) TimeUnit.SECONDS.toMillis(TcpServerTests.timeoutSeconds));
+      final DataInputStream destinationClientInputStream = new DataInputStream(destinationClient.getInputStream());
+      final byte[] receivedBytes = new byte[sentBytesCount];
+      destinationClientInputStream.readFully(receivedBytes);
+      TcpServerTests.assertPattern(receivedBytes, 0);
+      sentFuture.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+      // NOTE: The end-of-stream is passed on, and ends the relay.
+      assertEquals(-1, destinationClientInputStream.read());
+      relayResult.get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS);
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer#setDefaultSocketOption(…) and TcpServer.Connection#setSocketOption(…)")
+  void testSocketOptions()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    try (final TcpServer server = new TcpServer();
+         final Socket client = new Socket())
+    {
+      assertThrows(IllegalArgumentException.class, () -> server.setDefaultSocketOption(SocketOption.SEND_BUFFER_SIZE, 0));
+      // NOTE: Lingering for no time at all makes closing a connection reset it,
+      // which the client gets to see; the connection inherits it as it gets
+      // accepted.
+      server.setDefaultSocketOption(SocketOption.LINGER, 0);
+      final TcpServer.Connection connection = TcpServerTests.connect(server, client);
+      assertThrows(IllegalArgumentException.class, () -> connection.setSocketOption(SocketOption.RECEIVE_BUFFER_SIZE, -1));
+      connection.setSocketOption(SocketOption.NO_DELAY, 0);
+      connection.setSocketOption(SocketOption.RECEIVE_BUFFER_SIZE, 64 * 1024);
+      connection.setSocketOption(SocketOption.NO_DELAY, 1);
+      assertEquals(1, connection.write(ByteBuffer.wrap(new byte[] { 42 })).get(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS).intValue());
+      client.setSoTimeout((int) TimeUnit.SECONDS.toMillis(TcpServerTests.timeoutSeconds));
+      final InputStream clientInputStream = client.getInputStream();
+      assertEquals(42, clientInputStream.read());
+      final CountDownLatch closedLatch = new CountDownLatch(1);
+      connection.onceClosed(closedLatch::countDown);
+      connection.close();
+      assertTrue(closedLatch.await(TcpServerTests.timeoutSeconds, TimeUnit.SECONDS));
+      assertThrows(SocketException.class, () -> clientInputStream.read());
+      assertThrows(ClosedChannelException.class, () -> connection.setSocketOption(SocketOption.NO_DELAY, 1));
+    }
+  }
+
+  @Test
+  @DisplayName("TcpServer#setListenBacklog(…) and TcpServer#setAcceptBatchSize(…)")
+  void testListenBacklogAndAcceptBatchSize()
+    throws ExecutionException,
+           InterruptedException,
+           IOException,
+           ServerAlreadyListeningException,
+           ServerClosedException,
+           TimeoutException,
+           UvException
+  {
+    try (final TcpServer server = new TcpServer())
+    {
+      assertThrows(IllegalArgumentException.class, () -> server.setListenBacklog(-1));
+      assertThrows(IllegalArgumentException.class, () -> server.setAcceptBatchSize(0));
+      server.setListenBacklog(4);
+      server.setAcceptBatchSize(8);
+      assertEquals(4, server.getListenBacklog());
+      assertEquals(8, server.getAcceptBatchSize());
+      // NOTE: More clients than either the backlog or a batch holds.
+      TcpServerTests.assertServesClients(server, 32);
+      assertThrows(IllegalStateException.class, () -> server.setListenBacklog(8));
+      assertThrows(IllegalStateException.class, () -> server.setAcceptBatchSize(4));
+    }
+  }
+}